@@ -13,10 +13,12 @@ using namespace std;
 
 
 int ReportError::numErrors = 0;
+void (*ReportError::recorder)(yyltype *loc, const string &msg) = NULL;
 
  
 void ReportError::OutputError(yyltype *loc, string msg) {
     numErrors++;
+    if (recorder) recorder(loc, msg);
     fflush(stdout); // make sure any buffered text has been output
     if (loc) {
         cerr << endl << "*** Error line " << loc->first_line << "." << endl;
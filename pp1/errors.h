@@ -58,6 +58,11 @@ class ReportError
 
   // Returns number of error messages printed
   static int NumErrors() { return numErrors; }
+
+  // If set, called with every message as it is printed, so it can be
+  // recorded and printed again later with Recorded (see tokenfile.h)
+  static void (*recorder)(yyltype *loc, const string &msg);
+  static void Recorded(yyltype *loc, const string &msg) { OutputError(loc, msg); }
   
  private:
 
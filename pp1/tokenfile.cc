@@ -0,0 +1,145 @@
+/* File: tokenfile.cc
+ * ------------------
+ * Implementation of the token stream writer and reader.
+ */
+
+#include "tokenfile.h"
+#include <stdlib.h>
+#include <string.h>
+#include "utility.h"
+
+
+static TokenWriter *recording = NULL; // the writer errors go to
+
+
+TokenWriter::TokenWriter(FILE *f) : fp(f)
+{
+    fwrite("DTOK", 1, 4, fp);
+    fwrite(&TokenFileVersion, sizeof(int), 1, fp);
+    recording = this;
+    ReportError::recorder = RecordError;
+}
+
+TokenWriter::~TokenWriter()
+{
+    recording = NULL;
+    ReportError::recorder = NULL;
+}
+
+void TokenWriter::WriteRecord(int code, yyltype *loc, const char *text, int textLen,
+                              const void *value, int valueLen)
+{
+    int header[6] = { code, 0, 0, 0, textLen, valueLen };
+    if (loc) {
+        header[1] = loc->first_line;
+        header[2] = loc->first_column;
+        header[3] = loc->last_column;
+    }
+    fwrite(header, sizeof(int), 6, fp);
+    fwrite(text, 1, textLen, fp);
+    fwrite(value, 1, valueLen, fp);
+}
+
+void TokenWriter::RecordError(yyltype *loc, const string &msg)
+{
+    recording->WriteRecord(loc ? TokenError : TokenErrorNoLine, loc,
+                           msg.data(), msg.size(), NULL, 0);
+}
+
+void TokenWriter::Write(int code, const char *text, YYSTYPE *value, yyltype *loc)
+{
+    const void *v = NULL;
+    int len = 0, b = value->boolConstant; // a bool is written as an int
+    switch (code) {
+      case T_IntConstant:
+        v = &value->integerConstant, len = sizeof(int);
+        break;
+      case T_BoolConstant:
+        v = &b, len = sizeof(int);
+        break;
+      case T_DoubleConstant:
+        v = &value->doubleConstant, len = sizeof(double);
+        break;
+      case T_StringConstant:
+        v = value->stringConstant, len = strlen(value->stringConstant);
+        break;
+      case T_Identifier:
+        v = value->identifier, len = strlen(value->identifier);
+        break;
+    }
+    WriteRecord(code, loc, text, strlen(text), v, len);
+}
+
+void TokenWriter::Finish()
+{
+    WriteRecord(0, NULL, "", 0, NULL, 0);
+    fflush(fp);
+}
+
+
+TokenReader::TokenReader(FILE *f) : fp(f), text(NULL), textMax(0)
+{
+    char magic[4];
+    int version;
+    ReadBytes(magic, 4);
+    ReadBytes(&version, sizeof(int));
+    if (memcmp(magic, "DTOK", 4) != 0 || version != TokenFileVersion)
+        Failure("Not a token stream of version %d", TokenFileVersion);
+}
+
+TokenReader::~TokenReader()
+{
+    free(text);
+}
+
+void TokenReader::ReadBytes(void *dest, int len)
+{
+    if (len > 0 && fread(dest, 1, len, fp) != (size_t)len)
+        Failure("Token stream ends too soon");
+}
+
+int TokenReader::Next(YYSTYPE *value, yyltype *loc, const char **textp)
+{
+    for (;;) {
+        int header[6];
+        ReadBytes(header, 6*sizeof(int));
+        int code = header[0], textLen = header[4], valueLen = header[5];
+        bool isString = (code == T_StringConstant);
+        if (textLen < 0 || valueLen < 0 || (!isString && valueLen > (int)sizeof(YYSTYPE)))
+            Failure("Bad record in token stream");
+        if (textLen + 1 > textMax) {
+            textMax = textLen + 1 + 256;
+            text = (char *)realloc(text, textMax);
+            if (!text) Failure("Out of memory!");
+        }
+        ReadBytes(text, textLen);
+        text[textLen] = '\0';
+
+        memset(loc, 0, sizeof(*loc));
+        loc->first_line = loc->last_line = header[1];
+        loc->first_column = header[2];
+        loc->last_column = header[3];
+        if (code == TokenError || code == TokenErrorNoLine) {
+            ReportError::Recorded(code == TokenError ? loc : NULL, string(text, textLen));
+            continue;
+        }
+
+        if (isString) {
+            value->stringConstant = (char *)malloc(valueLen + 1);
+            ReadBytes(value->stringConstant, valueLen);
+            value->stringConstant[valueLen] = '\0';
+        } else if (code == T_Identifier) {
+            if (valueLen > MaxIdentLen) Failure("Bad record in token stream");
+            ReadBytes(value->identifier, valueLen);
+            value->identifier[valueLen] = '\0';
+        } else if (code == T_BoolConstant) {
+            int b;
+            ReadBytes(&b, sizeof(int));
+            value->boolConstant = b;
+        } else {
+            ReadBytes(value, valueLen);
+        }
+        if (textp) *textp = text;
+        return code;
+    }
+}
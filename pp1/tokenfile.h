@@ -0,0 +1,101 @@
+/* File: tokenfile.h
+ * -----------------
+ * A binary format for the tokens the scanner returns, so the result of
+ * scanning a file can be kept and used again without scanning it. With
+ * -binary on the command line, dcc writes the tokens to stdout in this
+ * format instead of printing them, and with -replay=file it reads them
+ * back from file instead of running the preprocessor and the scanner.
+ * A replayed stream prints exactly what scanning the file printed, so
+ *
+ *     dcc -binary < prog.decaf > prog.tok; dcc -replay=prog.tok
+ *
+ * gives the same output as dcc < prog.decaf. Errors the scanner reports
+ * are kept in the stream too, and reported again when they are reached.
+ * Errors from the preprocessor, which runs as a process of its own, are
+ * not.
+ *
+ * The file is a header, the four characters "DTOK" and a version number,
+ * then one record per token and per error, ending with a record for the
+ * end of the input. All numbers are 32-bit, in the byte order of the
+ * machine that wrote them. A record is:
+ *
+ *     code                 the token code, 0 at the end, TokenError for
+ *                          an error with a location and TokenErrorNoLine
+ *                          for one without
+ *     first_line, first_column, last_column
+ *     textLength           the length of the text of the token (yytext),
+ *                          or of the error message
+ *     valueLength          the length of the value
+ *
+ * followed by the text and then the value, as many bytes as their
+ * lengths say. The value is the int of an int or bool constant, the
+ * double of a double constant, and the characters of a string constant
+ * or (maybe truncated) identifier, without a terminating null. Other
+ * tokens have none.
+ *
+ * Any other tool can read the stream this way. The parser of a later
+ * phase could take its tokens from a TokenReader rather than yylex()
+ * if its token codes are those of scanner.h.
+ */
+
+#ifndef _H_tokenfile
+#define _H_tokenfile
+
+#include <stdio.h>
+#include "scanner.h"
+#include "errors.h"
+
+static const int TokenFileVersion = 1;
+static const int TokenError = -1, TokenErrorNoLine = -2;
+
+
+/* Class: TokenWriter
+ * ------------------
+ * Writes tokens to a stream in the format above. While it exists,
+ * every error reported is written too.
+ */
+class TokenWriter
+{
+  protected:
+    FILE *fp;
+
+    void WriteRecord(int code, yyltype *loc, const char *text, int textLen,
+                     const void *value, int valueLen);
+    static void RecordError(yyltype *loc, const string &msg);
+
+  public:
+    TokenWriter(FILE *fp);
+    ~TokenWriter();
+
+    void Write(int code, const char *text, YYSTYPE *value, yyltype *loc);
+    void Finish(); // writes the end of the input
+};
+
+
+/* Class: TokenReader
+ * ------------------
+ * Reads back what a TokenWriter wrote. Fails if the stream is not in
+ * this format or ends before the record for the end of the input.
+ */
+class TokenReader
+{
+  protected:
+    FILE *fp;
+    char *text;
+    int textMax;
+
+    void ReadBytes(void *dest, int len);
+
+  public:
+    TokenReader(FILE *fp);
+    ~TokenReader();
+
+          // Returns the code of the next token and fills in its value
+          // and location as yylex() would, and the text of the token
+          // (valid until the next call) if text is not NULL. Errors
+          // recorded before it are reported on the way. Returns 0 at
+          // the end of the input.
+    int Next(YYSTYPE *value, yyltype *loc, const char **text = NULL);
+};
+
+#endif
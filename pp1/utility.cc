@@ -12,6 +12,11 @@
 static List<const char*> debugKeys;
 static const int BufferSize = 2048;
 
+struct Option {
+    const char *name, *value;
+};
+static List<Option> options;
+
 void Failure(const char *format, ...)
 {
   va_list args;
@@ -66,17 +71,33 @@ void PrintDebug(const char *key, const char *format, ...)
 }
 
 
+const char *GetOption(const char *name)
+{
+  for (int i = 0; i < options.NumElements(); i++)
+    if (!strcmp(options.Nth(i).name, name)) return options.Nth(i).value;
+  return NULL;
+}
+
+
 void ParseCommandLine(int argc, char *argv[])
 {
-  if (argc == 1)
+  int i = 1;
+  for (; i < argc && argv[i][0] == '-' && strcmp(argv[i], "-d") != 0; i++) {
+    char *name = strdup(argv[i] + 1);
+    char *value = strchr(name, '=');
+    if (value) *value++ = '\0';
+    Option option = { name, value ? value : "" };
+    options.Append(option);
+  }
+  if (i == argc)
     return;
   
-  if (strcmp(argv[1], "-d") != 0) { // first arg is not -d
-    printf("Usage:   -d <debug-key-1> <debug-key-2> ... \n");
+  if (strcmp(argv[i], "-d") != 0) { // not an option and not -d
+    printf("Usage:   [-option[=value] ...] [-d <debug-key-1> <debug-key-2> ...]\n");
     exit(2);
   }
 
-  for (int i = 2; i < argc; i++)
+  for (i++; i < argc; i++)
     SetDebugForKey(argv[i], true);
 }
 
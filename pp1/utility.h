@@ -72,11 +72,22 @@ bool IsDebugOn(const char *key);
 
 
 
+/* Function: GetOption()
+ * Usage: if (GetOption("binary")) ...
+ * -----------------------------------
+ * Returns the value of an option given on the command line as -name or
+ * -name=value, which is "" for the first form.  Returns NULL if the
+ * option was not given.
+ */
+const char *GetOption(const char *name);
+
+
+
 /* Function: ParseCommandLine
  * --------------------------
- * Turn on the debugging flags from the command line.  Verifies that
- * first argument is -d, and then interpret all the arguments that follow
- * as being flags to turn on.
+ * Record the options and turn on the debugging flags from the command
+ * line.  Options come first, then an optional -d, and all the arguments
+ * that follow it are interpreted as being flags to turn on.
  */
 void ParseCommandLine(int argc, char *argv[]);
      
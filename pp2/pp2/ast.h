@@ -21,8 +21,9 @@
  *
  * Printing: The only interesting behavior of the node classes for pp2 is the 
  * bility to print the tree using an in-order walk.  Each node class is 
- * responsible for printing itself/children by overriding the virtual 
- * PrintChildren() and GetPrintNameForNode() methods. All the classes we 
+ * responsible for describing itself/children by overriding the virtual 
+ * GetChildren(), GetPrintValue() and GetPrintNameForNode() methods, and
+ * the walk itself is done by TreeDumper (see dump.h). All the classes we 
  * provide already implement these methods, so your job is to construct the
  * nodes and wire them up during parsing. Once that's done, printing is a snap!
 
@@ -34,6 +35,8 @@
 #include <stdlib.h>   // for NULL
 #include "location.h"
 
+class TreeDumper;
+
 class Node 
 {
   protected:
@@ -50,10 +53,11 @@ class Node
 
     virtual const char *GetPrintNameForNode() = 0;
 
-    // Print() is deliberately _not_ virtual
-    // subclasses should override PrintChildren() instead
-    void Print(int indentLevel, const char *label = NULL); 
-    virtual void PrintChildren(int indentLevel)  {}
+    // The children are named to the dumper with their labels, in the
+    // order they are printed. The value is what follows the print name
+    // (buf has room for 32 characters to format it in), NULL if none.
+    virtual void GetChildren(TreeDumper *d)  {}
+    virtual const char *GetPrintValue(char *buf)  { return NULL; }
 };
 
 
@@ -65,7 +69,7 @@ class Identifier : public Node
   public:
     Identifier(yyltype loc, const char *name);
     const char *GetPrintNameForNode()   { return "Identifier"; }
-    void PrintChildren(int indentLevel);
+    const char *GetPrintValue(char *buf)  { return name; }
 };
 
 
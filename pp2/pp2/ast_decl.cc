@@ -5,6 +5,7 @@
 #include "ast_decl.h"
 #include "ast_type.h"
 #include "ast_stmt.h"
+#include "dump.h"
         
          
 Decl::Decl(Identifier *n) : Node(*n->GetLocation()) {
@@ -18,9 +19,9 @@ VarDecl::VarDecl(Identifier *n, Type *t) : Decl(n) {
     (type=t)->SetParent(this);
 }
   
-void VarDecl::PrintChildren(int indentLevel) { 
-   type->Print(indentLevel+1);
-   id->Print(indentLevel+1);
+void VarDecl::GetChildren(TreeDumper *d) { 
+   d->Add(type);
+   d->Add(id);
 }
 
 ClassDecl::ClassDecl(Identifier *n, NamedType *ex, List<NamedType*> *imp, List<Decl*> *m) : Decl(n) {
@@ -32,11 +33,11 @@ ClassDecl::ClassDecl(Identifier *n, NamedType *ex, List<NamedType*> *imp, List<D
     (members=m)->SetParentAll(this);
 }
 
-void ClassDecl::PrintChildren(int indentLevel) {
-    id->Print(indentLevel+1);
-    if (extends) extends->Print(indentLevel+1, "(extends) ");
-    implements->PrintAll(indentLevel+1, "(implements) ");
-    members->PrintAll(indentLevel+1);
+void ClassDecl::GetChildren(TreeDumper *d) {
+    d->Add(id);
+    d->Add(extends, "extends");
+    d->AddAll(implements, "implements");
+    d->AddAll(members);
 }
 
 
@@ -45,9 +46,9 @@ InterfaceDecl::InterfaceDecl(Identifier *n, List<Decl*> *m) : Decl(n) {
     (members=m)->SetParentAll(this);
 }
 
-void InterfaceDecl::PrintChildren(int indentLevel) {
-    id->Print(indentLevel+1);
-    members->PrintAll(indentLevel+1);
+void InterfaceDecl::GetChildren(TreeDumper *d) {
+    d->Add(id);
+    d->AddAll(members);
 }
 	
 FnDecl::FnDecl(Identifier *n, Type *r, List<VarDecl*> *d) : Decl(n) {
@@ -61,11 +62,11 @@ void FnDecl::SetFunctionBody(Stmt *b) {
     (body=b)->SetParent(this);
 }
 
-void FnDecl::PrintChildren(int indentLevel) {
-    returnType->Print(indentLevel+1, "(return type) ");
-    id->Print(indentLevel+1);
-    formals->PrintAll(indentLevel+1, "(formals) ");
-    if (body) body->Print(indentLevel+1, "(body) ");
+void FnDecl::GetChildren(TreeDumper *d) {
+    d->Add(returnType, "return type");
+    d->Add(id);
+    d->AddAll(formals, "formals");
+    d->Add(body, "body");
 }
 
 
@@ -5,37 +5,41 @@
 #include "ast_expr.h"
 #include "ast_type.h"
 #include "ast_decl.h"
+#include "dump.h"
 #include <string.h>
+#include <stdio.h>
 
 
 
 IntConstant::IntConstant(yyltype loc, int val) : Expr(loc) {
     value = val;
 }
-void IntConstant::PrintChildren(int indentLevel) { 
-    printf("%d", value);
+const char *IntConstant::GetPrintValue(char *buf) { 
+    sprintf(buf, "%d", value);
+    return buf;
 }
 
 DoubleConstant::DoubleConstant(yyltype loc, double val) : Expr(loc) {
     value = val;
 }
-void DoubleConstant::PrintChildren(int indentLevel) { 
-    printf("%g", value);
+const char *DoubleConstant::GetPrintValue(char *buf) { 
+    sprintf(buf, "%g", value);
+    return buf;
 }
 
 BoolConstant::BoolConstant(yyltype loc, bool val) : Expr(loc) {
     value = val;
 }
-void BoolConstant::PrintChildren(int indentLevel) { 
-    printf("%s", value ? "true" : "false");
+const char *BoolConstant::GetPrintValue(char *buf) { 
+    return value ? "true" : "false";
 }
 
 StringConstant::StringConstant(yyltype loc, const char *val) : Expr(loc) {
     Assert(val != NULL);
     value = strdup(val);
 }
-void StringConstant::PrintChildren(int indentLevel) { 
-    printf("%s",value);
+const char *StringConstant::GetPrintValue(char *buf) { 
+    return value;
 }
 
 Operator::Operator(yyltype loc, const char *tok) : Node(loc) {
@@ -43,8 +47,8 @@ Operator::Operator(yyltype loc, const char *tok) : Node(loc) {
     strncpy(tokenString, tok, sizeof(tokenString));
 }
 
-void Operator::PrintChildren(int indentLevel) {
-    printf("%s",tokenString);
+const char *Operator::GetPrintValue(char *buf) {
+    return tokenString;
 }
 
 CompoundExpr::CompoundExpr(Expr *l, Operator *o, Expr *r) 
@@ -63,10 +67,10 @@ CompoundExpr::CompoundExpr(Operator *o, Expr *r)
     (right=r)->SetParent(this);
 }
 
-void CompoundExpr::PrintChildren(int indentLevel) {
-   if (left) left->Print(indentLevel+1);
-   op->Print(indentLevel+1);
-   right->Print(indentLevel+1);
+void CompoundExpr::GetChildren(TreeDumper *d) {
+   d->Add(left);
+   d->Add(op);
+   d->Add(right);
 }
    
   
@@ -75,9 +79,9 @@ ArrayAccess::ArrayAccess(yyltype loc, Expr *b, Expr *s) : LValue(loc) {
     (subscript=s)->SetParent(this);
 }
 
-void ArrayAccess::PrintChildren(int indentLevel) {
-    base->Print(indentLevel+1);
-    subscript->Print(indentLevel+1, "(subscript) ");
+void ArrayAccess::GetChildren(TreeDumper *d) {
+    d->Add(base);
+    d->Add(subscript, "subscript");
   }
      
 FieldAccess::FieldAccess(Expr *b, Identifier *f) 
@@ -89,9 +93,9 @@ FieldAccess::FieldAccess(Expr *b, Identifier *f)
 }
 
 
-  void FieldAccess::PrintChildren(int indentLevel) {
-    if (base) base->Print(indentLevel+1);
-    field->Print(indentLevel+1);
+  void FieldAccess::GetChildren(TreeDumper *d) {
+    d->Add(base);
+    d->Add(field);
   }
 
 Call::Call(yyltype loc, Expr *b, Identifier *f, List<Expr*> *a) : Expr(loc)  {
@@ -102,10 +106,10 @@ Call::Call(yyltype loc, Expr *b, Identifier *f, List<Expr*> *a) : Expr(loc)  {
     (actuals=a)->SetParentAll(this);
 }
 
- void Call::PrintChildren(int indentLevel) {
-    if (base) base->Print(indentLevel+1);
-    field->Print(indentLevel+1);
-    actuals->PrintAll(indentLevel+1, "(actuals) ");
+ void Call::GetChildren(TreeDumper *d) {
+    d->Add(base);
+    d->Add(field);
+    d->AddAll(actuals, "actuals");
   }
  
 
@@ -114,8 +118,8 @@ NewExpr::NewExpr(yyltype loc, NamedType *c) : Expr(loc) {
   (cType=c)->SetParent(this);
 }
 
-void NewExpr::PrintChildren(int indentLevel) {	
-    cType->Print(indentLevel+1);
+void NewExpr::GetChildren(TreeDumper *d) {	
+    d->Add(cType);
 }
 
 NewArrayExpr::NewArrayExpr(yyltype loc, Expr *sz, Type *et) : Expr(loc) {
@@ -124,9 +128,9 @@ NewArrayExpr::NewArrayExpr(yyltype loc, Expr *sz, Type *et) : Expr(loc) {
     (elemType=et)->SetParent(this);
 }
 
-void NewArrayExpr::PrintChildren(int indentLevel) {
-    size->Print(indentLevel+1);
-    elemType->Print(indentLevel+1);
+void NewArrayExpr::GetChildren(TreeDumper *d) {
+    d->Add(size);
+    d->Add(elemType);
 }
 
        
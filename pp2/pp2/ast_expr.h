@@ -42,7 +42,7 @@ class IntConstant : public Expr
   public:
     IntConstant(yyltype loc, int val);
     const char *GetPrintNameForNode() { return "IntConstant"; }
-    void PrintChildren(int indentLevel);
+    const char *GetPrintValue(char *buf);
 };
 
 class DoubleConstant : public Expr 
@@ -53,7 +53,7 @@ class DoubleConstant : public Expr
   public:
     DoubleConstant(yyltype loc, double val);
     const char *GetPrintNameForNode() { return "DoubleConstant"; }
-    void PrintChildren(int indentLevel);
+    const char *GetPrintValue(char *buf);
 };
 
 class BoolConstant : public Expr 
@@ -64,7 +64,7 @@ class BoolConstant : public Expr
   public:
     BoolConstant(yyltype loc, bool val);
     const char *GetPrintNameForNode() { return "BoolConstant"; }
-    void PrintChildren(int indentLevel);
+    const char *GetPrintValue(char *buf);
 };
 
 class StringConstant : public Expr 
@@ -75,7 +75,7 @@ class StringConstant : public Expr
   public:
     StringConstant(yyltype loc, const char *val);
     const char *GetPrintNameForNode() { return "StringConstant"; }
-    void PrintChildren(int indentLevel);
+    const char *GetPrintValue(char *buf);
 };
 
 class NullConstant: public Expr 
@@ -93,7 +93,7 @@ class Operator : public Node
   public:
     Operator(yyltype loc, const char *tok);
     const char *GetPrintNameForNode() { return "Operator"; }
-    void PrintChildren(int indentLevel);
+    const char *GetPrintValue(char *buf);
  };
  
 class CompoundExpr : public Expr
@@ -105,7 +105,7 @@ class CompoundExpr : public Expr
   public:
     CompoundExpr(Expr *lhs, Operator *op, Expr *rhs); // for binary
     CompoundExpr(Operator *op, Expr *rhs);             // for unary
-    void PrintChildren(int indentLevel);
+    void GetChildren(TreeDumper *d);
 };
 
 class ArithmeticExpr : public CompoundExpr 
@@ -166,7 +166,7 @@ class ArrayAccess : public LValue
   public:
     ArrayAccess(yyltype loc, Expr *base, Expr *subscript);
     const char *GetPrintNameForNode() { return "ArrayAccess"; }
-    void PrintChildren(int indentLevel);
+    void GetChildren(TreeDumper *d);
 };
 
 /* Note that field access is used both for qualified names
@@ -183,7 +183,7 @@ class FieldAccess : public LValue
   public:
     FieldAccess(Expr *base, Identifier *field); //ok to pass NULL base
     const char *GetPrintNameForNode() { return "FieldAccess"; }
-    void PrintChildren(int indentLevel);
+    void GetChildren(TreeDumper *d);
 };
 
 /* Like field access, call is used both for qualified base.field()
@@ -200,7 +200,7 @@ class Call : public Expr
   public:
     Call(yyltype loc, Expr *base, Identifier *field, List<Expr*> *args);
     const char *GetPrintNameForNode() { return "Call"; }
-    void PrintChildren(int indentLevel);
+    void GetChildren(TreeDumper *d);
 };
 
 class NewExpr : public Expr
@@ -211,7 +211,7 @@ class NewExpr : public Expr
   public:
     NewExpr(yyltype loc, NamedType *clsType);
     const char *GetPrintNameForNode() { return "NewExpr"; }
-    void PrintChildren(int indentLevel);
+    void GetChildren(TreeDumper *d);
 };
 
 class NewArrayExpr : public Expr
@@ -223,7 +223,7 @@ class NewArrayExpr : public Expr
   public:
     NewArrayExpr(yyltype loc, Expr *sizeExpr, Type *elemType);
     const char *GetPrintNameForNode() { return "NewArrayExpr"; }
-    void PrintChildren(int indentLevel);
+    void GetChildren(TreeDumper *d);
 };
 
 class ReadIntegerExpr : public Expr
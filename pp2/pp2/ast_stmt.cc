@@ -6,6 +6,7 @@
 #include "ast_type.h"
 #include "ast_decl.h"
 #include "ast_expr.h"
+#include "dump.h"
 
 
 Program::Program(List<Decl*> *d) {
@@ -13,9 +14,8 @@ Program::Program(List<Decl*> *d) {
     (decls=d)->SetParentAll(this);
 }
 
-void Program::PrintChildren(int indentLevel) {
-    decls->PrintAll(indentLevel+1);
-    printf("\n");
+void Program::GetChildren(TreeDumper *d) {
+    d->AddAll(decls);
 }
 
 StmtBlock::StmtBlock(List<VarDecl*> *d, List<Stmt*> *s) {
@@ -24,9 +24,9 @@ StmtBlock::StmtBlock(List<VarDecl*> *d, List<Stmt*> *s) {
     (stmts=s)->SetParentAll(this);
 }
 
-void StmtBlock::PrintChildren(int indentLevel) {
-    decls->PrintAll(indentLevel+1);
-    stmts->PrintAll(indentLevel+1);
+void StmtBlock::GetChildren(TreeDumper *d) {
+    d->AddAll(decls);
+    d->AddAll(stmts);
 }
 
 ConditionalStmt::ConditionalStmt(Expr *t, Stmt *b) { 
@@ -41,16 +41,16 @@ ForStmt::ForStmt(Expr *i, Expr *t, Expr *s, Stmt *b): LoopStmt(t, b) {
     (step=s)->SetParent(this);
 }
 
-void ForStmt::PrintChildren(int indentLevel) {
-    init->Print(indentLevel+1, "(init) ");
-    test->Print(indentLevel+1, "(test) ");
-    step->Print(indentLevel+1, "(step) ");
-    body->Print(indentLevel+1, "(body) ");
+void ForStmt::GetChildren(TreeDumper *d) {
+    d->Add(init, "init");
+    d->Add(test, "test");
+    d->Add(step, "step");
+    d->Add(body, "body");
 }
 
-void WhileStmt::PrintChildren(int indentLevel) {
-    test->Print(indentLevel+1, "(test) ");
-    body->Print(indentLevel+1, "(body) ");
+void WhileStmt::GetChildren(TreeDumper *d) {
+    d->Add(test, "test");
+    d->Add(body, "body");
 }
 
 IfStmt::IfStmt(Expr *t, Stmt *tb, Stmt *eb): ConditionalStmt(t, tb) { 
@@ -59,10 +59,10 @@ IfStmt::IfStmt(Expr *t, Stmt *tb, Stmt *eb): ConditionalStmt(t, tb) {
     if (elseBody) elseBody->SetParent(this);
 }
 
-void IfStmt::PrintChildren(int indentLevel) {
-    test->Print(indentLevel+1, "(test) ");
-    body->Print(indentLevel+1, "(then) ");
-    if (elseBody) elseBody->Print(indentLevel+1, "(else) ");
+void IfStmt::GetChildren(TreeDumper *d) {
+    d->Add(test, "test");
+    d->Add(body, "then");
+    d->Add(elseBody, "else");
 }
 
 
@@ -71,8 +71,8 @@ ReturnStmt::ReturnStmt(yyltype loc, Expr *e) : Stmt(loc) {
     (expr=e)->SetParent(this);
 }
 
-void ReturnStmt::PrintChildren(int indentLevel) {
-    expr->Print(indentLevel+1);
+void ReturnStmt::GetChildren(TreeDumper *d) {
+    d->Add(expr);
 }
   
 PrintStmt::PrintStmt(List<Expr*> *a) {    
@@ -80,8 +80,8 @@ PrintStmt::PrintStmt(List<Expr*> *a) {
     (args=a)->SetParentAll(this);
 }
 
-void PrintStmt::PrintChildren(int indentLevel) {
-    args->PrintAll(indentLevel+1, "(args) ");
+void PrintStmt::GetChildren(TreeDumper *d) {
+    d->AddAll(args, "args");
 }
 
 
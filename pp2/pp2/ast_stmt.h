@@ -28,7 +28,7 @@ class Program : public Node
   public:
      Program(List<Decl*> *declList);
      const char *GetPrintNameForNode() { return "Program"; }
-     void PrintChildren(int indentLevel);
+     void GetChildren(TreeDumper *d);
 };
 
 class Stmt : public Node
@@ -47,7 +47,7 @@ class StmtBlock : public Stmt
   public:
     StmtBlock(List<VarDecl*> *variableDeclarations, List<Stmt*> *statements);
     const char *GetPrintNameForNode() { return "StmtBlock"; }
-    void PrintChildren(int indentLevel);
+    void GetChildren(TreeDumper *d);
 };
 
 
@@ -76,7 +76,7 @@ class ForStmt : public LoopStmt
   public:
     ForStmt(Expr *init, Expr *test, Expr *step, Stmt *body);
     const char *GetPrintNameForNode() { return "ForStmt"; }
-    void PrintChildren(int indentLevel);
+    void GetChildren(TreeDumper *d);
 };
 
 class WhileStmt : public LoopStmt 
@@ -84,7 +84,7 @@ class WhileStmt : public LoopStmt
   public:
     WhileStmt(Expr *test, Stmt *body) : LoopStmt(test, body) {}
     const char *GetPrintNameForNode() { return "WhileStmt"; }
-    void PrintChildren(int indentLevel);
+    void GetChildren(TreeDumper *d);
 };
 
 class IfStmt : public ConditionalStmt 
@@ -95,7 +95,7 @@ class IfStmt : public ConditionalStmt
   public:
     IfStmt(Expr *test, Stmt *thenBody, Stmt *elseBody);
     const char *GetPrintNameForNode() { return "IfStmt"; }
-    void PrintChildren(int indentLevel);
+    void GetChildren(TreeDumper *d);
 };
 
 class BreakStmt : public Stmt
@@ -113,7 +113,7 @@ class ReturnStmt : public Stmt
  public:
     ReturnStmt(yyltype loc, Expr *expr);
     const char *GetPrintNameForNode() { return "ReturnStmt"; }
-    void PrintChildren(int indentLevel);
+    void GetChildren(TreeDumper *d);
 };
 
 class PrintStmt : public Stmt
@@ -124,7 +124,7 @@ class PrintStmt : public Stmt
   public:
     PrintStmt(List<Expr*> *arguments);
     const char *GetPrintNameForNode() { return "PrintStmt"; }
-    void PrintChildren(int indentLevel);
+    void GetChildren(TreeDumper *d);
 };
 
 
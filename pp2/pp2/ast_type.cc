@@ -4,6 +4,7 @@
  */
 #include "ast_type.h"
 #include "ast_decl.h"
+#include "dump.h"
 #include <string.h>
 
  
@@ -28,26 +29,22 @@ Type::Type(const char *n) {
     typeName = strdup(n);
 }
 
-void Type::PrintChildren(int indentLevel) {
-    printf("%s", typeName);
-}
-
 	
 NamedType::NamedType(Identifier *i) : Type(*i->GetLocation()) {
     Assert(i != NULL);
     (id=i)->SetParent(this);
 } 
 
-void NamedType::PrintChildren(int indentLevel) {
-    id->Print(indentLevel+1);
+void NamedType::GetChildren(TreeDumper *d) {
+    d->Add(id);
 }
 
 ArrayType::ArrayType(yyltype loc, Type *et) : Type(loc) {
     Assert(et != NULL);
     (elemType=et)->SetParent(this);
 }
-void ArrayType::PrintChildren(int indentLevel) {
-    elemType->Print(indentLevel+1);
+void ArrayType::GetChildren(TreeDumper *d) {
+    d->Add(elemType);
 }
 
 
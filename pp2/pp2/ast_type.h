@@ -22,11 +22,11 @@ class Type : public Node
     static Type *intType, *doubleType, *boolType, *voidType,
                 *nullType, *stringType, *errorType;
 
-    Type(yyltype loc) : Node(loc) {}
+    Type(yyltype loc) : Node(loc) { typeName = NULL; }
     Type(const char *str);
     
     const char *GetPrintNameForNode() { return "Type"; }
-    void PrintChildren(int indentLevel);
+    const char *GetPrintValue(char *buf) { return typeName; }
 };
 
 class NamedType : public Type 
@@ -38,7 +38,7 @@ class NamedType : public Type
     NamedType(Identifier *i);
     
     const char *GetPrintNameForNode() { return "NamedType"; }
-    void PrintChildren(int indentLevel);
+    void GetChildren(TreeDumper *d);
 };
 
 class ArrayType : public Type 
@@ -50,7 +50,7 @@ class ArrayType : public Type
     ArrayType(yyltype loc, Type *elemType);
     
     const char *GetPrintNameForNode() { return "ArrayType"; }
-    void PrintChildren(int indentLevel);
+    void GetChildren(TreeDumper *d);
 };
 
  
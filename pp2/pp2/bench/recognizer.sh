@@ -0,0 +1,34 @@
+#!/bin/sh
+# File: bench/recognizer.sh
+# -------------------------
+# The recognizer against the full parser: makes a large program out of
+# the samples that parse, copied n times (300 by default, about 1.3 MB),
+# and times dcc, which builds the tree and prints it, and the recognizer
+# (see recognizer.awk), which only accepts the input, best of 5 runs
+# each. Both must accept it. Usage: bench/recognizer.sh [n]
+
+n=${1:-300}
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+samples=$(ls samples/*.out | grep -v '/bad' | sed 's/\.out$/.decaf/')
+for i in $(seq $n); do
+    cat $samples
+done > "$work/input.decaf"
+
+best() {    # best of 5 runs of the program given, in ms
+    min=
+    for run in 1 2 3 4 5; do
+        start=$(date +%s%N)
+        "$1" < "$work/input.decaf" > "$work/out" 2>&1 || { echo "$1 rejects the input" >&2; exit 1; }
+        ns=$(( $(date +%s%N) - start ))
+        [ -z "$min" ] || [ $ns -lt $min ] && min=$ns
+    done
+    echo $((min / 1000000))
+}
+
+echo "$(wc -c < "$work/input.decaf") bytes of input"
+dcc=$(best ./dcc) || exit 1
+echo "dcc:         $dcc ms, $(wc -c < "$work/out") bytes of tree printed"
+recognizer=$(best ./recognizer) || exit 1
+echo "recognizer:  $recognizer ms"
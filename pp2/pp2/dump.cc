@@ -0,0 +1,193 @@
+/* File: dump.cc
+ * -------------
+ * Implementation of the tree dump.
+ */
+
+#include "dump.h"
+#include <stdlib.h>
+#include <string.h>
+#include "ast.h"
+#include "utility.h"
+
+
+DumpSink::DumpSink(FILE *f) : fp(f), used(0), escaping(false)
+{
+    buffer = new char[BufferSize];
+}
+
+DumpSink::~DumpSink()
+{
+    Flush();
+    delete[] buffer;
+}
+
+void DumpSink::Flush()
+{
+    if (used > 0) fwrite(buffer, 1, used, fp);
+    used = 0;
+    fflush(fp);
+}
+
+void DumpSink::Put(const char *s, int len)
+{
+    if (used + len > BufferSize) {
+        Flush();
+        if (len > BufferSize) {
+            fwrite(s, 1, len, fp);
+            return;
+        }
+    }
+    memcpy(buffer + used, s, len);
+    used += len;
+}
+
+void DumpSink::Write(const char *s, int len)
+{
+    if (!escaping) {
+        Put(s, len);
+        return;
+    }
+    for (int i = 0; i < len; i++) {
+        unsigned char c = s[i];
+        char esc[8];
+        if (c == '"' || c == '\\') {
+            esc[0] = '\\', esc[1] = c;
+            Put(esc, 2);
+        } else if (c < ' ') {
+            Put(esc, sprintf(esc, "\\u%04x", c));
+        } else {
+            Put(s + i, 1);
+        }
+    }
+}
+
+void DumpSink::Write(const char *s)
+{
+    Write(s, strlen(s));
+}
+
+void DumpSink::WriteInt(int n, int width)
+{
+    char digits[16];
+    int len = 0;
+    unsigned int u = (n < 0 ? -(unsigned int)n : n);
+    do {
+        digits[sizeof(digits) - ++len] = '0' + u % 10;
+        u /= 10;
+    } while (u > 0);
+    if (n < 0) digits[sizeof(digits) - ++len] = '-';
+    for (; width > len; width--) Put(" ", 1);
+    Put(digits + sizeof(digits) - len, len);
+}
+
+
+void TreeDumper::Entries::Append(Node *node, int depth, const char *label)
+{
+    if (num == max) {
+        max = (max ? 2*max : 256);
+        elems = (Entry *)realloc(elems, max*sizeof(Entry));
+        if (!elems) Failure("Out of memory!");
+    }
+    Entry e = { node, depth, label };
+    elems[num++] = e;
+}
+
+TreeDumper::TreeDumper(DumpSink *s, bool j) : sink(s), json(j)
+{
+    stack.elems = children.elems = NULL;
+    stack.num = stack.max = children.num = children.max = 0;
+}
+
+TreeDumper::~TreeDumper()
+{
+    free(stack.elems);
+    free(children.elems);
+}
+
+void TreeDumper::Add(Node *child, const char *label)
+{
+    if (child) children.Append(child, 0, label);
+}
+
+/* Method: Dump
+ * ------------
+ * Writes a node, then puts its children on the stack in reverse so the
+ * first comes off next, at one more level of depth.
+ */
+void TreeDumper::Dump(Node *root, int depth)
+{
+    stack.Append(root, depth, NULL);
+    while (stack.num > 0) {
+        Entry e = stack.elems[--stack.num];
+        if (json)
+            WriteJson(&e);
+        else
+            WriteText(&e);
+        children.num = 0;
+        e.node->GetChildren(this);
+        for (int i = children.num - 1; i >= 0; i--)
+            stack.Append(children.elems[i].node, e.depth + 1, children.elems[i].label);
+    }
+}
+
+/* The line number, if any, in a column of three and then the name
+ * indented three spaces per level. */
+void TreeDumper::WriteText(Entry *e)
+{
+    const int numSpaces = 3;
+    static const char spaces[] = "                                                ";
+    yyltype *loc = e->node->GetLocation();
+    sink->Write("\n", 1);
+    if (loc)
+        sink->WriteInt(loc->first_line, numSpaces);
+    else
+        sink->Write(spaces, numSpaces);
+    for (int n = e->depth*numSpaces; n > 0; n -= sizeof(spaces) - 1)
+        sink->Write(spaces, n < (int)sizeof(spaces) - 1 ? n : sizeof(spaces) - 1);
+    if (e->label) {
+        sink->Write("(", 1);
+        sink->Write(e->label);
+        sink->Write(") ", 2);
+    }
+    sink->Write(e->node->GetPrintNameForNode());
+    sink->Write(": ", 2);
+    const char *value = e->node->GetPrintValue(valueBuffer);
+    if (value) sink->Write(value);
+}
+
+void TreeDumper::WriteJson(Entry *e)
+{
+    sink->Write("{\"depth\":", 9);
+    sink->WriteInt(e->depth);
+    sink->Write(",\"node\":\"", 9);
+    sink->Write(e->node->GetPrintNameForNode());
+    sink->Write("\"", 1);
+    yyltype *loc = e->node->GetLocation();
+    if (loc) {
+        sink->Write(",\"line\":", 8);
+        sink->WriteInt(loc->first_line);
+    }
+    if (e->label) {
+        sink->Write(",\"label\":\"", 10);
+        sink->Write(e->label);
+        sink->Write("\"", 1);
+    }
+    const char *value = e->node->GetPrintValue(valueBuffer);
+    if (value) {
+        sink->Write(",\"value\":\"", 10);
+        sink->SetEscaping(true);
+        sink->Write(value);
+        sink->SetEscaping(false);
+        sink->Write("\"", 1);
+    }
+    sink->Write("}\n", 2);
+}
+
+
+void DumpTree(Node *root)
+{
+    DumpSink sink(stdout);
+    bool json = (GetOption("json") != NULL);
+    TreeDumper(&sink, json).Dump(root);
+    if (!json) sink.Write("\n", 1); // Program printed one after its children
+}
@@ -0,0 +1,114 @@
+/* File: dump.h
+ * ------------
+ * Writing out the parse tree. The tree is walked with an explicit stack
+ * rather than by recursion, so deeply nested expressions cannot overflow
+ * the C stack, and everything goes through one large buffer rather than
+ * a printf per line. Each node class says what to write through two
+ * virtual methods of Node: GetChildren() names its children and their
+ * labels, in order, and GetPrintValue() gives what follows its print
+ * name on its own line (a name, a constant, an operator), if anything.
+ *
+ * Two formats are written. The text format is the indented one pp2
+ * prints:
+ *
+ *     4   FnDecl:
+ *            (return type) Type: int
+ *     4      Identifier: tester
+ *
+ * and the other, with -json on the command line, is one JSON object per
+ * line and per node, in the same order, for other tools to read:
+ *
+ *   {"depth":1,"node":"FnDecl","line":4}
+ *   {"depth":2,"node":"Type","label":"return type","value":"int"}
+ *
+ * where line is left out for nodes without a location and label and
+ * value for nodes without them.
+ */
+
+#ifndef _H_dump
+#define _H_dump
+
+#include <stdio.h>
+#include "list.h"
+
+class Node;
+
+
+/* Class: DumpSink
+ * ---------------
+ * Output buffered in large blocks. While escaping, what is written goes
+ * out as the inside of a JSON string.
+ */
+class DumpSink
+{
+  protected:
+    static const int BufferSize = 64*1024;
+    FILE *fp;
+    char *buffer;
+    int used;
+    bool escaping;
+
+    void Put(const char *s, int len);
+
+  public:
+    DumpSink(FILE *fp);
+    ~DumpSink(); // flushes
+
+    void Write(const char *s, int len);
+    void Write(const char *s);
+    void WriteInt(int n, int width = 0); // right-aligned in width
+    void SetEscaping(bool on) { escaping = on; }
+    void Flush();
+};
+
+
+/* Class: TreeDumper
+ * -----------------
+ * Walks a tree in the order Print did and writes each node to a sink.
+ * GetChildren() calls Add and AddAll to name the children of a node.
+ */
+class TreeDumper
+{
+  protected:
+    struct Entry {
+        Node *node;
+        int depth;
+        const char *label;
+    };
+    struct Entries {            // grown as needed, never shrunk
+        Entry *elems;
+        int num, max;
+        void Append(Node *node, int depth, const char *label);
+    };
+    Entries stack, children;
+    DumpSink *sink;
+    bool json;
+    char valueBuffer[32];
+
+    void WriteText(Entry *e);
+    void WriteJson(Entry *e);
+
+  public:
+    TreeDumper(DumpSink *sink, bool json);
+    ~TreeDumper();
+
+    void Dump(Node *root, int depth = 0);
+
+          // Children of the node being written, in order. NULL nodes
+          // are skipped, a label is a word like "body" or NULL.
+    void Add(Node *child, const char *label = NULL);
+    template <class Element> void AddAll(List<Element> *list, const char *label = NULL) {
+        for (int i = 0; i < list->NumElements(); i++)
+            Add(list->Nth(i), label);
+    }
+};
+
+
+/* Function: DumpTree()
+ * --------------------
+ * Writes the tree under root to stdout, in the format the command line
+ * asks for.
+ */
+void DumpTree(Node *root);
+
+#endif
@@ -21,6 +21,7 @@
 #include "scanner.h" // for yylex
 #include "parser.h"
 #include "errors.h"
+#include "dump.h"
 
 void yyerror(char *msg); // standard error-handling routine
 
@@ -157,7 +158,7 @@ Program   :    DeclList             {
                         Program *program = new Program($1);
                         // if no errors, advance to next phase
                         if (ReportError::NumErrors() == 0)
-                            program->Print(0);
+                            DumpTree(program);
                                      }
           ;
 
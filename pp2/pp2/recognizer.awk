@@ -0,0 +1,41 @@
+# File: recognizer.awk
+# --------------------
+# Turns parser.y into recognizer.y, the same grammar with its actions
+# taken out. The rules are left as they are, but every { } block in
+# them is dropped (braces in quoted tokens like '{' do not count) and so
+# are the %type declarations, so no $$ has a type to clash with the
+# default action. The %union and the token types stay, the scanner still
+# fills in yylval and yylloc (%locations is added, no @n is left to ask
+# for it). The code before the rules and after them is copied as is.
+
+BEGIN { section = 0; depth = 0 }
+
+/^%%/ {
+    if (section++ == 0) print "%locations\n"
+    print
+    next
+}
+
+section == 0 && /^%type/ { next }
+
+section != 1 { print; next }
+
+{
+    out = ""
+    n = length($0)
+    for (i = 1; i <= n; i++) {
+        c = substr($0, i, 1)
+        if (depth == 0 && c == "'") {           # a quoted token like '{'
+            j = index(substr($0, i + 1), "'")
+            out = out substr($0, i, j + 1)
+            i += j
+        } else if (c == "{") {
+            depth++
+        } else if (c == "}") {
+            depth--
+        } else if (depth == 0) {
+            out = out c
+        }
+    }
+    print out
+}
@@ -0,0 +1,98 @@
+/* File: arena.cc
+ * --------------
+ * Implementation of the region allocator.
+ */
+
+#include "arena.h"
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+#include "utility.h" // for Failure()
+
+
+Arena::Arena(size_t size)
+{
+    chunks = NULL;
+    next = limit = NULL;
+    chunkSize = size;
+}
+
+
+Arena::~Arena()
+{
+    while (chunks) {
+        Chunk *prev = chunks->prev;
+        free(chunks);
+        chunks = prev;
+    }
+}
+
+
+/* Method: AllocInNewChunk
+ * -----------------------
+ * Slow path of Alloc(): starts a new chunk, big enough for the request
+ * even with the worst case alignment padding.
+ */
+void *Arena::AllocInNewChunk(size_t size, size_t align)
+{
+    size_t needed = size + align;
+    size_t usable = (needed > chunkSize ? needed : chunkSize);
+    Chunk *chunk = (Chunk *)malloc(sizeof(Chunk) + usable);
+    if (!chunk) Failure("Out of memory!");
+
+    chunk->prev = chunks;
+    chunk->size = usable;
+    chunks = chunk;
+    next = (char *)(chunk + 1);
+    limit = next + usable;
+    return Alloc(size, align);
+}
+
+
+char *Arena::CopyString(const char *text, int len)
+{
+    char *copy = (char *)Alloc(len + 1, 1);
+    memcpy(copy, text, len);
+    copy[len] = '\0';
+    return copy;
+}
+
+
+bool Arena::Owns(const void *p)
+{
+    for (Chunk *chunk = chunks; chunk; chunk = chunk->prev) {
+        const char *start = (const char *)(chunk + 1);
+        if (p >= start && p < start + chunk->size) return true;
+    }
+    return false;
+}
+
+
+void Arena::Reset()
+{
+    if (!chunks) return;
+    while (chunks->prev) {
+        Chunk *prev = chunks->prev;
+        free(chunks);
+        chunks = prev;
+    }
+    next = (char *)(chunks + 1);
+    limit = next + chunks->size;
+}
+
+
+thread_local Arena *ArenaAllocated::arenaInUse = NULL;
+
+
+void *ArenaAllocated::Allocate(size_t size)
+{
+    if (arenaInUse) return arenaInUse->Alloc(size ? size : 1, 2*sizeof(void*));
+    return ::operator new(size);
+}
+
+
+void ArenaAllocated::Free(void *p)
+{
+    if (arenaInUse && arenaInUse->Owns(p)) return;
+    ::operator delete(p);
+}
@@ -0,0 +1,114 @@
+/* File: arena.h
+ * -------------
+ * A region allocator. Memory is carved out of large chunks by bumping
+ * a pointer and is never freed piecemeal, only all at once by Reset()
+ * or when the arena is destroyed. This suits data that lives as long
+ * as the compilation does (or as long as some phase of it) and saves
+ * the per-object overhead of malloc.
+ */
+
+#ifndef _H_arena
+#define _H_arena
+
+#include <stddef.h>
+
+
+class Arena
+{
+  protected:
+    struct Chunk {
+        Chunk *prev;            // the chunk filled before this one
+        size_t size;            // bytes usable after the header
+    };
+    Chunk *chunks;              // most recent chunk, the one being filled
+    char *next, *limit;         // free part of the current chunk
+    size_t chunkSize;
+
+    void *AllocInNewChunk(size_t size, size_t align);
+
+  public:
+          // Creates an empty arena that grabs chunkSize bytes at a time
+          // (more for single requests that do not fit in a chunk)
+    Arena(size_t chunkSize = 64*1024);
+    ~Arena();
+
+          // Returns size bytes aligned to align, which must be a power of 2
+    void *Alloc(size_t size, size_t align = sizeof(void*)) {
+        char *p = (char *)(((size_t)next + align - 1) & ~(align - 1));
+        if (p + size > limit) return AllocInNewChunk(size, align);
+        next = p + size;
+        return p;
+    }
+
+          // Returns a null-terminated copy of the len chars at text
+    char *CopyString(const char *text, int len);
+
+          // Returns true if p points into one of the chunks
+    bool Owns(const void *p);
+
+          // Frees everything allocated so far. The first chunk is kept
+          // for reuse, the others are given back.
+    void Reset();
+};
+
+
+/* Class: ArenaAllocated
+ * ---------------------
+ * Base for the classes that parse trees are made of (Node, Scope, List
+ * and Hashtable, see UseArena below). Their objects are normally
+ * allocated with the global operator new, but while a thread has an
+ * arena in use they are carved out of it instead, and deleting one
+ * that came from it does nothing. Nothing else is affected.
+ */
+class ArenaAllocated
+{
+  protected:
+    static thread_local Arena *arenaInUse;
+    friend class UseArena;
+
+  public:
+    static void *Allocate(size_t size);
+    static void Free(void *p);
+
+    static void *operator new(size_t size) { return Allocate(size); }
+    static void operator delete(void *p) { Free(p); }
+};
+
+
+/* Class: UseArena
+ * ---------------
+ * Makes the ArenaAllocated classes take their memory from arena on this
+ * thread for as long as the UseArena object exists. Used by -stream for
+ * the trees of the second pass (see stream.h), which are dropped all at
+ * once by resetting the arena. None of their destructors matter.
+ */
+class UseArena
+{
+    Arena *saved;
+
+  public:
+    UseArena(Arena *arena) : saved(ArenaAllocated::arenaInUse) { ArenaAllocated::arenaInUse = arena; }
+    ~UseArena() { ArenaAllocated::arenaInUse = saved; }
+};
+
+
+/* Class: ArenaAllocator
+ * ---------------------
+ * The allocator for the STL containers inside ArenaAllocated classes,
+ * which takes memory from the same place they do.
+ */
+template<class T> struct ArenaAllocator
+{
+    typedef T value_type;
+
+    ArenaAllocator() {}
+    template<class U> ArenaAllocator(const ArenaAllocator<U> &) {}
+
+    T *allocate(size_t n) { return (T *)ArenaAllocated::Allocate(n * sizeof(T)); }
+    void deallocate(T *p, size_t) { ArenaAllocated::Free(p); }
+
+    template<class U> bool operator==(const ArenaAllocator<U> &) const { return true; }
+    template<class U> bool operator!=(const ArenaAllocator<U> &) const { return false; }
+};
+
+#endif
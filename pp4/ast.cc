@@ -5,12 +5,13 @@
 #include "ast.h"
 #include "ast_type.h"
 #include "ast_decl.h"
+#include "astcache.h"
 #include <string.h> // strdup
 #include <stdio.h>  // printf
 
 
 Node::Node(yyltype loc) {
-    location = new yyltype(loc);
+    location = new (Allocate(sizeof(yyltype))) yyltype(loc); // where the node is
     parent = NULL;
 }
 
@@ -21,11 +22,29 @@ Node::Node() {
 }
 
 
+Identifier::Identifier(yyltype loc, const PooledString *n) : Node(loc) {
+    name = n->chars;
+}
+
+
 Identifier::Identifier(yyltype loc, const char *n) : Node(loc) {
-    name = strdup(n);
+    name = identifierNames.Intern(n, strlen(n))->chars;
 }
 
 
+/* Names are interned, so equal names are the same string. */
 bool Identifier::operator==(const Identifier &rhs) {
-    return strcmp(name, rhs.name) == 0 ? true : false;
+    return name == rhs.name;
+}
+
+
+/* Only the nodes the parser makes can be saved. */
+int Node::Save(AstWriter *w) {
+    Failure("Cannot save this node to the AST cache");
+    return 0;
+}
+
+
+int Identifier::Save(AstWriter *w) {
+    return w->Add(AstWriter::IdentifierNode, location, w->Name(name));
 }
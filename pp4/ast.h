@@ -32,10 +32,16 @@
 
 #include <stdlib.h>   // for NULL
 #include "location.h"
+#include "strpool.h"
+#include "arena.h"
 #include <iostream>
 
+class AstWriter;
+class Scope;
+class TreeWalk;
 
-class Node
+
+class Node : public ArenaAllocated
 {
   protected:
     yyltype *location;
@@ -49,6 +55,15 @@ class Node
     yyltype *GetLocation()   { return location; }
     void SetParent(Node *p)  { parent = p; }
     Node *GetParent()        { return parent; }
+
+          // Adds the node and its children to the AST cache (see
+          // astcache.h) and returns its record number
+    virtual int Save(AstWriter *w);
+
+          // The node's part of building scopes and of checking, for the
+          // walks in walk.h, which visit the children they name
+    virtual void ScopeBuilder(Scope *parent, TreeWalk *w) {}
+    virtual bool CheckStep(int step, TreeWalk *w) { return false; }
 };
 
 
@@ -56,13 +71,15 @@ class Node
 class Identifier : public Node
 {
   protected:
-    char *name;
+    const char *name;           // interned in identifierNames
 
   public:
+    Identifier(yyltype loc, const PooledString *name);
     Identifier(yyltype loc, const char *name);
     friend std::ostream& operator<<(std::ostream& out, Identifier *id) { return out << id->name; }
     bool operator==(const Identifier &rhs);
     const char* Name() { return name; }
+    int Save(AstWriter *w);
 };
 
 
@@ -5,6 +5,8 @@
 #include "ast_decl.h"
 #include "ast_type.h"
 #include "ast_stmt.h"
+#include "astcache.h"
+#include "walk.h"
 
 
 Decl::Decl(Identifier *n) : Node(*n->GetLocation()), scope(new Scope) {
@@ -18,7 +20,7 @@ bool Decl::Equivalent(Decl *other) {
 }
 
 
-void Decl::ScopeBuilder(Scope *parent) {
+void Decl::ScopeBuilder(Scope *parent, TreeWalk *w) {
     scope->SetParent(parent);
 }
 
@@ -38,12 +40,23 @@ bool VarDecl::Equivalent(Decl *other) {
 }
 
 
-void VarDecl::Check() {
+void VarDecl::ScopeBuilder(Scope *parent, TreeWalk *w) {
+    scope->SetParent(parent);
+    ResolveType();
+}
+
+
+bool VarDecl::CheckStep(int step, TreeWalk *w) {
     CheckType();
+    return false;
 }
 
 
-void VarDecl::CheckType() {
+/* The scopes around the declaration are all complete by the time its
+ * own is built, so whether its type is declared is settled here rather
+ * than while checking, when other declarations may read it at the same
+ * time (see Program::CheckInParallel). */
+void VarDecl::ResolveType() {
     if (type->IsPrimitive())
         return;
 
@@ -52,20 +65,23 @@ void VarDecl::CheckType() {
         Decl *d;
         if ((d = s->table->Lookup(type->Name())) != NULL) {
             if (dynamic_cast<ClassDecl*>(d) == NULL &&
-                dynamic_cast<InterfaceDecl*>(d) == NULL) {
-                type->ReportNotDeclaredID(LookingForType);
+                dynamic_cast<InterfaceDecl*>(d) == NULL)
                 type->typeDeclared = false;
-            }
 
             return;
         }
         s = s->GetParent();
     }
 
-    type->ReportNotDeclaredID(LookingForType);
     type->typeDeclared = false;
 }
 
+
+void VarDecl::CheckType() {
+    if (!type->typeDeclared)
+        type->ReportNotDeclaredID(LookingForType);
+}
+
 ClassDecl::ClassDecl(Identifier *n, NamedType *ex, List<NamedType*> *imp, List<Decl*> *m) : Decl(n) {
     // extends can be NULL, impl & mem may be empty lists but cannot be NULL
     Assert(n != NULL && imp != NULL && m != NULL);
@@ -73,11 +89,12 @@ ClassDecl::ClassDecl(Identifier *n, NamedType *ex, List<NamedType*> *imp, List<D
     if (extends) extends->SetParent(this);
     (implements=imp)->SetParentAll(this);
     (members=m)->SetParentAll(this);
+    classType = new NamedType(id);
 }
 
 
 //construimos scope
-void ClassDecl::ScopeBuilder(Scope *parent) {
+void ClassDecl::ScopeBuilder(Scope *parent, TreeWalk *w) {
     scope->SetParent(parent);
     scope->SetClassDecl(this);
 
@@ -85,12 +102,15 @@ void ClassDecl::ScopeBuilder(Scope *parent) {
         scope->AddDeclaration(members->Nth(i));
 
     for (int i = 0, n = members->NumElements(); i < n; ++i)
-        members->Nth(i)->ScopeBuilder(scope);
+        w->BuildScope(members->Nth(i), scope);
 }
 
-void ClassDecl::Check() {
-    for (int i = 0, n = members->NumElements(); i < n; ++i)
-        members->Nth(i)->Check();
+/* One member a step, then the class itself. */
+bool ClassDecl::CheckStep(int step, TreeWalk *w) {
+    if (step < members->NumElements() && !ReportError::LimitReached()) {
+        w->Check(members->Nth(step));
+        return true;
+    }
 
     CheckExt();
     CheckImplementation();
@@ -100,6 +120,7 @@ void ClassDecl::Check() {
 
     CheckExtMemb(extends);
     CheckImplInterf();
+    return false;
 }
 
 void ClassDecl::CheckExt() {
@@ -207,21 +228,23 @@ void ClassDecl::CheckImplInterf() {
 InterfaceDecl::InterfaceDecl(Identifier *n, List<Decl*> *m) : Decl(n) {
     Assert(n != NULL && m != NULL);
     (members=m)->SetParentAll(this);
+    interfaceType = new NamedType(id);
 }
 
-void InterfaceDecl::ScopeBuilder(Scope *parent) {
+void InterfaceDecl::ScopeBuilder(Scope *parent, TreeWalk *w) {
     scope->SetParent(parent);
 
     for (int i = 0, n = members->NumElements(); i < n; ++i)
         scope->AddDeclaration(members->Nth(i));
 
     for (int i = 0, n = members->NumElements(); i < n; ++i)
-        members->Nth(i)->ScopeBuilder(scope);
+        w->BuildScope(members->Nth(i), scope);
 }
 
-void InterfaceDecl::Check() {
+bool InterfaceDecl::CheckStep(int step, TreeWalk *w) {
     for (int i = 0, n = members->NumElements(); i < n; ++i)
-        members->Nth(i)->Check();
+        w->Check(members->Nth(i));
+    return false;
 }
 
 FnDecl::FnDecl(Identifier *n, Type *r, List<VarDecl*> *d) : Decl(n) {
@@ -254,7 +277,7 @@ bool FnDecl::Equivalent(Decl *other) {
     return true;
 }
 
-void FnDecl::ScopeBuilder(Scope *parent) {
+void FnDecl::ScopeBuilder(Scope *parent, TreeWalk *w) {
     scope->SetParent(parent);
     scope->SetFnDecl(this);
 
@@ -262,17 +285,39 @@ void FnDecl::ScopeBuilder(Scope *parent) {
         scope->AddDeclaration(formals->Nth(i));
 
     for (int i = 0, n = formals->NumElements(); i < n; ++i)
-        formals->Nth(i)->ScopeBuilder(scope);
+        w->BuildScope(formals->Nth(i), scope);
 
     if (body)
-        body->ScopeBuilder(scope);
+        w->BuildScope(body, scope);
 }
 
-void FnDecl::Check() {
+bool FnDecl::CheckStep(int step, TreeWalk *w) {
     for (int i = 0, n = formals->NumElements(); i < n; ++i)
-        formals->Nth(i)->Check();
+        w->Check(formals->Nth(i));
 
     if (body)
-        body->Check();
+        w->Check(body);
+    return false;
 }
 
+
+int VarDecl::Save(AstWriter *w) {
+    return w->Add(AstWriter::VarDeclNode, NULL, w->Save(id), w->Save(type));
+}
+
+
+int ClassDecl::Save(AstWriter *w) {
+    return w->Add(AstWriter::ClassDeclNode, NULL, w->Save(id), w->Save(extends),
+                  w->SaveList(implements), w->SaveList(members));
+}
+
+
+int InterfaceDecl::Save(AstWriter *w) {
+    return w->Add(AstWriter::InterfaceDeclNode, NULL, w->Save(id), w->SaveList(members));
+}
+
+
+int FnDecl::Save(AstWriter *w) {
+    return w->Add(AstWriter::FnDeclNode, NULL, w->Save(id), w->Save(returnType),
+                  w->SaveList(formals), w->Save(body));
+}
@@ -39,8 +39,7 @@ class Decl : public Node
     const char* Name() { return id->Name(); }
     Scope* GetScope() { return scope; }
 
-    virtual void ScopeBuilder(Scope *parent);
-    virtual void Check() = 0;
+    virtual void ScopeBuilder(Scope *parent, TreeWalk *w);
 };
 
 
@@ -56,11 +55,14 @@ class VarDecl : public Decl
     bool Equivalent(Decl *other);
 
     Type* ObtainType() { return type; }
-    void Check();
+    void ScopeBuilder(Scope *parent, TreeWalk *w);
+    bool CheckStep(int step, TreeWalk *w);
+    int Save(AstWriter *w);
     //bool is_declared_type() { return type_declared; }
 
 
   private:
+    void ResolveType();
     void CheckType();
 };
 
@@ -71,17 +73,20 @@ class ClassDecl : public Decl
     List<Decl*> *members;
     NamedType *extends;
     List<NamedType*> *implements;
+    NamedType *classType;
 
   public:
     ClassDecl(Identifier *name, NamedType *extends,
               List<NamedType*> *implements, List<Decl*> *members);
 
-    void ScopeBuilder(Scope *parent);
-    void Check();
+    void ScopeBuilder(Scope *parent, TreeWalk *w);
+    bool CheckStep(int step, TreeWalk *w);
 
-    NamedType* ObtainType() { return new NamedType(id); }
+    NamedType* ObtainType() { return classType; }
     NamedType* GetExtends() { return extends; }
     List<NamedType*>* GetImplements() { return implements; }
+    List<Decl*>* GetMembers() { return members; }
+    int Save(AstWriter *w);
 
   private:
     void CheckExt();
@@ -98,15 +103,17 @@ class InterfaceDecl : public Decl
 {
   protected:
     List<Decl*> *members;
+    NamedType *interfaceType;
 
   public:
     InterfaceDecl(Identifier *name, List<Decl*> *members);
 
-    void ScopeBuilder(Scope *parent);
-    void Check();
+    void ScopeBuilder(Scope *parent, TreeWalk *w);
+    bool CheckStep(int step, TreeWalk *w);
 
-    Type* ObtainType() { return new NamedType(id); }
+    Type* ObtainType() { return interfaceType; }
     List<Decl*>* GetMembers() { return members; }
+    int Save(AstWriter *w);
 };
 
 
@@ -125,9 +132,11 @@ class FnDecl : public Decl
 
     Type* GetReturnType() { return returnType; }
     List<VarDecl*>* GetFormals() { return formals; }
+    Stmt* GetBody() { return body; }
 
-    void ScopeBuilder(Scope *parent);
-    void Check();
+    void ScopeBuilder(Scope *parent, TreeWalk *w);
+    bool CheckStep(int step, TreeWalk *w);
+    int Save(AstWriter *w);
 };
 
 #endif
@@ -5,7 +5,11 @@
 #include "ast_expr.h"
 #include "ast_type.h"
 #include "ast_decl.h"
+#include "astcache.h"
+#include "utility.h" // for PrintDebug()
 #include <string.h>
+#include <limits.h>
+#include <cmath>
 
 
 ClassDecl* Expr::GetClassDeclaration(Scope *s) {
@@ -61,7 +65,7 @@ Decl* Expr::GetFieldDeclaration(Identifier *f, Scope *s) {
 }
 
 
-Type* EmptyExpr::ObtainType() {
+Type* EmptyExpr::WorkOutType() {
     return Type::errorType;
 }
 
@@ -71,7 +75,7 @@ IntConstant::IntConstant(yyltype loc, int val) : Expr(loc) {
 }
 
 
-Type* IntConstant::ObtainType() {
+Type* IntConstant::WorkOutType() {
     return Type::intType;
 }
 
@@ -81,7 +85,7 @@ DoubleConstant::DoubleConstant(yyltype loc, double val) : Expr(loc) {
 }
 
 
-Type* DoubleConstant::ObtainType() {
+Type* DoubleConstant::WorkOutType() {
     return Type::doubleType;
 }
 
@@ -91,34 +95,46 @@ BoolConstant::BoolConstant(yyltype loc, bool val) : Expr(loc) {
 }
 
 
-Type* BoolConstant::ObtainType() {
+Type* BoolConstant::WorkOutType() {
     return Type::boolType;
 }
 
 
-StringConstant::StringConstant(yyltype loc, const char *val) : Expr(loc) {
+StringConstant::StringConstant(yyltype loc, const PooledString *val) : Expr(loc) {
     Assert(val != NULL);
-    value = strdup(val);
+    value = val;
 }
 
 
-Type* StringConstant::ObtainType() {
+Type* StringConstant::WorkOutType() {
     return Type::stringType;
 }
 
 
-Type* NullConstant::ObtainType() {
+Type* NullConstant::WorkOutType() {
     return Type::nullType;
 }
 
 
-Operator::Operator(yyltype loc, const char *tok) : Node(loc) {
-    Assert(tok != NULL);
-    strncpy(tokenString, tok, sizeof(tokenString));
+Operator::Operator(yyltype loc, OpCode c) : Node(loc) {
+    Assert(c >= 0 && c < NumOpCodes);
+    code = c;
+}
+
+
+const char* Operator::Name() {
+    static const char *names[NumOpCodes] = {
+        "+", "-", "*", "/", "%", "<", "<=", ">", ">=", "==", "!=",
+        "&&", "||", "!", "++", "--", "="
+    };
+    return names[code];
 }
+
+
 CompoundExpr::CompoundExpr(Expr *l, Operator *o, Expr *r)
   : Expr(Join(l->GetLocation(), r->GetLocation())) {
     Assert(l != NULL && o != NULL && r != NULL);
+    folded = NULL;
     (op=o)->SetParent(this);
     (left=l)->SetParent(this);
     (right=r)->SetParent(this);
@@ -129,6 +145,7 @@ CompoundExpr::CompoundExpr(Operator *o, Expr *r)
   : Expr(Join(o->GetLocation(), r->GetLocation())) {
     Assert(o != NULL && r != NULL);
     left = NULL;
+    folded = NULL;
     (op=o)->SetParent(this);
     (right=r)->SetParent(this);
 }
@@ -138,217 +155,294 @@ CompoundExpr::CompoundExpr(Expr *l, Operator *o)
   : Expr(Join(l->GetLocation(), o->GetLocation())) {
     Assert(o != NULL && l != NULL);
     right = NULL;
+    folded = NULL;
     (op=o)->SetParent(this);
     (left=l)->SetParent(this);
 }
 
 
-void CompoundExpr::ScopeBuilder(Scope *parent) {
-    scope->SetParent(parent);
-
-    if (left != NULL)
-        left->ScopeBuilder(scope);
-    if (right != NULL)
-        right->ScopeBuilder(scope);
-}
-
+void CompoundExpr::ScopeBuilder(Scope *parent, TreeWalk *w) {
+    Expr::ScopeBuilder(parent, w);
 
-void CompoundExpr::Check() {
     if (left != NULL)
-        left->Check();
-
+        w->BuildScope(left, scope);
     if (right != NULL)
-        right->Check();
+        w->BuildScope(right, scope);
 }
 
 
-Type* PostfixExpr::ObtainType() {
-    Type *ltype = left->ObtainType();
+/* Operator typing
+ * ---------------
+ * Whether an operator applies to its operands, and the type of what it
+ * gives, goes by the kinds of the operand types alone except for == and
+ * != on two objects. OperatorResultFor() has the rules, and the table
+ * made from them when compiling is what OperationType() looks in, once
+ * for each node. An operand of error type was reported already, so it
+ * passes for whatever type the operator wants.
+ */
 
-    if (ltype->Equivalent(Type::intType))
-        return ltype;
-    else
-        return Type::errorType;
-}
+typedef enum {
+    NotApplicable,              // report the operands
+    IntResult, DoubleResult, BoolResult,
+    ErrorResult,                // applies, but an operand is of error type
+    BoolIfCompatible            // bool if either type is equivalent to the other
+} OperatorResult;
 
 
-void PostfixExpr::Check() {
-    if (left != NULL)
-        left->Check();
+static const int NoOperand = NumTypeKinds; // the left of a unary, the right of a postfix
 
-    Type *ltype = left->ObtainType();
 
-    if (ltype->Equivalent(Type::intType))
-        return;
-    else
-        ReportError::IncompatibleOperand(op, ltype);
+static constexpr bool Passes(int kind, TypeKind wanted) {
+    return kind == wanted || kind == ErrorKind;
 }
 
 
-Type* ArithmeticExpr::ObtainType() {
-    Type *rtype = right->ObtainType();
-
-    if (left == NULL) {
-        if (rtype->Equivalent(Type::intType) ||
-            rtype->Equivalent(Type::doubleType))
-            return rtype;
-        else
-            return Type::errorType;
-    }
-
-    Type *ltype = left->ObtainType();
-
-    if (ltype->Equivalent(Type::intType) &&
-        rtype->Equivalent(Type::intType))
-        return ltype;
-
-    if (ltype->Equivalent(Type::doubleType) &&
-        rtype->Equivalent(Type::doubleType))
-        return ltype;
-
-    return Type::errorType;
+/* For the arithmetic operators, whose result is of the left operand's type. */
+static constexpr OperatorResult ResultOfKind(int kind) {
+    return kind == IntKind ? IntResult : kind == DoubleKind ? DoubleResult : ErrorResult;
 }
 
 
-void ArithmeticExpr::Check() {
-    if (left != NULL)
-        left->Check();
+static constexpr bool IsObject(int kind) {
+    return kind == NamedKind || kind == ArrayKind;
+}
 
-    right->Check();
 
-    Type *rtype = right->ObtainType();
+static constexpr OperatorResult OperatorResultFor(OpCode op, int l, int r) {
+    switch (op) {
+      case OpMinus:
+        if (l == NoOperand)
+            return (Passes(r, IntKind) || Passes(r, DoubleKind)) ? ResultOfKind(r) : NotApplicable;
+        // fall through
+      case OpPlus: case OpTimes: case OpDivide: case OpModulo:
+        if ((Passes(l, IntKind) && Passes(r, IntKind)) ||
+            (Passes(l, DoubleKind) && Passes(r, DoubleKind)))
+            return ResultOfKind(l);
+        return NotApplicable;
 
-    if (left == NULL) {
-        if (rtype->Equivalent(Type::intType) ||
-            rtype->Equivalent(Type::doubleType))
-            return;
-        else
-            ReportError::IncompatibleOperand(op, rtype);
+      case OpLess: case OpLessEqual: case OpGreater: case OpGreaterEqual:
+        if ((Passes(l, IntKind) && Passes(r, IntKind)) ||
+            (Passes(l, DoubleKind) && Passes(r, DoubleKind)))
+            return BoolResult;
+        return NotApplicable;
 
-        return;
-    }
+      case OpEqual: case OpNotEqual:
+        if (l == NoOperand || r == NoOperand)
+            return NotApplicable;
+        if (l == ErrorKind || r == ErrorKind)
+            return BoolResult;
+        if (IsObject(l) && IsObject(r))
+            return l == r ? BoolIfCompatible : NotApplicable;
+        if ((l == NullKind && r == NamedKind) || (l == NamedKind && r == NullKind))
+            return BoolResult;
+        return (l == r && !IsObject(l)) ? BoolResult : NotApplicable;
 
-    Type *ltype = left->ObtainType();
+      case OpAnd: case OpOr:
+        return (Passes(l, BoolKind) && Passes(r, BoolKind)) ? BoolResult : NotApplicable;
+      case OpNot:
+        return (l == NoOperand && Passes(r, BoolKind)) ? BoolResult : NotApplicable;
 
-    if (ltype->Equivalent(Type::intType) &&
-        rtype->Equivalent(Type::intType))
-        return;
+      case OpIncrement: case OpDecrement:
+        return (r == NoOperand && Passes(l, IntKind)) ? ResultOfKind(l) : NotApplicable;
 
-    if (ltype->Equivalent(Type::doubleType) &&
-        rtype->Equivalent(Type::doubleType))
-        return;
-
-    ReportError::IncompatibleOperands(op, ltype, rtype);
+      default: // '=' is typed by AssignExpr
+        return NotApplicable;
+    }
 }
 
 
-Type* RelationalExpr::ObtainType() {
-    Type *rtype = right->ObtainType();
-    Type *ltype = left->ObtainType();
-
-    if (ltype->Equivalent(Type::intType) &&
-        rtype->Equivalent(Type::intType))
-        return Type::errorType;
+struct OperatorTable {
+    unsigned char results[NumOpCodes][NumTypeKinds + 1][NumTypeKinds + 1];
+};
 
-    if (ltype->Equivalent(Type::doubleType) &&
-        rtype->Equivalent(Type::doubleType))
-        return Type::errorType;
 
-    return Type::boolType;
+static constexpr OperatorTable MakeOperatorTable() {
+    OperatorTable t = {};
+    for (int op = 0; op < NumOpCodes; op++)
+        for (int l = 0; l <= NoOperand; l++)
+            for (int r = 0; r <= NoOperand; r++)
+                t.results[op][l][r] = OperatorResultFor((OpCode)op, l, r);
+    return t;
 }
 
 
-void RelationalExpr::Check() {
-    left->Check();
-    right->Check();
-    Type *rtype = right->ObtainType();
-    Type *ltype = left->ObtainType();
+static constexpr OperatorTable operatorTable = MakeOperatorTable();
 
-    if (ltype->Equivalent(Type::intType) &&
-        rtype->Equivalent(Type::intType))
-        return;
 
-    if (ltype->Equivalent(Type::doubleType) &&
-        rtype->Equivalent(Type::doubleType))
-        return;
+Type* CompoundExpr::OperationType(Type *ltype, Type *rtype) {
+    int l = (ltype ? ltype->GetKind() : NoOperand);
+    int r = (rtype ? rtype->GetKind() : NoOperand);
 
-    ReportError::IncompatibleOperands(op, ltype, rtype);
+    switch (operatorTable.results[op->GetCode()][l][r]) {
+      case IntResult:    return Type::intType;
+      case DoubleResult: return Type::doubleType;
+      case BoolResult:   return Type::boolType;
+      case ErrorResult:  return Type::errorType;
+      case BoolIfCompatible:
+        if (rtype->Equivalent(ltype) || ltype->Equivalent(rtype))
+            return Type::boolType;
+        return NULL;
+      default:
+        return NULL;
+    }
 }
 
 
-Type* EqualityExpr::ObtainType() {
-    Type *rtype = right->ObtainType();
-    Type *ltype = left->ObtainType();
-
-    if (!rtype->Equivalent(ltype) &&
-        !ltype->Equivalent(rtype))
-        return Type::errorType;
-
-   return Type::boolType;
+void CompoundExpr::TypeOperands(TreeWalk *w) {
+    w->NeedType(left);
+    w->NeedType(right);
 }
 
 
-void EqualityExpr::Check() {
-    left->Check();
-    right->Check();
-
-    Type *rtype = right->ObtainType();
-    Type *ltype = left->ObtainType();
-
-    if (!rtype->Equivalent(ltype) &&
-        !ltype->Equivalent(rtype))
-        ReportError::IncompatibleOperands(op, ltype, rtype);
+Type* CompoundExpr::WorkOutType() {
+    Type *t = OperationType(left ? left->ObtainType() : NULL,
+                            right ? right->ObtainType() : NULL);
+    return t ? t : Type::errorType;
 }
 
 
-Type* LogicalExpr::ObtainType() {
-    Type *rtype = right->ObtainType();
-
-    if (left == NULL) {
-        if (rtype->Equivalent(Type::boolType))
-            return Type::boolType;
-        else
-            return Type::errorType;
+bool CompoundExpr::CheckStep(int step, TreeWalk *w) {
+    if (step == 0) {
+        if (left != NULL)
+            w->Check(left);
+        if (right != NULL)
+            w->Check(right);
+        return true;
     }
 
-    Type *ltype = left->ObtainType();
+    if (left != NULL)
+        left = FoldedChild(left);
+    if (right != NULL)
+        right = FoldedChild(right);
 
-    if (ltype->Equivalent(Type::boolType) &&
-        rtype->Equivalent(Type::boolType))
-        return Type::boolType;
+    Type *ltype = (left ? left->ObtainType() : NULL);
+    Type *rtype = (right ? right->ObtainType() : NULL);
 
-    return Type::errorType;
+    if (OperationType(ltype, rtype) != NULL) {
+        if ((folded = FoldConstants()) != NULL)
+            PrintDebug("fold", "Folded %s on line %d", op->Name(), location->first_line);
+    } else if (ltype == NULL)
+        ReportError::IncompatibleOperand(op, rtype);
+    else if (rtype == NULL)
+        ReportError::IncompatibleOperand(op, ltype);
+    else
+        ReportError::IncompatibleOperands(op, ltype, rtype);
+    return false;
 }
 
 
-void LogicalExpr::Check() {
-    if (left != NULL)
-        left->Check();
-
-    right->Check();
-
-    Type *rtype = right->ObtainType();
+/* Constant folding
+ * ----------------
+ * Operands are only taken as constants once they have been folded
+ * themselves, so a whole constant subexpression ends up as one node.
+ */
 
+struct Constant {
+    TypeKind kind;              // IntKind, DoubleKind or BoolKind
+    int i;
+    double d;
+    bool b;
+};
+
+
+static bool IsConstant(Expr *e, Constant *c) {
+    IntConstant *ic;
+    DoubleConstant *dc;
+    BoolConstant *bc;
+
+    if ((ic = dynamic_cast<IntConstant*>(e)) != NULL) {
+        c->kind = IntKind;
+        c->i = ic->GetValue();
+    } else if ((dc = dynamic_cast<DoubleConstant*>(e)) != NULL) {
+        c->kind = DoubleKind;
+        c->d = dc->GetValue();
+    } else if ((bc = dynamic_cast<BoolConstant*>(e)) != NULL) {
+        c->kind = BoolKind;
+        c->b = bc->GetValue();
+    } else
+        return false;
+    return true;
+}
+
+
+/* The operands have been checked, so for a binary operator both are of
+ * the same kind: ints or doubles for the arithmetic and relational ones,
+ * and bools for the logical ones. */
+Expr* CompoundExpr::FoldConstants() {
+    Constant l, r;
+    OpCode code = op->GetCode();
+    yyltype loc = *location;
+
+    if (right == NULL || !IsConstant(right, &r))
+        return NULL; // ++ and -- change a variable
     if (left == NULL) {
-        if (rtype->Equivalent(Type::boolType))
-            return;
-        else
-            ReportError::IncompatibleOperand(op, rtype);
-
-        return;
+        if (code == OpNot)
+            return new BoolConstant(loc, !r.b);
+        if (r.kind == DoubleKind)
+            return new DoubleConstant(loc, -r.d);
+        if (r.i == INT_MIN) {
+            ReportError::ConstantOverflow(this);
+            return NULL;
+        }
+        return new IntConstant(loc, -r.i);
+    }
+    if (!IsConstant(left, &l) || l.kind != r.kind)
+        return NULL;
+
+    switch (code) {
+      case OpPlus: case OpMinus: case OpTimes: case OpDivide: case OpModulo:
+        break;
+      case OpLess:         return new BoolConstant(loc, l.kind == IntKind ? l.i < r.i : l.d < r.d);
+      case OpLessEqual:    return new BoolConstant(loc, l.kind == IntKind ? l.i <= r.i : l.d <= r.d);
+      case OpGreater:      return new BoolConstant(loc, l.kind == IntKind ? l.i > r.i : l.d > r.d);
+      case OpGreaterEqual: return new BoolConstant(loc, l.kind == IntKind ? l.i >= r.i : l.d >= r.d);
+      case OpEqual: case OpNotEqual: {
+        bool same = (l.kind == IntKind ? l.i == r.i : l.kind == DoubleKind ? l.d == r.d : l.b == r.b);
+        return new BoolConstant(loc, code == OpEqual ? same : !same);
+      }
+      case OpAnd:          return new BoolConstant(loc, l.b && r.b);
+      case OpOr:           return new BoolConstant(loc, l.b || r.b);
+      default:             return NULL;
     }
 
-    Type *ltype = left->ObtainType();
-
-    if (ltype->Equivalent(Type::boolType) &&
-        rtype->Equivalent(Type::boolType))
-        return;
+    if ((code == OpDivide || code == OpModulo) &&
+        (l.kind == IntKind ? r.i == 0 : r.d == 0.0)) {
+        ReportError::DivisionByZero(this);
+        return NULL;
+    }
+    if (l.kind == DoubleKind) {
+        double d;
+        switch (code) {
+          case OpPlus:   d = l.d + r.d; break;
+          case OpMinus:  d = l.d - r.d; break;
+          case OpTimes:  d = l.d * r.d; break;
+          case OpDivide: d = l.d / r.d; break;
+          default:       return NULL; // no % on doubles at run time to match
+        }
+        if (!std::isfinite(d)) {
+            ReportError::ConstantOverflow(this);
+            return NULL;
+        }
+        return new DoubleConstant(loc, d);
+    }
 
-    ReportError::IncompatibleOperands(op, ltype, rtype);
+    long long x = l.i, y = r.i, z;
+    switch (code) {
+      case OpPlus:   z = x + y; break;
+      case OpMinus:  z = x - y; break;
+      case OpTimes:  z = x * y; break;
+      case OpDivide: z = x / y; break;
+      default:       z = x % y; break;
+    }
+    if (z < INT_MIN || z > INT_MAX) {
+        ReportError::ConstantOverflow(this);
+        return NULL;
+    }
+    return new IntConstant(loc, (int)z);
 }
 
 
-Type* AssignExpr::ObtainType() {
+Type* AssignExpr::WorkOutType() {
     Type *ltype = left->ObtainType();
     Type *rtype = right->ObtainType();
 
@@ -359,19 +453,24 @@ Type* AssignExpr::ObtainType() {
 }
 
 
-void AssignExpr::Check() {
-    left->Check();
-    right->Check();
+bool AssignExpr::CheckStep(int step, TreeWalk *w) {
+    if (step == 0) {
+        w->Check(left);
+        w->Check(right);
+        return true;
+    }
+    right = FoldedChild(right);
 
     Type *ltype = left->ObtainType();
     Type *rtype = right->ObtainType();
 
     if (!rtype->Equivalent(ltype) && !ltype->IsEqualTo(Type::errorType))
         ReportError::IncompatibleOperands(op, ltype, rtype);
+    return false;
 }
 
 
-Type* This::ObtainType() {
+Type* This::WorkOutType() {
     ClassDecl *d = GetClassDeclaration(scope);
     if (d == NULL)
         return Type::errorType;
@@ -380,9 +479,10 @@ Type* This::ObtainType() {
 }
 
 
-void This::Check() {
+bool This::CheckStep(int step, TreeWalk *w) {
     if (GetClassDeclaration(scope) == NULL)
         ReportError::ThisOutsideClassScope(this);
+    return false;
 }
 
 
@@ -392,7 +492,12 @@ ArrayAccess::ArrayAccess(yyltype loc, Expr *b, Expr *s) : LValue(loc) {
 }
 
 
-Type* ArrayAccess::ObtainType() {
+void ArrayAccess::TypeOperands(TreeWalk *w) {
+    w->NeedType(base);
+}
+
+
+Type* ArrayAccess::WorkOutType() {
     ArrayType *t = dynamic_cast<ArrayType*>(base->ObtainType());
     if (t == NULL)
         return Type::errorType;
@@ -401,20 +506,24 @@ Type* ArrayAccess::ObtainType() {
 }
 
 
-void ArrayAccess::ScopeBuilder(Scope *parent) {
-    scope->SetParent(parent);
+void ArrayAccess::ScopeBuilder(Scope *parent, TreeWalk *w) {
+    Expr::ScopeBuilder(parent, w);
 
-    base->ScopeBuilder(scope);
-    subscript->ScopeBuilder(scope);
+    w->BuildScope(base, scope);
+    w->BuildScope(subscript, scope);
 }
 
 
-void ArrayAccess::Check() {
-    base->Check();
-    subscript->Check();
+bool ArrayAccess::CheckStep(int step, TreeWalk *w) {
+    if (step == 0) {
+        w->Check(base);
+        w->Check(subscript);
+        return true;
+    }
+    subscript = FoldedChild(subscript);
 
     if (base->ObtainType() == Type::errorType) // The base is an undeclared variable, so we don't need to further check the fields.
-        return;
+        return false;
 
     ArrayType *t = dynamic_cast<ArrayType*>(base->ObtainType());
     if (t == NULL)
@@ -422,6 +531,7 @@ void ArrayAccess::Check() {
 
     if (subscript->ObtainType() != Type::errorType && !subscript->ObtainType()->IsEqualTo(Type::intType))
         ReportError::SubscriptNotInteger(subscript);
+    return false;
 }
 
 
@@ -434,7 +544,12 @@ FieldAccess::FieldAccess(Expr *b, Identifier *f)
 }
 
 
-Type* FieldAccess::ObtainType() {
+void FieldAccess::TypeOperands(TreeWalk *w) {
+    w->NeedType(base);
+}
+
+
+Type* FieldAccess::WorkOutType() {
     Decl *d;
     ClassDecl *c;
     Type *t;
@@ -463,19 +578,22 @@ Type* FieldAccess::ObtainType() {
 }
 
 
-void FieldAccess::ScopeBuilder(Scope *parent) {
-    scope->SetParent(parent);
+void FieldAccess::ScopeBuilder(Scope *parent, TreeWalk *w) {
+    Expr::ScopeBuilder(parent, w);
 
     if (base != NULL)
-        base->ScopeBuilder(scope);
+        w->BuildScope(base, scope);
 }
 
-void FieldAccess::Check() {
+bool FieldAccess::CheckStep(int step, TreeWalk *w) {
     if (base != NULL) {
-        base->Check();
+        if (step == 0) {
+            w->Check(base);
+            return true;
+        }
 
         if (base->ObtainType() == Type::errorType) // The base is an undeclared variable, so we don't need to further check the fields.
-            return;
+            return false;
     }
     Decl *d;
     Type *t;
@@ -485,29 +603,30 @@ void FieldAccess::Check() {
         if (c == NULL) {
             if ((d = GetFieldDeclaration(field, scope)) == NULL) {
                 ReportError::IdentifierNotDeclared(field, LookingForVariable);
-                return;
+                return false;
             }
         } else {
             t = c->ObtainType();
             if ((d = GetFieldDeclaration(field, t)) == NULL) {
                 ReportError::FieldNotFoundInBase(field, t);
-                return;
+                return false;
             }
         }
     } else {
         t = base->ObtainType();
         if ((d = GetFieldDeclaration(field, t)) == NULL) {
             ReportError::FieldNotFoundInBase(field, t);
-            return;
+            return false;
         }
         else if (GetClassDeclaration(scope) == NULL) {
             ReportError::InaccessibleField(field, t);
-            return;
+            return false;
         }
     }
 
     if (dynamic_cast<VarDecl*>(d) == NULL)
         ReportError::IdentifierNotDeclared(field, LookingForVariable);
+    return false;
 }
 
 
@@ -519,7 +638,11 @@ Call::Call(yyltype loc, Expr *b, Identifier *f, List<Expr*> *a) : Expr(loc)  {
     (actuals=a)->SetParentAll(this);
 }
 
-Type* Call::ObtainType() {
+void Call::TypeOperands(TreeWalk *w) {
+    w->NeedType(base);
+}
+
+Type* Call::WorkOutType() {
     Decl *d;
 
     if (base == NULL) {
@@ -550,20 +673,32 @@ Type* Call::ObtainType() {
 }
 
 
-void Call::ScopeBuilder(Scope *parent) {
-    scope->SetParent(parent);
+void Call::ScopeBuilder(Scope *parent, TreeWalk *w) {
+    Expr::ScopeBuilder(parent, w);
 
     if (base != NULL)
-        base->ScopeBuilder(scope);
+        w->BuildScope(base, scope);
 
     for (int i = 0, n = actuals->NumElements(); i < n; ++i)
-        actuals->Nth(i)->ScopeBuilder(scope);
+        w->BuildScope(actuals->Nth(i), scope);
 }
 
 
-void Call::Check() {
-    if (base != NULL)
-        base->Check();
+/* The base, then the actuals unless the base is of an undeclared type,
+ * then the call itself. */
+bool Call::CheckStep(int step, TreeWalk *w) {
+    if (step == 0) {
+        if (base != NULL)
+            w->Check(base);
+        return true;
+    }
+    if (step == 1) {
+        if (base != NULL && !base->ObtainType()->typeDeclared)
+            return false; // No need to check the fields of undeclared type.
+        for (int i = 0, n = actuals->NumElements(); i < n; ++i)
+            w->Check(actuals->Nth(i));
+        return true;
+    }
 
     Decl *d;
     Type *t;
@@ -574,19 +709,18 @@ void Call::Check() {
             if ((d = GetFieldDeclaration(field, scope)) == NULL) {
                 CheckActuals(d);
                 ReportError::IdentifierNotDeclared(field, LookingForFunction);
-                return;
+                return false;
             }
         } else {
             t = c->ObtainType();
             if ((d = GetFieldDeclaration(field, t)) == NULL) {
                 CheckActuals(d);
                 ReportError::IdentifierNotDeclared(field, LookingForFunction);
-                return;
+                return false;
             }
         }
     } else {
         t = base->ObtainType();
-        if (! t->typeDeclared) {return;} // No need to check the fields of undeclared type.
         if ((d = GetFieldDeclaration(field, t)) == NULL) {  //&& f->ObtainType() == lookup->ObtainType()
             CheckActuals(d);
 
@@ -594,17 +728,18 @@ void Call::Check() {
                 strcmp("length", field->Name()) != 0)
                     ReportError::FieldNotFoundInBase(field, t);
 
-            return;
+            return false;
         }
     }
 
     CheckActuals(d);
+    return false;
 }
 
 
 void Call::CheckActuals(Decl *d) {
     for (int i = 0, n = actuals->NumElements(); i < n; ++i)
-        actuals->Nth(i)->Check();
+        actuals->SetNth(FoldedChild(actuals->Nth(i)), i);
 
     FnDecl *fnDecl = dynamic_cast<FnDecl*>(d);
     if (fnDecl == NULL)
@@ -634,7 +769,7 @@ NewExpr::NewExpr(yyltype loc, NamedType *c) : Expr(loc) {
 }
 
 
-Type* NewExpr::ObtainType() {
+Type* NewExpr::WorkOutType() {
     Decl *d = Program::gScope->table->Lookup(cType->Name());
     ClassDecl *c = dynamic_cast<ClassDecl*>(d);
 
@@ -645,56 +780,171 @@ Type* NewExpr::ObtainType() {
 }
 
 
-void NewExpr::Check() {
+bool NewExpr::CheckStep(int step, TreeWalk *w) {
     Decl *d = Program::gScope->table->Lookup(cType->Name());
     ClassDecl *c = dynamic_cast<ClassDecl*>(d);
 
     if (c == NULL)
         ReportError::IdentifierNotDeclared(cType->GetId(), LookingForClass);
+    return false;
 }
 
 
 NewArrayExpr::NewArrayExpr(yyltype loc, Expr *sz, Type *et) : Expr(loc) {
     Assert(sz != NULL && et != NULL);
     (size=sz)->SetParent(this);
+    arrayType = new ArrayType(et);
     (elemType=et)->SetParent(this);
 }
 
 
-Type* NewArrayExpr::ObtainType() {
-    return new ArrayType(elemType);
+Type* NewArrayExpr::WorkOutType() {
+    return arrayType;
 }
 
 
-void NewArrayExpr::ScopeBuilder(Scope *parent) {
-    scope->SetParent(parent);
+void NewArrayExpr::ScopeBuilder(Scope *parent, TreeWalk *w) {
+    Expr::ScopeBuilder(parent, w);
 
-    size->ScopeBuilder(scope);
+    w->BuildScope(size, scope);
 }
 
 
-void NewArrayExpr::Check() {
-    size->Check();
+bool NewArrayExpr::CheckStep(int step, TreeWalk *w) {
+    if (step == 0) {
+        w->Check(size);
+        return true;
+    }
+    size = FoldedChild(size);
 
     if (size->ObtainType() != Type::errorType && !size->ObtainType()->IsEqualTo(Type::intType))
         ReportError::NewArraySizeNotInteger(size);
 
     if (elemType->IsPrimitive() && !elemType->Equivalent(Type::voidType))
-        return;
+        return false;
 
     Decl *d = Program::gScope->table->Lookup(elemType->Name());
     if (dynamic_cast<ClassDecl*>(d) == NULL)
         elemType->ReportNotDeclaredID(LookingForType);
+    return false;
 }
 
 
-Type* ReadIntegerExpr::ObtainType() {
+Type* ReadIntegerExpr::WorkOutType() {
     return Type::intType;
 }
 
 
-Type* ReadLineExpr::ObtainType() {
+Type* ReadLineExpr::WorkOutType() {
     return Type::stringType;
 }
 
 
+int EmptyExpr::Save(AstWriter *w) {
+    return w->Add(AstWriter::EmptyExprNode, NULL);
+}
+
+
+int IntConstant::Save(AstWriter *w) {
+    return w->Add(AstWriter::IntConstantNode, location, value);
+}
+
+
+/* The two halves of the double go in two fields. */
+int DoubleConstant::Save(AstWriter *w) {
+    int halves[2];
+    memcpy(halves, &value, sizeof(value));
+    return w->Add(AstWriter::DoubleConstantNode, location, halves[0], halves[1]);
+}
+
+
+int BoolConstant::Save(AstWriter *w) {
+    return w->Add(AstWriter::BoolConstantNode, location, value);
+}
+
+
+int StringConstant::Save(AstWriter *w) {
+    return w->Add(AstWriter::StringConstantNode, location, w->Literal(value));
+}
+
+
+int NullConstant::Save(AstWriter *w) {
+    return w->Add(AstWriter::NullConstantNode, location);
+}
+
+
+/* The OpCode of the operator goes in one field. */
+int Operator::Save(AstWriter *w) {
+    return w->Add(AstWriter::OperatorNode, location, code);
+}
+
+
+int PostfixExpr::Save(AstWriter *w) {
+    return w->Add(AstWriter::PostfixExprNode, NULL, w->Save(left), w->Save(op));
+}
+
+
+int ArithmeticExpr::Save(AstWriter *w) {
+    return w->Add(AstWriter::ArithmeticExprNode, NULL, w->Save(left), w->Save(op), w->Save(right));
+}
+
+
+int RelationalExpr::Save(AstWriter *w) {
+    return w->Add(AstWriter::RelationalExprNode, NULL, w->Save(left), w->Save(op), w->Save(right));
+}
+
+
+int EqualityExpr::Save(AstWriter *w) {
+    return w->Add(AstWriter::EqualityExprNode, NULL, w->Save(left), w->Save(op), w->Save(right));
+}
+
+
+int LogicalExpr::Save(AstWriter *w) {
+    return w->Add(AstWriter::LogicalExprNode, NULL, w->Save(left), w->Save(op), w->Save(right));
+}
+
+
+int AssignExpr::Save(AstWriter *w) {
+    return w->Add(AstWriter::AssignExprNode, NULL, w->Save(left), w->Save(op), w->Save(right));
+}
+
+
+int This::Save(AstWriter *w) {
+    return w->Add(AstWriter::ThisNode, location);
+}
+
+
+int ArrayAccess::Save(AstWriter *w) {
+    return w->Add(AstWriter::ArrayAccessNode, location, w->Save(base), w->Save(subscript));
+}
+
+
+int FieldAccess::Save(AstWriter *w) {
+    return w->Add(AstWriter::FieldAccessNode, NULL, w->Save(base), w->Save(field));
+}
+
+
+int Call::Save(AstWriter *w) {
+    return w->Add(AstWriter::CallNode, location, w->Save(base), w->Save(field),
+                  w->SaveList(actuals));
+}
+
+
+int NewExpr::Save(AstWriter *w) {
+    return w->Add(AstWriter::NewExprNode, location, w->Save(cType));
+}
+
+
+int NewArrayExpr::Save(AstWriter *w) {
+    return w->Add(AstWriter::NewArrayExprNode, location, w->Save(size), w->Save(elemType));
+}
+
+
+int ReadIntegerExpr::Save(AstWriter *w) {
+    return w->Add(AstWriter::ReadIntegerExprNode, location);
+}
+
+
+int ReadLineExpr::Save(AstWriter *w) {
+    return w->Add(AstWriter::ReadLineExprNode, location);
+}
@@ -13,10 +13,13 @@
 #include "ast.h"
 #include "ast_stmt.h"
 #include "list.h"
+#include "strpool.h"
+#include "walk.h"
 
 
 class NamedType; // for new
 class Type; // for NewArray
+class ArrayType;
 
 class FnDecl;
 class ClassDecl;
@@ -24,14 +27,35 @@ class ClassDecl;
 
 class Expr : public Stmt
 {
+  protected:
+    Type *knownType;    // once worked out
+
   public:
-    Expr(yyltype loc) : Stmt(loc) {}
-    Expr() : Stmt() {}
+    Expr(yyltype loc) : Stmt(loc), knownType(NULL) {}
+    Expr() : Stmt(), knownType(NULL) {}
+
+          // The type of the expression, worked out the first time it is
+          // asked for, after those of the operands it needs
+    Type* ObtainType() { if (!knownType) WorkOutTypes(this); return knownType; }
 
-//add virtual type and protected mode
-    virtual Type* ObtainType() = 0;
+          // An expression declares nothing, so it looks names up in the
+          // scope it is in rather than one of its own, which would have
+          // lookups in deeply nested expressions go through all of them
+    void ScopeBuilder(Scope *parent, TreeWalk *w) { scope = parent; }
+
+          // The constant this was folded to when it was checked, if it
+          // was, else this
+    virtual Expr* Folded() { return this; }
 
   protected:
+          // Works out the type of the expression, from those of the
+          // operands TypeOperands names, which are known by then
+    virtual Type* WorkOutType() = 0;
+    virtual void TypeOperands(TreeWalk *w) {}
+
+    friend class TreeWalk;
+    friend void WorkOutTypes(Expr *root);
+
     ClassDecl* GetClassDeclaration(Scope *s);
     Decl* GetFieldDeclaration(Identifier *field, Type *base);
     Decl* GetFieldDeclaration(Identifier *field, Scope *scope);
@@ -47,8 +71,8 @@ class Expr : public Stmt
 class EmptyExpr : public Expr
 {
   public:
-    Type* ObtainType();
-    void Check() {}
+    Type* WorkOutType();
+    int Save(AstWriter *w);
 };
 
 
@@ -59,9 +83,10 @@ class IntConstant : public Expr
 
   public:
     IntConstant(yyltype loc, int val);
+    int GetValue() { return value; }
 
-    Type* ObtainType();
-    void Check() {}
+    Type* WorkOutType();
+    int Save(AstWriter *w);
 };
 
 
@@ -72,9 +97,10 @@ class DoubleConstant : public Expr
 
   public:
     DoubleConstant(yyltype loc, double val);
+    double GetValue() { return value; }
 
-    Type* ObtainType();
-    void Check() {}
+    Type* WorkOutType();
+    int Save(AstWriter *w);
 };
 
 
@@ -85,23 +111,25 @@ class BoolConstant : public Expr
 
   public:
     BoolConstant(yyltype loc, bool val);
+    bool GetValue() { return value; }
 
-    Type* ObtainType();
-    void Check() {}
+    Type* WorkOutType();
+    int Save(AstWriter *w);
 };
 
 
 class StringConstant : public Expr
 {
   protected:
-    char *value;
+    const PooledString *value;  // entry in stringLiterals
 
   public:
-    StringConstant(yyltype loc, const char *val);
+    StringConstant(yyltype loc, const PooledString *val);
+    const PooledString *GetLiteral() { return value; }
 
 
-    Type* ObtainType();
-    void Check() {}
+    Type* WorkOutType();
+    int Save(AstWriter *w);
 };
 
 
@@ -111,28 +139,63 @@ class NullConstant: public Expr
     NullConstant(yyltype loc) : Expr(loc) {}
 
 
-    Type* ObtainType();
-    void Check() {}
+    Type* WorkOutType();
+    int Save(AstWriter *w);
 };
 
 
+/* The operators. Unary minus is OpMinus with no left operand. */
+typedef enum {
+    OpPlus, OpMinus, OpTimes, OpDivide, OpModulo,
+    OpLess, OpLessEqual, OpGreater, OpGreaterEqual,
+    OpEqual, OpNotEqual, OpAnd, OpOr, OpNot,
+    OpIncrement, OpDecrement, OpAssign,
+    NumOpCodes
+} OpCode;
+
+
 class Operator : public Node
 {
   protected:
-    char tokenString[4];
+    OpCode code;
 
 
   public:
-    Operator(yyltype loc, const char *tok);
-    friend std::ostream& operator<<(std::ostream& out, Operator *o) { return out << o->tokenString; }
+    Operator(yyltype loc, OpCode code);
+    OpCode GetCode() { return code; }
+    const char *Name();             // the token it is written as
+    friend std::ostream& operator<<(std::ostream& out, Operator *o) { return out << o->Name(); }
+    int Save(AstWriter *w);
  };
 
 
+/* Class: CompoundExpr
+ * -------------------
+ * The operators other than '=' are typed the same way whichever kind of
+ * expression they are in, by looking up the kinds of the operand types
+ * in one table (see ast_expr.cc), so the subclasses for them only say
+ * how they are saved.
+ *
+ * Once checked, an operator other than ++, -- and '=' whose operands are
+ * int, double or bool constants is folded to the constant it gives,
+ * which its parent then has in its place (see Stmt::FoldedChild). Ints
+ * are 32 bits, as in Decaf. An operation that overflows or divides by
+ * zero is warned about and left as it is, for what it does at run time.
+ */
 class CompoundExpr : public Expr
 {
   protected:
     Operator *op;
     Expr *left, *right; // left will be NULL if unary
+    Expr *folded;       // set when checked, if the operands are constants
+
+          // The type of the result for operands of type ltype and rtype
+          // (NULL for one not there), or NULL if op does not apply to them
+    Type* OperationType(Type *ltype, Type *rtype);
+
+          // The constant this gives, or NULL if it has to be worked out
+          // at run time
+    Expr* FoldConstants();
 
   public:
     CompoundExpr(Expr *lhs, Operator *op, Expr *rhs); // for binary
@@ -140,8 +203,11 @@ class CompoundExpr : public Expr
     CompoundExpr(Expr *lhs, Operator *op);             // for postfix
 
 
-    virtual void ScopeBuilder(Scope *parent);
-    virtual void Check();
+    virtual void ScopeBuilder(Scope *parent, TreeWalk *w);
+    virtual void TypeOperands(TreeWalk *w);
+    virtual Type* WorkOutType();
+    virtual bool CheckStep(int step, TreeWalk *w);
+    Expr* Folded() { return folded ? folded : this; }
 };
 
 
@@ -151,8 +217,7 @@ class PostfixExpr : public CompoundExpr
     PostfixExpr(Expr *lhs, Operator *op) : CompoundExpr(lhs,op) {}
 
 
-    Type* ObtainType();
-    void Check();
+    int Save(AstWriter *w);
 };
 
 
@@ -163,8 +228,7 @@ class ArithmeticExpr : public CompoundExpr
     ArithmeticExpr(Operator *op, Expr *rhs) : CompoundExpr(op,rhs) {}
 
 
-    Type* ObtainType();
-    void Check();
+    int Save(AstWriter *w);
 };
 
 
@@ -174,8 +238,7 @@ class RelationalExpr : public CompoundExpr
     RelationalExpr(Expr *lhs, Operator *op, Expr *rhs) : CompoundExpr(lhs,op,rhs) {}
 
 
-    Type* ObtainType();
-    void Check();
+    int Save(AstWriter *w);
 };
 
 
@@ -186,8 +249,7 @@ class EqualityExpr : public CompoundExpr
     const char *GetPrintNameForNode() { return "EqualityExpr"; }
 
 
-    Type* ObtainType();
-    void Check();
+    int Save(AstWriter *w);
 };
 
 
@@ -199,8 +261,7 @@ class LogicalExpr : public CompoundExpr
     const char *GetPrintNameForNode() { return "LogicalExpr"; }
 
 
-    Type* ObtainType();
-    void Check();
+    int Save(AstWriter *w);
 };
 
 
@@ -211,8 +272,9 @@ class AssignExpr : public CompoundExpr
     const char *GetPrintNameForNode() { return "AssignExpr"; }
 
 
-    Type* ObtainType();
-    void Check();
+    Type* WorkOutType();
+    bool CheckStep(int step, TreeWalk *w);
+    int Save(AstWriter *w);
 };
 
 
@@ -229,8 +291,9 @@ class This : public Expr
     This(yyltype loc) : Expr(loc) {}
 
 
-    Type* ObtainType();
-    void Check();
+    Type* WorkOutType();
+    bool CheckStep(int step, TreeWalk *w);
+    int Save(AstWriter *w);
 };
 
 
@@ -243,9 +306,11 @@ class ArrayAccess : public LValue
   public:
     ArrayAccess(yyltype loc, Expr *base, Expr *subscript);
 
-    Type* ObtainType();
-    void ScopeBuilder(Scope *parent);
-    void Check();
+    void TypeOperands(TreeWalk *w);
+    Type* WorkOutType();
+    void ScopeBuilder(Scope *parent, TreeWalk *w);
+    bool CheckStep(int step, TreeWalk *w);
+    int Save(AstWriter *w);
 };
 
 
@@ -265,9 +330,11 @@ class FieldAccess : public LValue
   public:
     FieldAccess(Expr *base, Identifier *field); //ok to pass NULL base
 
-    Type* ObtainType();
-    void ScopeBuilder(Scope *parent);
-    void Check();
+    void TypeOperands(TreeWalk *w);
+    Type* WorkOutType();
+    void ScopeBuilder(Scope *parent, TreeWalk *w);
+    bool CheckStep(int step, TreeWalk *w);
+    int Save(AstWriter *w);
 };
 
 /* Like field access, call is used both for qualified base.field()
@@ -287,9 +354,11 @@ class Call : public Expr
   public:
     Call(yyltype loc, Expr *base, Identifier *field, List<Expr*> *args);
 
-    Type* ObtainType();
-    void ScopeBuilder(Scope *parent);
-    void Check();
+    void TypeOperands(TreeWalk *w);
+    Type* WorkOutType();
+    void ScopeBuilder(Scope *parent, TreeWalk *w);
+    bool CheckStep(int step, TreeWalk *w);
+    int Save(AstWriter *w);
 
 
   private:
@@ -306,8 +375,9 @@ class NewExpr : public Expr
     NewExpr(yyltype loc, NamedType *clsType);
 
 
-    Type* ObtainType();
-    void Check();
+    Type* WorkOutType();
+    bool CheckStep(int step, TreeWalk *w);
+    int Save(AstWriter *w);
 };
 
 
@@ -316,14 +386,15 @@ class NewArrayExpr : public Expr
   protected:
     Expr *size;
     Type *elemType;
-
+    ArrayType *arrayType;       // built once, see Program::CheckInParallel
 
   public:
     NewArrayExpr(yyltype loc, Expr *sizeExpr, Type *elemType);
 
-    Type* ObtainType();
-    void ScopeBuilder(Scope *parent);
-    void Check();
+    Type* WorkOutType();
+    void ScopeBuilder(Scope *parent, TreeWalk *w);
+    bool CheckStep(int step, TreeWalk *w);
+    int Save(AstWriter *w);
 };
 
 
@@ -333,8 +404,8 @@ class ReadIntegerExpr : public Expr
     ReadIntegerExpr(yyltype loc) : Expr(loc) {}
 
 
-    Type* ObtainType();
-    void Check() {}
+    Type* WorkOutType();
+    int Save(AstWriter *w);
 };
 
 
@@ -344,8 +415,8 @@ class ReadLineExpr : public Expr
     ReadLineExpr(yyltype loc) : Expr (loc) {}
 
 
-    Type* ObtainType();
-    void Check() {}
+    Type* WorkOutType();
+    int Save(AstWriter *w);
 };
 
 
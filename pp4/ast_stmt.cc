@@ -7,7 +7,11 @@
 #include "ast_decl.h"
 #include "ast_expr.h"
 #include "errors.h"
+#include "astcache.h"
 #include "ast_type.h"
+#include "workpool.h"
+#include "walk.h"
+#include <atomic>
 
 
 
@@ -38,8 +42,53 @@ void Program::Check() {
 
     ScopeBuilder();
 
+    const char *jobs = GetOption("j");
+    if (jobs && atoi(jobs) > 1) {
+        CheckInParallel(atoi(jobs));
+        return;
+    }
+
+    for (int i = 0, n = decls->NumElements(); i < n && !ReportError::LimitReached(); ++i)
+        CheckTree(decls->Nth(i));
+}
+
+
+/* Each declaration is checked with its errors kept in a buffer of its own.
+ * Once one has as many as are kept, none of the errors of those after it
+ * can be, and they are not checked. */
+struct DeclChecks {
+    List<Decl*> *decls;
+    DiagnosticBuffer *found;
+    std::atomic<int> firstFull;
+};
+
+static void CheckDecl(int index, void *data) {
+    DeclChecks *checks = (DeclChecks *)data;
+    if (index > checks->firstFull)
+        return;
+    ReportError::RecordTo(&checks->found[index]);
+    CheckTree(checks->decls->Nth(index));
+    ReportError::RecordTo(NULL);
+
+    int first = checks->firstFull;
+    while (checks->found[index].Full() && index < first &&
+           !checks->firstFull.compare_exchange_weak(first, index))
+        ;
+}
+
+
+/* Once the scopes are built, checking a declaration only looks things
+ * up in them and in its own subtree, so the declarations can be checked
+ * at the same time. Their errors are then reported in their order. */
+void Program::CheckInParallel(int numThreads) {
+    DeclChecks checks;
+    checks.decls = decls;
+    checks.found = new DiagnosticBuffer[decls->NumElements()];
+    checks.firstFull = decls->NumElements();
+    RunTasks(decls->NumElements(), numThreads, CheckDecl, &checks);
     for (int i = 0, n = decls->NumElements(); i < n; ++i)
-        decls->Nth(i)->Check();
+        ReportError::AddAll(&checks.found[i]);
+    delete[] checks.found;
 }
 
 
@@ -50,15 +99,25 @@ void Program::ScopeBuilder() {
 
 
     for (int i = 0, n = decls->NumElements(); i < n; ++i)
-        decls->Nth(i)->ScopeBuilder(gScope);
+        BuildScopes(decls->Nth(i), gScope);
 }
 
 
-void Stmt::ScopeBuilder(Scope *parent) {
+void Stmt::ScopeBuilder(Scope *parent, TreeWalk *w) {
     scope->SetParent(parent);
 }
 
 
+Expr* Stmt::FoldedChild(Expr *e) {
+    Expr *f = e->Folded();
+    if (f != e) {
+        f->SetParent(this);
+        BuildScopes(f, scope);
+    }
+    return f;
+}
+
+
 StmtBlock::StmtBlock(List<VarDecl*> *d, List<Stmt*> *s) {
     Assert(d != NULL && s != NULL);
     (decls=d)->SetParentAll(this);
@@ -66,7 +125,7 @@ StmtBlock::StmtBlock(List<VarDecl*> *d, List<Stmt*> *s) {
 }
 
 
-void StmtBlock::ScopeBuilder(Scope *parent) {
+void StmtBlock::ScopeBuilder(Scope *parent, TreeWalk *w) {
 
     scope->SetParent(parent);
 
@@ -75,22 +134,27 @@ void StmtBlock::ScopeBuilder(Scope *parent) {
 
 
     for (int i = 0, n = decls->NumElements(); i < n; ++i)
-        decls->Nth(i)->ScopeBuilder(scope);
+        w->BuildScope(decls->Nth(i), scope);
 
 
     for (int i = 0, n = stmts->NumElements(); i < n; ++i)
-        stmts->Nth(i)->ScopeBuilder(scope);
+        w->BuildScope(stmts->Nth(i), scope);
 }
 
 
-void StmtBlock::Check() {
-
-    for (int i = 0, n = decls->NumElements(); i < n; ++i)
-        decls->Nth(i)->Check();
+/* The declarations first, then one statement a step. */
+bool StmtBlock::CheckStep(int step, TreeWalk *w) {
 
+    if (step == 0) {
+        for (int i = 0, n = decls->NumElements(); i < n; ++i)
+            w->Check(decls->Nth(i));
+        return true;
+    }
 
-    for (int i = 0, n = stmts->NumElements(); i < n; ++i)
-        stmts->Nth(i)->Check();
+    if (step > stmts->NumElements() || ReportError::LimitReached())
+        return false;
+    w->Check(stmts->Nth(step - 1));
+    return true;
 }
 
 
@@ -101,33 +165,38 @@ ConditionalStmt::ConditionalStmt(Expr *t, Stmt *b) {
 }
 
 
-void ConditionalStmt::ScopeBuilder(Scope *parent) {
+void ConditionalStmt::ScopeBuilder(Scope *parent, TreeWalk *w) {
 
     scope->SetParent(parent);
 
-    test->ScopeBuilder(scope);
-    body->ScopeBuilder(scope);
+    w->BuildScope(test, scope);
+    w->BuildScope(body, scope);
 }
 
 
-void ConditionalStmt::Check() {
+bool ConditionalStmt::CheckStep(int step, TreeWalk *w) {
 
-    test->Check();
-    body->Check();
+    if (step == 0) {
+        w->Check(test);
+        w->Check(body);
+        return true;
+    }
 
+    test = FoldedChild(test);
     if (!test->ObtainType()->Equivalent(Type::boolType))
         ReportError::TestNotBoolean(test);
+    return false;
 }
 
 
 //we add Loop statement
-void LoopStmt::ScopeBuilder(Scope *parent) {
+void LoopStmt::ScopeBuilder(Scope *parent, TreeWalk *w) {
 
     scope->SetParent(parent);
     scope->SetLoopStmt(this);
 
-    test->ScopeBuilder(scope);
-    body->ScopeBuilder(scope);
+    w->BuildScope(test, scope);
+    w->BuildScope(body, scope);
 }
 
 
@@ -145,41 +214,48 @@ IfStmt::IfStmt(Expr *t, Stmt *tb, Stmt *eb): ConditionalStmt(t, tb) {
 }
 
 
-void IfStmt::ScopeBuilder(Scope *parent) {
+void IfStmt::ScopeBuilder(Scope *parent, TreeWalk *w) {
     scope->SetParent(parent);
 
-    test->ScopeBuilder(scope);
-    body->ScopeBuilder(scope);
+    w->BuildScope(test, scope);
+    w->BuildScope(body, scope);
 
     if (elseBody != NULL)
-        elseBody->ScopeBuilder(scope);
+        w->BuildScope(elseBody, scope);
 }
 
 
-void IfStmt::Check() {
-    test->Check();
-    body->Check();
+/* The test is reported before anything in the else part. */
+bool IfStmt::CheckStep(int step, TreeWalk *w) {
+    if (step == 0) {
+        w->Check(test);
+        w->Check(body);
+        return true;
+    }
 
+    test = FoldedChild(test);
     if (!test->ObtainType()->Equivalent(Type::boolType))
         ReportError::TestNotBoolean(test);
 
     if (elseBody != NULL)
-        elseBody->Check();
+        w->Check(elseBody);
+    return false;
 }
 
 
-void BreakStmt::Check() {
+bool BreakStmt::CheckStep(int step, TreeWalk *w) {
     Scope *s = scope;
     while (s != NULL) {
         if (s->GetLoopStmt() != NULL)
-            return;
+            return false;
         if (s->GetSwitchStmt() != NULL)
-            return;
+            return false;
 
         s = s->GetParent();
     }
 
     ReportError::BreakOutsideLoop(this);
+    return false;
 }
 
 
@@ -189,15 +265,19 @@ ReturnStmt::ReturnStmt(yyltype loc, Expr *e) : Stmt(loc) {
 }
 
 
-void ReturnStmt::ScopeBuilder(Scope *parent) {
+void ReturnStmt::ScopeBuilder(Scope *parent, TreeWalk *w) {
     scope->SetParent(parent);
 
-    expr->ScopeBuilder(scope);
+    w->BuildScope(expr, scope);
 }
 
 
-void ReturnStmt::Check() {
-    expr->Check();
+bool ReturnStmt::CheckStep(int step, TreeWalk *w) {
+    if (step == 0) {
+        w->Check(expr);
+        return true;
+    }
+    expr = FoldedChild(expr);
 
     FnDecl *d = NULL;
     Scope *s = scope;
@@ -211,7 +291,7 @@ void ReturnStmt::Check() {
     if (d == NULL) {
         ReportError::Formatted(location,
                                "return is only allowed inside a function");
-        return;
+        return false;
     }
 
     Type *expected = d->GetReturnType();
@@ -224,6 +304,7 @@ void ReturnStmt::Check() {
     if (ee != NULL && expected != Type::voidType)
     //if (given == Type::errorType)
         ReportError::ReturnMismatch(this, Type::voidType, expected);
+    return false;
 }
 
 
@@ -233,15 +314,22 @@ PrintStmt::PrintStmt(List<Expr*> *a) {
 }
 
 
-void PrintStmt::ScopeBuilder(Scope *parent) {
+void PrintStmt::ScopeBuilder(Scope *parent, TreeWalk *w) {
     scope->SetParent(parent);
 
     for (int i = 0, n = args->NumElements(); i < n; ++i)
-        args->Nth(i)->ScopeBuilder(scope);
+        w->BuildScope(args->Nth(i), scope);
 }
 
 
-void PrintStmt::Check() {
+/* The types of the arguments are reported before what is in them. */
+bool PrintStmt::CheckStep(int step, TreeWalk *w) {
+    if (step == 1) {
+        for (int i = 0, n = args->NumElements(); i < n; ++i)
+            args->SetNth(FoldedChild(args->Nth(i)), i);
+        return false;
+    }
+
     for (int i = 0, n = args->NumElements(); i < n; ++i) {
         Type *given = args->Nth(i)->ObtainType();
 
@@ -252,7 +340,8 @@ void PrintStmt::Check() {
     }
 
     for (int i = 0, n = args->NumElements(); i < n; ++i)
-        args->Nth(i)->Check();
+        w->Check(args->Nth(i));
+    return true;
 }
 
 
@@ -263,20 +352,26 @@ SwitchStmt::SwitchStmt(Expr *e, List<CaseStmt*> *s) {
 }
 
 
-void SwitchStmt::ScopeBuilder(Scope *parent) {
+void SwitchStmt::ScopeBuilder(Scope *parent, TreeWalk *w) {
     scope->SetParent(parent);
     scope->SetSwitchStmt(this);
 
-    expr->ScopeBuilder(scope);
+    w->BuildScope(expr, scope);
     for (int i = 0, n = caseStmts->NumElements(); i < n; ++i)
-        caseStmts->Nth(i)->ScopeBuilder(scope);
+        w->BuildScope(caseStmts->Nth(i), scope);
 }
 
 
-void SwitchStmt::Check() {
-    expr->Check();
-    for (int i = 0, n = caseStmts->NumElements(); i < n; ++i)
-        caseStmts->Nth(i)->Check();
+bool SwitchStmt::CheckStep(int step, TreeWalk *w) {
+    if (step == 0) {
+        w->Check(expr);
+        for (int i = 0, n = caseStmts->NumElements(); i < n; ++i)
+            w->Check(caseStmts->Nth(i));
+        return true;
+    }
+
+    expr = FoldedChild(expr);
+    return false;
 }
 
 
@@ -286,12 +381,14 @@ SwitchStmt::CaseStmt::CaseStmt(Expr *e, List<Stmt*> *s) {
     intConst=e;
     if (intConst != NULL)
         intConst->SetParent(this);
+    constantLabel = false;
+    labelValue = 0;
 
     (caseBody=s)->SetParentAll(this);
 }
 
 
-void SwitchStmt::CaseStmt::ScopeBuilder(Scope *parent) {
+void SwitchStmt::CaseStmt::ScopeBuilder(Scope *parent, TreeWalk *w) {
     scope->SetParent(parent);
 
     // enforced by bison
@@ -300,17 +397,76 @@ void SwitchStmt::CaseStmt::ScopeBuilder(Scope *parent) {
         intConst->ScopeBuilder(scope);
     */
     for (int i = 0, n = caseBody->NumElements(); i < n; ++i)
-        caseBody->Nth(i)->ScopeBuilder(scope);
+        w->BuildScope(caseBody->Nth(i), scope);
 }
 
 
-void SwitchStmt::CaseStmt::Check() {
+bool SwitchStmt::CaseStmt::CheckStep(int step, TreeWalk *w) {
     // enforced by bison
     /*
     if ( intConst != NULL)
         if (!intConst->ObtainType()->Equivalent(Type::intType))
             ReportError::SwitchCaseExprNotInteger(intConst);
     */
+    IntConstant *label = dynamic_cast<IntConstant*>(intConst);
+    if (label != NULL) {
+        constantLabel = true;
+        labelValue = label->GetValue();
+    }
+
     for (int i = 0, n = caseBody->NumElements(); i < n; ++i)
-        caseBody->Nth(i)->Check();
+        w->Check(caseBody->Nth(i));
+    return false;
+}
+
+
+/* A program is saved as the list of its declarations. */
+int Program::Save(AstWriter *w) {
+    return w->SaveList(decls);
+}
+
+
+int StmtBlock::Save(AstWriter *w) {
+    return w->Add(AstWriter::StmtBlockNode, NULL, w->SaveList(decls), w->SaveList(stmts));
+}
+
+
+int ForStmt::Save(AstWriter *w) {
+    return w->Add(AstWriter::ForStmtNode, NULL, w->Save(init), w->Save(test),
+                  w->Save(step), w->Save(body));
+}
+
+
+int WhileStmt::Save(AstWriter *w) {
+    return w->Add(AstWriter::WhileStmtNode, NULL, w->Save(test), w->Save(body));
+}
+
+
+int IfStmt::Save(AstWriter *w) {
+    return w->Add(AstWriter::IfStmtNode, NULL, w->Save(test), w->Save(body), w->Save(elseBody));
+}
+
+
+int BreakStmt::Save(AstWriter *w) {
+    return w->Add(AstWriter::BreakStmtNode, location);
+}
+
+
+int ReturnStmt::Save(AstWriter *w) {
+    return w->Add(AstWriter::ReturnStmtNode, location, w->Save(expr));
+}
+
+
+int PrintStmt::Save(AstWriter *w) {
+    return w->Add(AstWriter::PrintStmtNode, NULL, w->SaveList(args));
+}
+
+
+int SwitchStmt::Save(AstWriter *w) {
+    return w->Add(AstWriter::SwitchStmtNode, NULL, w->Save(expr), w->SaveList(caseStmts));
+}
+
+
+int SwitchStmt::CaseStmt::Save(AstWriter *w) {
+    return w->Add(AstWriter::CaseStmtNode, NULL, w->Save(intConst), w->SaveList(caseBody));
 }
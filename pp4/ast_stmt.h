@@ -30,7 +30,7 @@ class SwitchStmt;
 //we define the class Scope
 
 
-class Scope
+class Scope : public ArenaAllocated
 {
 
   private:
@@ -45,8 +45,8 @@ class Scope
 
 
   public:
-    Scope() : table(new Hashtable<Decl*>), classDecl(NULL), loopStmt(NULL),
-              fnDecl(NULL) {}
+    Scope() : parent(NULL), table(new Hashtable<Decl*>), classDecl(NULL),
+              loopStmt(NULL), switchStmt(NULL), fnDecl(NULL) {}
 
     void SetParent(Scope *p) { parent = p; }
     Scope* GetParent() { return parent; }
@@ -79,9 +79,11 @@ class Program : public Node
      static Scope *gScope;
      Program(List<Decl*> *declList);
      void Check();
+     void ScopeBuilder();
+     int Save(AstWriter *w);
 
   private:
-     void ScopeBuilder();
+     void CheckInParallel(int numThreads); // with -j=N
 };
 
 
@@ -94,8 +96,13 @@ class Stmt : public Node
   public:
      Stmt() : Node(), scope(new Scope) {}
      Stmt(yyltype loc) : Node(loc), scope(new Scope) {}
-     virtual void ScopeBuilder(Scope *parent);
-     virtual void Check() = 0;
+     virtual void ScopeBuilder(Scope *parent, TreeWalk *w);
+
+  protected:
+          // What is to take the place of e, a child of this that has
+          // been checked: the constant it folded to if it did (see
+          // ast_expr.h)
+     Expr* FoldedChild(Expr *e);
 };
 
 
@@ -108,8 +115,9 @@ class StmtBlock : public Stmt
 
   public:
     StmtBlock(List<VarDecl*> *variableDeclarations, List<Stmt*> *statements);
-    void ScopeBuilder(Scope *parent);
-    void Check();
+    void ScopeBuilder(Scope *parent, TreeWalk *w);
+    bool CheckStep(int step, TreeWalk *w);
+    int Save(AstWriter *w);
 };
 
 
@@ -121,8 +129,8 @@ class ConditionalStmt : public Stmt
 
   public:
     ConditionalStmt(Expr *testExpr, Stmt *body);
-    virtual void ScopeBuilder(Scope *parent);
-    virtual void Check();
+    virtual void ScopeBuilder(Scope *parent, TreeWalk *w);
+    virtual bool CheckStep(int step, TreeWalk *w);
 };
 
 
@@ -131,7 +139,7 @@ class LoopStmt : public ConditionalStmt
   public:
     LoopStmt(Expr *testExpr, Stmt *body)
             : ConditionalStmt(testExpr, body) {}
-    virtual void ScopeBuilder(Scope *parent);
+    virtual void ScopeBuilder(Scope *parent, TreeWalk *w);
 };
 
 
@@ -142,6 +150,7 @@ class ForStmt : public LoopStmt
 
   public:
     ForStmt(Expr *init, Expr *test, Expr *step, Stmt *body);
+    int Save(AstWriter *w);
 };
 
 
@@ -149,6 +158,7 @@ class WhileStmt : public LoopStmt
 {
   public:
     WhileStmt(Expr *test, Stmt *body) : LoopStmt(test, body) {}
+    int Save(AstWriter *w);
 };
 
 
@@ -159,8 +169,9 @@ class IfStmt : public ConditionalStmt
 
   public:
     IfStmt(Expr *test, Stmt *thenBody, Stmt *elseBody);
-    void ScopeBuilder(Scope *parent);
-    void Check();
+    void ScopeBuilder(Scope *parent, TreeWalk *w);
+    bool CheckStep(int step, TreeWalk *w);
+    int Save(AstWriter *w);
 };
 
 
@@ -168,7 +179,8 @@ class BreakStmt : public Stmt
 {
   public:
     BreakStmt(yyltype loc) : Stmt(loc) {}
-    void Check();
+    bool CheckStep(int step, TreeWalk *w);
+    int Save(AstWriter *w);
 };
 
 
@@ -179,8 +191,9 @@ class ReturnStmt : public Stmt
 
   public:
     ReturnStmt(yyltype loc, Expr *expr);
-    void ScopeBuilder(Scope *parent);
-    void Check();
+    void ScopeBuilder(Scope *parent, TreeWalk *w);
+    bool CheckStep(int step, TreeWalk *w);
+    int Save(AstWriter *w);
 };
 
 
@@ -191,8 +204,9 @@ class PrintStmt : public Stmt
 
   public:
     PrintStmt(List<Expr*> *arguments);
-    void ScopeBuilder(Scope *parent);
-    void Check();
+    void ScopeBuilder(Scope *parent, TreeWalk *w);
+    bool CheckStep(int step, TreeWalk *w);
+    int Save(AstWriter *w);
 };
 
 
@@ -204,11 +218,16 @@ class SwitchStmt : public Stmt
       protected:
         Expr *intConst;
         List<Stmt*> *caseBody;
+        bool constantLabel;     // set when checked, if the label is a constant
+        int labelValue;         // which is this
 
       public:
         CaseStmt(Expr *intConst, List<Stmt*> *caseBody);
-        void ScopeBuilder(Scope *parent);
-        void Check();
+        void ScopeBuilder(Scope *parent, TreeWalk *w);
+        bool CheckStep(int step, TreeWalk *w);
+        bool HasConstantLabel() { return constantLabel; }
+        int GetLabelValue() { return labelValue; }
+        int Save(AstWriter *w);
     };
 
   protected:
@@ -217,8 +236,9 @@ class SwitchStmt : public Stmt
 
   public:
     SwitchStmt(Expr *expr, List<CaseStmt*> *caseStmts);
-    void ScopeBuilder(Scope *parent);
-    void Check();
+    void ScopeBuilder(Scope *parent, TreeWalk *w);
+    bool CheckStep(int step, TreeWalk *w);
+    int Save(AstWriter *w);
 };
 
 
@@ -4,6 +4,7 @@
  */
 #include "ast_type.h"
 #include "ast_decl.h"
+#include "astcache.h"
 #include <string.h>
 
 
@@ -16,17 +17,17 @@
  */
 
 
-Type *Type::intType    = new Type("int");
-Type *Type::doubleType = new Type("double");
-Type *Type::voidType   = new Type("void");
-Type *Type::boolType   = new Type("bool");
-Type *Type::nullType   = new Type("null");
-Type *Type::stringType = new Type("string");
-Type *Type::errorType  = new Type("error");
+Type *Type::intType    = new Type("int", IntKind);
+Type *Type::doubleType = new Type("double", DoubleKind);
+Type *Type::voidType   = new Type("void", VoidKind);
+Type *Type::boolType   = new Type("bool", BoolKind);
+Type *Type::nullType   = new Type("null", NullKind);
+Type *Type::stringType = new Type("string", StringKind);
+Type *Type::errorType  = new Type("error", ErrorKind);
 
 
 
-Type::Type(const char *n) {
+Type::Type(const char *n, TypeKind k) : kind(k) {
     Assert(n);
     typeName = strdup(n);
     typeDeclared = true;
@@ -45,7 +46,7 @@ bool Type::Equivalent(Type *other) {
 }
 
 
-NamedType::NamedType(Identifier *i) : Type(*i->GetLocation()) {
+NamedType::NamedType(Identifier *i) : Type(*i->GetLocation(), NamedKind) {
     Assert(i != NULL);
     (id=i)->SetParent(this);
     typeDeclared = true;
@@ -97,16 +98,17 @@ bool NamedType::Equivalent(Type *other) {
 }
 
 
-ArrayType::ArrayType(yyltype loc, Type *et) : Type(loc) {
+ArrayType::ArrayType(yyltype loc, Type *et) : Type(loc, ArrayKind) {
     Assert(et != NULL);
     (elemType=et)->SetParent(this);
     typeDeclared = true;
 }
 
 
-ArrayType::ArrayType(Type *et) : Type() {
+ArrayType::ArrayType(Type *et) : Type(ArrayKind) {
     Assert(et != NULL);
     (elemType=et)->SetParent(this);
+    typeDeclared = true;
 }
 
 
@@ -133,3 +135,19 @@ bool ArrayType::Equivalent(Type *other) {
 
     return elemType->Equivalent(arrayOther->elemType);
 }
+
+
+/* The builtin types are saved by number, not as nodes of their own. */
+int Type::Save(AstWriter *w) {
+    return w->Add(AstWriter::BuiltinTypeNode, NULL, w->Builtin(this));
+}
+
+
+int NamedType::Save(AstWriter *w) {
+    return w->Add(AstWriter::NamedTypeNode, NULL, w->Save(id));
+}
+
+
+int ArrayType::Save(AstWriter *w) {
+    return w->Add(AstWriter::ArrayTypeNode, location, w->Save(elemType));
+}
@@ -18,10 +18,21 @@
 #include "errors.h"
 
 
+/* What the typing of operators goes by (see ast_expr.cc): one kind for
+ * each builtin type, and one for named and one for array types, which
+ * take more than their kind to tell apart. */
+typedef enum {
+    IntKind, DoubleKind, BoolKind, StringKind, NullKind, VoidKind,
+    ErrorKind, NamedKind, ArrayKind,
+    NumTypeKinds
+} TypeKind;
+
+
 class Type : public Node
 {
   protected:
     char *typeName;
+    TypeKind kind;
 
   public :
     static Type *intType, *doubleType, *boolType, *voidType,
@@ -29,9 +40,9 @@ class Type : public Node
 
 //declare variables
     bool typeDeclared;
-    Type(yyltype loc) : Node(loc) {}
-    Type() : Node() {}
-    Type(const char *str);
+    Type(yyltype loc, TypeKind k) : Node(loc), kind(k) {}
+    Type(TypeKind k) : Node(), kind(k) {}
+    Type(const char *str, TypeKind k);
 
     virtual void PrintToStream(std::ostream& out) { out << typeName; }
     friend std::ostream& operator<<(std::ostream& out, Type *t) { t->PrintToStream(out); return out; }
@@ -40,7 +51,16 @@ class Type : public Node
     virtual void ReportNotDeclaredID(reasonT reason) { return; }
 
     virtual const char* Name() { return typeName; }
+    TypeKind GetKind() { return kind; }
+
+          // The builtin types are shared by every node that uses them
+          // (and by declarations parsed on different threads, see
+          // declparse.h), so they are given no parent. This hides
+          // Node::SetParent for every caller that holds a Type.
+    bool IsBuiltin() { return kind < NamedKind; }
+    void SetParent(Node *p) { if (!IsBuiltin()) Node::SetParent(p); }
     virtual bool IsPrimitive() { return true; }
+    virtual int Save(AstWriter *w);
 };
 
 
@@ -61,6 +81,7 @@ class NamedType : public Type
     const char* Name() { return id->Name(); }
     bool IsPrimitive() { return false; }
     Identifier* GetId() { return id; }
+    int Save(AstWriter *w);
 };
 
 
@@ -84,6 +105,7 @@ class ArrayType : public Type
     bool IsPrimitive() { return false; }
 
     Type* GetElemType() { return elemType; }
+    int Save(AstWriter *w);
 };
 
 
@@ -0,0 +1,453 @@
+/* File: astcache.cc
+ * -----------------
+ * Implementation of the AST cache: writing the records, and reading
+ * them back from a mapped file.
+ */
+
+#include "astcache.h"
+#include <errno.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "ast_decl.h"
+#include "ast_expr.h"
+#include "ast_stmt.h"
+#include "ast_type.h"
+#include "dscanner.h"
+#include "declparse.h" // for DeclRange
+#include "pushparse.h"
+#include "errors.h"
+#include "utility.h" // for PrintDebug(), Fnv1a(), ReplaceFile()
+
+
+/* The builtin types, in the order of their numbers in the cache */
+static Type **Builtins(int *count)
+{
+    static Type **types[] = { &Type::intType, &Type::doubleType, &Type::boolType,
+                              &Type::voidType, &Type::nullType, &Type::stringType,
+                              &Type::errorType };
+    static Type *builtins[sizeof(types)/sizeof(types[0])];
+    *count = sizeof(types)/sizeof(types[0]);
+    for (int i = 0; i < *count; i++)
+        builtins[i] = *types[i];
+    return builtins;
+}
+
+
+/* Writing
+ * -------
+ */
+int AstWriter::Add(NodeKind kind, yyltype *loc, int a, int b, int c, int d)
+{
+    Record r = { (uint32_t)kind, 0, { a, b, c, d } };
+    if (loc) {
+        int numbers[4] = { loc->first_line, loc->first_column, loc->last_line, loc->last_column };
+        locations.insert(locations.end(), numbers, numbers + 4);
+        r.location = locations.size() / 4;
+    }
+    nodes.push_back(r);
+    return nodes.size();
+}
+
+
+int AstWriter::AddList(const std::vector<int> &elems)
+{
+    lists.push_back(items.size());
+    lists.push_back(elems.size());
+    items.insert(items.end(), elems.begin(), elems.end());
+    return lists.size() / 2;
+}
+
+
+int AstWriter::Save(Node *node)
+{
+    if (!node)
+        return 0;
+    if (depth == MaxDepth) {
+        tooDeep = true;
+        return 0;
+    }
+    depth++;
+    int n = node->Save(this);
+    depth--;
+    return n;
+}
+
+
+int AstWriter::Name(const char *name)
+{
+    return identifierNames.Intern(name, strlen(name))->index + 1;
+}
+
+
+int AstWriter::Literal(const PooledString *literal)
+{
+    return literal->index + 1;
+}
+
+
+int AstWriter::Builtin(Type *type)
+{
+    int count;
+    Type **builtins = Builtins(&count);
+    for (int i = 0; i < count; i++)
+        if (builtins[i] == type) return i;
+    Failure("Cannot save a type made outside the parser");
+    return 0;
+}
+
+
+/* The entries of pool as offsets, one past the last too, followed by the
+ * chars, padded to a multiple of 4 bytes. */
+static void AppendPool(std::vector<char> *out, StringPool *pool, uint32_t *size)
+{
+    int n = pool->NumEntries();
+    std::vector<uint32_t> offsets;
+    std::vector<char> chars;
+    for (int i = 0; i < n; i++) {
+        const PooledString *s = pool->Nth(i);
+        offsets.push_back(chars.size());
+        chars.insert(chars.end(), s->chars, s->chars + s->length + 1);
+    }
+    offsets.push_back(chars.size());
+    while (chars.size() % 4) chars.push_back('\0');
+    out->insert(out->end(), (char *)offsets.data(), (char *)(offsets.data() + offsets.size()));
+    out->insert(out->end(), chars.begin(), chars.end());
+    *size = chars.size();
+}
+
+
+template <class T> static void Append(std::vector<char> *out, const std::vector<T> &v)
+{
+    out->insert(out->end(), (char *)v.data(), (char *)(v.data() + v.size()));
+}
+
+
+/* Method: WriteFile
+ * -----------------
+ * Written with ReplaceFile(), so a reader never sees half of the file.
+ */
+bool AstWriter::WriteFile(const char *path, uint64_t sourceHash, int sourceLength,
+                          int program, uint32_t parseMicros)
+{
+    AstCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "DAST", 4);
+    header.version = AstCacheVersion;
+    header.sourceHash = sourceHash;
+    header.sourceLength = sourceLength;
+    header.parseMicros = parseMicros;
+    header.numNodes = nodes.size();
+    header.numLists = lists.size() / 2;
+    header.numItems = items.size();
+    header.numLocations = locations.size() / 4;
+    header.numNames = identifierNames.NumEntries();
+    header.numLiterals = stringLiterals.NumEntries();
+    header.program = program;
+
+    std::vector<char> body;
+    Append(&body, nodes);
+    Append(&body, lists);
+    Append(&body, items);
+    Append(&body, locations);
+    AppendPool(&body, &identifierNames, &header.namesSize);
+    AppendPool(&body, &stringLiterals, &header.literalsSize);
+    header.checksum = Fnv1a(body.data(), body.size());
+
+    const void *parts[] = { &header, body.data() };
+    size_t sizes[] = { sizeof(header), body.size() };
+    return ReplaceFile(path, 2, parts, sizes);
+}
+
+
+/* Reading
+ * -------
+ * The sections of the mapped file, and the pool entries for its names.
+ */
+static const AstCacheHeader *header;
+static size_t mappedSize;
+static const AstWriter::Record *nodes;
+static const uint32_t *lists, *items;
+static const int32_t *locations;
+static const PooledString **names, **literals;
+
+
+/* Checks the offsets of a pool section and interns its entries. Returns
+ * the end of the section, NULL if the offsets are off. */
+static const char *InternPool(const char *p, const char *end, int count, uint32_t size,
+                              StringPool *pool, const PooledString ***entries)
+{
+    const uint32_t *offsets = (const uint32_t *)p;
+    const char *chars = p + 4 * (count + 1);
+    if (chars + size > end || offsets[count] > size) return NULL;
+    *entries = new const PooledString*[count + 1];
+    for (int i = 0; i < count; i++) {
+        if (offsets[i] >= offsets[i+1]) return NULL;
+        (*entries)[i + 1] = pool->Intern(chars + offsets[i], offsets[i+1] - offsets[i] - 1);
+    }
+    return chars + size;
+}
+
+
+/* Function: OpenCache
+ * -------------------
+ * Maps the file at path and sets up the sections, if it is a cache file
+ * of this version for a source with this hash and length and it is
+ * intact. The node records are only checked as a whole, against the
+ * checksum, they are trusted after that.
+ */
+static bool OpenCache(const char *path, uint64_t hash, int length)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    void *map = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(AstCacheHeader))
+        map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return false;
+
+    header = (const AstCacheHeader *)map;
+    mappedSize = st.st_size;
+    const char *p = (const char *)(header + 1), *end = (const char *)map + mappedSize;
+    bool ok = (memcmp(header->magic, "DAST", 4) == 0 && header->version == AstCacheVersion &&
+               header->sourceHash == hash && header->sourceLength == (uint32_t)length &&
+               header->checksum == Fnv1a(p, end - p));
+    if (ok) {
+        nodes = (const AstWriter::Record *)p;
+        lists = (const uint32_t *)(nodes + header->numNodes);
+        items = lists + 2 * header->numLists;
+        locations = (const int32_t *)(items + header->numItems);
+        p = (const char *)(locations + 4 * header->numLocations);
+        ok = (p <= end);
+    }
+    if (ok) p = InternPool(p, end, header->numNames, header->namesSize, &identifierNames, &names);
+    if (ok && p) p = InternPool(p, end, header->numLiterals, header->literalsSize, &stringLiterals, &literals);
+    if (!ok || p != end) {
+        munmap(map, mappedSize);
+        return false;
+    }
+    return true;
+}
+
+
+static yyltype LocationNumbered(int n)
+{
+    yyltype loc;
+    memset(&loc, 0, sizeof(loc));
+    if (n > 0) {
+        const int32_t *numbers = locations + 4 * (n - 1);
+        loc.first_line = numbers[0];
+        loc.first_column = numbers[1];
+        loc.last_line = numbers[2];
+        loc.last_column = numbers[3];
+    }
+    return loc;
+}
+
+
+static Node *Build(int n);
+
+template <class T> static T *BuildAs(int n)
+{
+    return static_cast<T*>(Build(n));
+}
+
+template <class T> static List<T*> *BuildList(int n)
+{
+    if (n == 0) return NULL;
+    const uint32_t *first = items + lists[2 * (n - 1)];
+    int count = lists[2 * (n - 1) + 1];
+    List<T*> *list = new List<T*>;
+    for (int i = 0; i < count; i++)
+        list->Append(BuildAs<T>(first[i]));
+    return list;
+}
+
+
+/* Function: Build
+ * ---------------
+ * Makes node number n and its children with the same constructors the
+ * parser uses (see parser.y), so they come out as they were parsed.
+ */
+static Node *Build(int n)
+{
+    if (n == 0) return NULL;
+    const AstWriter::Record &r = nodes[n - 1];
+    const int32_t *f = r.fields;
+    yyltype loc = LocationNumbered(r.location);
+
+    switch (r.kind) {
+      case AstWriter::IdentifierNode:
+        return new Identifier(loc, names[f[0]]);
+      case AstWriter::OperatorNode:
+        return new Operator(loc, (OpCode)f[0]);
+      case AstWriter::BuiltinTypeNode: {
+        int count;
+        return Builtins(&count)[f[0]];
+      }
+      case AstWriter::NamedTypeNode:
+        return new NamedType(BuildAs<Identifier>(f[0]));
+      case AstWriter::ArrayTypeNode:
+        if (r.location == 0) return new ArrayType(BuildAs<Type>(f[0]));
+        return new ArrayType(loc, BuildAs<Type>(f[0]));
+
+      case AstWriter::VarDeclNode:
+        return new VarDecl(BuildAs<Identifier>(f[0]), BuildAs<Type>(f[1]));
+      case AstWriter::ClassDeclNode:
+        return new ClassDecl(BuildAs<Identifier>(f[0]), BuildAs<NamedType>(f[1]),
+                             BuildList<NamedType>(f[2]), BuildList<Decl>(f[3]));
+      case AstWriter::InterfaceDeclNode:
+        return new InterfaceDecl(BuildAs<Identifier>(f[0]), BuildList<Decl>(f[1]));
+      case AstWriter::FnDeclNode: {
+        FnDecl *fn = new FnDecl(BuildAs<Identifier>(f[0]), BuildAs<Type>(f[1]),
+                                BuildList<VarDecl>(f[2]));
+        if (f[3]) fn->SetFunctionBody(BuildAs<Stmt>(f[3]));
+        return fn;
+      }
+
+      case AstWriter::StmtBlockNode:
+        return new StmtBlock(BuildList<VarDecl>(f[0]), BuildList<Stmt>(f[1]));
+      case AstWriter::ForStmtNode:
+        return new ForStmt(BuildAs<Expr>(f[0]), BuildAs<Expr>(f[1]), BuildAs<Expr>(f[2]),
+                           BuildAs<Stmt>(f[3]));
+      case AstWriter::WhileStmtNode:
+        return new WhileStmt(BuildAs<Expr>(f[0]), BuildAs<Stmt>(f[1]));
+      case AstWriter::IfStmtNode:
+        return new IfStmt(BuildAs<Expr>(f[0]), BuildAs<Stmt>(f[1]), BuildAs<Stmt>(f[2]));
+      case AstWriter::BreakStmtNode:
+        return new BreakStmt(loc);
+      case AstWriter::ReturnStmtNode:
+        return new ReturnStmt(loc, BuildAs<Expr>(f[0]));
+      case AstWriter::PrintStmtNode:
+        return new PrintStmt(BuildList<Expr>(f[0]));
+      case AstWriter::SwitchStmtNode:
+        return new SwitchStmt(BuildAs<Expr>(f[0]), BuildList<SwitchStmt::CaseStmt>(f[1]));
+      case AstWriter::CaseStmtNode:
+        return new SwitchStmt::CaseStmt(BuildAs<Expr>(f[0]), BuildList<Stmt>(f[1]));
+
+      case AstWriter::EmptyExprNode:
+        return new EmptyExpr();
+      case AstWriter::IntConstantNode:
+        return new IntConstant(loc, f[0]);
+      case AstWriter::DoubleConstantNode: {
+        double value;
+        memcpy(&value, f, sizeof(value));
+        return new DoubleConstant(loc, value);
+      }
+      case AstWriter::BoolConstantNode:
+        return new BoolConstant(loc, f[0]);
+      case AstWriter::StringConstantNode:
+        return new StringConstant(loc, literals[f[0]]);
+      case AstWriter::NullConstantNode:
+        return new NullConstant(loc);
+
+      case AstWriter::PostfixExprNode:
+        return new PostfixExpr(BuildAs<Expr>(f[0]), BuildAs<Operator>(f[1]));
+      case AstWriter::ArithmeticExprNode:
+        if (f[0] == 0) return new ArithmeticExpr(BuildAs<Operator>(f[1]), BuildAs<Expr>(f[2]));
+        return new ArithmeticExpr(BuildAs<Expr>(f[0]), BuildAs<Operator>(f[1]), BuildAs<Expr>(f[2]));
+      case AstWriter::RelationalExprNode:
+        return new RelationalExpr(BuildAs<Expr>(f[0]), BuildAs<Operator>(f[1]), BuildAs<Expr>(f[2]));
+      case AstWriter::EqualityExprNode:
+        return new EqualityExpr(BuildAs<Expr>(f[0]), BuildAs<Operator>(f[1]), BuildAs<Expr>(f[2]));
+      case AstWriter::LogicalExprNode:
+        if (f[0] == 0) return new LogicalExpr(BuildAs<Operator>(f[1]), BuildAs<Expr>(f[2]));
+        return new LogicalExpr(BuildAs<Expr>(f[0]), BuildAs<Operator>(f[1]), BuildAs<Expr>(f[2]));
+      case AstWriter::AssignExprNode:
+        return new AssignExpr(BuildAs<Expr>(f[0]), BuildAs<Operator>(f[1]), BuildAs<Expr>(f[2]));
+
+      case AstWriter::ThisNode:
+        return new This(loc);
+      case AstWriter::ArrayAccessNode:
+        return new ArrayAccess(loc, BuildAs<Expr>(f[0]), BuildAs<Expr>(f[1]));
+      case AstWriter::FieldAccessNode:
+        return new FieldAccess(BuildAs<Expr>(f[0]), BuildAs<Identifier>(f[1]));
+      case AstWriter::CallNode:
+        return new Call(loc, BuildAs<Expr>(f[0]), BuildAs<Identifier>(f[1]), BuildList<Expr>(f[2]));
+      case AstWriter::NewExprNode:
+        return new NewExpr(loc, BuildAs<NamedType>(f[0]));
+      case AstWriter::NewArrayExprNode:
+        return new NewArrayExpr(loc, BuildAs<Expr>(f[0]), BuildAs<Type>(f[1]));
+      case AstWriter::ReadIntegerExprNode:
+        return new ReadIntegerExpr(loc);
+      case AstWriter::ReadLineExprNode:
+        return new ReadLineExpr(loc);
+    }
+    Failure("Bad node kind %d in the AST cache", r.kind);
+    return NULL;
+}
+
+
+/* The records of a program, or NULL if it is too deeply nested to save.
+ * decls is set to the number of its list of declarations. */
+static AstWriter *SaveToAstCache(Program *program, int *decls)
+{
+    AstWriter *writer = new AstWriter;
+    *decls = program->Save(writer);
+    if (writer->TooDeep()) {
+        PrintDebug("cache", "Nested more than %d deep, not saving", AstWriter::MaxDepth);
+        delete writer;
+        return NULL;
+    }
+    return writer;
+}
+
+
+void CompileWithCache(const char *dir)
+{
+    int len;
+    char *text = ReadInput(stdin, &len);
+    uint64_t hash = Fnv1a(text, len);
+    char *path = (char *)malloc(strlen(dir) + 32);
+    sprintf(path, "%s/%016llx.ast", dir, (unsigned long long)hash);
+
+    double start = Now();
+    if (OpenCache(path, hash, len)) {
+        Program *program = new Program(BuildList<Decl>(header->program));
+        uint32_t micros = header->parseMicros;
+        munmap((void *)header, mappedSize);
+        PrintDebug("cache", "Loaded %s in %.2f ms, parsing took %.2f ms",
+                   path, (Now() - start) * 1e3, micros / 1e3);
+        TakeLinesFrom(text, len);
+        program->Check(); // there were no errors when it was parsed
+        return;
+    }
+
+    PrintDebug("cache", "No usable %s, parsing", path);
+    DeclRange result(0, 0);
+    result.reportErrors = true;
+    DiagnosticBuffer parseErrors;
+    ReportError::RecordTo(&parseErrors);
+    PushParser parser(&result);
+    parser.Feed(text, len);
+    parser.Finish();
+    ReportError::RecordTo(NULL);
+    uint32_t parseMicros = (Now() - start) * 1e6;
+    Program *program = result.program; // NULL if there were errors
+
+    // Saved before checking, which changes the tree. Not saved if a
+    // syntax error follows (bison reduces Program before it sees a
+    // stray token at the end), but checked all the same, and its errors
+    // come first, as when the Program rule checks.
+    int decls;
+    AstWriter *saved = NULL;
+    if (program && parser.Accepted())
+        saved = SaveToAstCache(program, &decls);
+    if (program)
+        program->Check();
+    ReportError::AddAll(&parseErrors);
+    if (!saved) return;
+
+    start = Now();
+    if (mkdir(dir, 0777) != 0 && errno != EEXIST)
+        PrintDebug("cache", "Cannot create %s", dir);
+    else if (!saved->WriteFile(path, hash, len, decls, parseMicros))
+        PrintDebug("cache", "Cannot write %s", path);
+    else
+        PrintDebug("cache", "Parsed in %.2f ms, wrote %s in %.2f ms",
+                   parseMicros / 1e3, path, (Now() - start) * 1e3);
+    delete saved;
+}
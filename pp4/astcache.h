@@ -0,0 +1,144 @@
+/* File: astcache.h
+ * ----------------
+ * A cache of parsed programs, so that an unchanged source file goes
+ * straight to semantic checking. With -cache[=dir] on the command line
+ * the input is read as a whole and hashed (64-bit FNV-1a). If dir (by
+ * default .dcc-cache) holds a file for that hash, the AST is built from
+ * it and checked, without scanning or parsing anything. Otherwise the
+ * input is parsed as usual and, if it has no lexical or syntax errors,
+ * its AST is written to the cache before it is checked. With -d cache,
+ * the time a load takes is reported next to the time the parse it
+ * saved took when the file was written.
+ *
+ * The file is meant to be mapped and read in place. It is made of
+ * 32-bit numbers, in this order:
+ *
+ *   - a header (AstCacheHeader) with the counts of what follows, the
+ *     hash and length of the source and a checksum of the rest
+ *   - the nodes, fixed-size records of a kind, a location and four
+ *     fields, children before their parents. What the fields hold
+ *     depends on the kind: other nodes, lists, names or values, as the
+ *     Save method of each node class writes them
+ *   - the lists, each a range of the items that follow
+ *   - the items, node numbers
+ *   - the locations, first and last line and column
+ *   - the identifier names and then the string literals, each as an
+ *     array of offsets followed by the characters, null-terminated
+ *
+ * Nodes, lists, names and locations are referred to by number, starting
+ * at 1, with 0 for none. Nothing is decoded up front: opening the file
+ * checks it and interns the names, and the nodes are then built from
+ * their records as the tree is walked.
+ *
+ * Saving and building recurse down the tree, so a program nested more
+ * than AstWriter::MaxDepth deep is checked without being cached.
+ */
+
+#ifndef _H_astcache
+#define _H_astcache
+
+#include <stdint.h>
+#include <vector>
+#include "list.h"
+#include "location.h"
+#include "strpool.h"
+
+class Node;
+class Type;
+class Program;
+
+
+/* Bump this when the format or the node classes change. */
+static const uint32_t AstCacheVersion = 2;
+
+struct AstCacheHeader {
+    char magic[4];              // "DAST"
+    uint32_t version;
+    uint64_t sourceHash;
+    uint64_t checksum;          // FNV-1a of everything after the header
+    uint32_t sourceLength;
+    uint32_t parseMicros;       // how long the parse took
+    uint32_t numNodes, numLists, numItems, numLocations;
+    uint32_t numNames, namesSize, numLiterals, literalsSize;
+    uint32_t program;           // the list of top-level declarations
+    uint32_t unused;
+};
+
+
+class AstWriter
+{
+  public:
+    typedef enum { NoNode, IdentifierNode, OperatorNode,
+                   BuiltinTypeNode, NamedTypeNode, ArrayTypeNode,
+                   VarDeclNode, ClassDeclNode, InterfaceDeclNode, FnDeclNode,
+                   StmtBlockNode, ForStmtNode, WhileStmtNode, IfStmtNode,
+                   BreakStmtNode, ReturnStmtNode, PrintStmtNode,
+                   SwitchStmtNode, CaseStmtNode,
+                   EmptyExprNode, IntConstantNode, DoubleConstantNode,
+                   BoolConstantNode, StringConstantNode, NullConstantNode,
+                   PostfixExprNode, ArithmeticExprNode, RelationalExprNode,
+                   EqualityExprNode, LogicalExprNode, AssignExprNode,
+                   ThisNode, ArrayAccessNode, FieldAccessNode, CallNode,
+                   NewExprNode, NewArrayExprNode,
+                   ReadIntegerExprNode, ReadLineExprNode } NodeKind;
+
+    struct Record {
+        uint32_t kind;
+        uint32_t location;
+        int32_t fields[4];
+    };
+
+  protected:
+    std::vector<Record> nodes;
+    std::vector<uint32_t> lists;        // first item and count of each
+    std::vector<uint32_t> items;
+    std::vector<int32_t> locations;     // four numbers each
+    int depth;                          // of the node being saved
+    bool tooDeep;                       // set if one was not saved
+
+    int AddList(const std::vector<int> &elems);
+
+  public:
+    static const int MaxDepth = 2000;
+
+    AstWriter() : depth(0), tooDeep(false) {}
+
+          // True if the tree went deeper than MaxDepth, when what was
+          // saved is incomplete
+    bool TooDeep() { return tooDeep; }
+
+          // Adds a record and returns its number. loc may be NULL.
+    int Add(NodeKind kind, yyltype *loc, int a = 0, int b = 0, int c = 0, int d = 0);
+
+          // Save node or all elements of list (either may be NULL) and
+          // return the number of the record or list
+    int Save(Node *node);
+    template <class Element> int SaveList(List<Element> *list) {
+        if (!list) return 0;
+        std::vector<int> saved; // the elements may add lists of their own
+        for (int i = 0; i < list->NumElements(); i++)
+            saved.push_back(Save(list->Nth(i)));
+        return AddList(saved);
+    }
+
+          // Numbers for an interned name, a string literal and one of the
+          // builtin types like Type::intType
+    int Name(const char *name);
+    int Literal(const PooledString *literal);
+    int Builtin(Type *type);
+
+          // Writes the records to path, with program the number of the
+          // list of declarations. Returns false if that failed.
+    bool WriteFile(const char *path, uint64_t sourceHash, int sourceLength,
+                   int program, uint32_t parseMicros);
+};
+
+
+/* Function: CompileWithCache()
+ * ----------------------------
+ * Compiles all of stdin as described above, with the cache in dir.
+ * Used instead of InitScanner() and yyparse().
+ */
+void CompileWithCache(const char *dir);
+
+#endif
@@ -0,0 +1,194 @@
+/* File: batch.cc
+ * --------------
+ * Implementation of batch compiling: gathering the files, keeping up to
+ * the given number of processes compiling them, and writing the report.
+ */
+
+#include "batch.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <set>
+#include <string>
+#include <vector>
+#include "utility.h" // for GetArgument(), PrintDebug(), ForkCompiler()
+
+
+struct Job {
+    std::string path;
+    std::string outPath;        // with -outdir, else empty
+    pid_t pid;                  // 0 once done
+    int out;                    // where the compile writes, until done
+    int status;                 // as waitpid() gives it
+    std::string output;         // kept for the report until it is written
+    bool done;
+};
+
+
+/* Adds the files named in list, one per line, or on stdin for "-" */
+static bool AddListed(const char *list, std::vector<Job> *jobs)
+{
+    FILE *fp = strcmp(list, "-") ? fopen(list, "r") : stdin;
+    if (!fp) {
+        fprintf(stderr, "dcc: cannot open %s: %s\n", list, strerror(errno));
+        return false;
+    }
+    char *line = NULL;
+    size_t size = 0;
+    ssize_t len;
+    while ((len = getline(&line, &size, fp)) >= 0) {
+        while (len > 0 && (line[len-1] == '\n' || line[len-1] == '\r' || line[len-1] == ' '))
+            line[--len] = '\0';
+        if (len > 0)
+            jobs->push_back(Job{line});
+    }
+    free(line);
+    if (fp != stdin) fclose(fp);
+    return true;
+}
+
+
+/* The file in dir named after path, with .decaf replaced by .out */
+static std::string OutputPath(const char *dir, const std::string &path)
+{
+    std::string name = path.substr(path.rfind('/') + 1);   // npos + 1 is 0
+    size_t len = name.size();
+    if (len > 6 && name.compare(len - 6, 6, ".decaf") == 0)
+        name.resize(len - 6);
+    return std::string(dir) + "/" + name + ".out";
+}
+
+
+/* Forks the process compiling job, or returns false if its files cannot
+ * be opened */
+static bool Start(Job *job, int (*compile)())
+{
+    int in = open(job->path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (in < 0) {
+        job->output = "dcc: cannot open " + job->path + ": " + strerror(errno) + "\n";
+        return false;
+    }
+    if (!job->outPath.empty())
+        job->out = open(job->outPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+    else {
+        FILE *tmp = tmpfile();
+        job->out = tmp ? dup(fileno(tmp)) : -1;
+        if (tmp) fclose(tmp);
+    }
+    if (job->out < 0) {
+        job->output = "dcc: cannot write the output of " + job->path + ": " + strerror(errno) + "\n";
+        close(in);
+        return false;
+    }
+
+    job->pid = ForkCompiler();
+    if (job->pid == 0) {
+        dup2(in, 0);                // clears close-on-exec on the copies
+        dup2(job->out, 1);
+        dup2(job->out, 2);
+        clearerr(stdin);            // at its end if the files were read from it
+        CompileAndExit(compile);
+    }
+    close(in);
+    if (job->pid < 0) {
+        job->output = std::string("dcc: cannot fork: ") + strerror(errno) + "\n";
+        close(job->out);
+        return false;
+    }
+    return true;
+}
+
+
+/* Waits for one of the processes started and takes what it wrote */
+static void WaitForOne(std::vector<Job> &jobs)
+{
+    int status;
+    pid_t pid;
+    while ((pid = wait(&status)) < 0 && errno == EINTR) ;
+    if (pid < 0) return;
+    for (Job &job : jobs) {
+        if (job.pid != pid) continue;
+        job.pid = 0;
+        job.status = status;
+        if (job.outPath.empty()) {
+            char buf[16384];
+            ssize_t n;
+            lseek(job.out, 0, SEEK_SET);
+            while ((n = read(job.out, buf, sizeof(buf))) > 0)
+                job.output.append(buf, n);
+        }
+        close(job.out);
+        job.done = true;
+        return;
+    }
+}
+
+
+static void Report(Job *job)
+{
+    if (WIFEXITED(job->status))
+        printf("=== %s: exit status %d\n", job->path.c_str(), WEXITSTATUS(job->status));
+    else
+        printf("=== %s: killed by signal %d (%s)\n", job->path.c_str(),
+               WTERMSIG(job->status), strsignal(WTERMSIG(job->status)));
+    fwrite(job->output.data(), 1, job->output.size(), stdout);
+    std::string().swap(job->output);
+}
+
+
+int CompileBatch(int (*compile)())
+{
+    std::vector<Job> jobs;
+    for (int i = 0; GetArgument(i); i++) {
+        const char *arg = GetArgument(i);
+        if (arg[0] == '@') {
+            if (!AddListed(arg + 1, &jobs)) return 1;
+        } else
+            jobs.push_back(Job{arg});
+    }
+
+    const char *outDir = GetOption("outdir");
+    if (outDir) {
+        std::set<std::string> taken;
+        for (Job &job : jobs) {
+            job.outPath = OutputPath(*outDir ? outDir : ".", job.path);
+            if (!taken.insert(job.outPath).second) {
+                fprintf(stderr, "dcc: two inputs would both be written to %s\n", job.outPath.c_str());
+                return 1;
+            }
+        }
+    }
+    int maxRunning = atoi(GetOption("batch"));
+    if (maxRunning <= 0) maxRunning = sysconf(_SC_NPROCESSORS_ONLN);
+    if (maxRunning <= 0) maxRunning = 1;
+
+    double start = Now();
+    size_t next = 0, reported = 0;
+    int running = 0, failed = 0;
+    while (reported < jobs.size()) {
+        if (next < jobs.size() && running < maxRunning) {
+            Job &job = jobs[next++];
+            if (Start(&job, compile))
+                running++;
+            else {
+                job.status = 1 << 8;        // exit status 1
+                job.done = true;
+            }
+        } else if (running > 0) {
+            WaitForOne(jobs);
+            running--;
+        }
+        while (reported < jobs.size() && jobs[reported].done) {
+            Job &job = jobs[reported++];
+            if (job.status != 0) failed++;
+            Report(&job);
+        }
+    }
+    PrintDebug("batch", "Compiled %d files, %d at a time, in %.3f s, %d with errors",
+               (int)jobs.size(), maxRunning, Now() - start, failed);
+    return failed == 0 ? 0 : 1;
+}
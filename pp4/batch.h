@@ -0,0 +1,37 @@
+/* File: batch.h
+ * -------------
+ * Compiling many programs in one go. dcc -batch[=jobs] file ... compiles
+ * each of the files as dcc < file would, with the other options given,
+ * jobs of them at a time (by default as many as there are processors).
+ * An argument @list stands for the files named in list, one per line,
+ * @- for those named on stdin.
+ *
+ * Each file is compiled by a process forked from this one, which starts
+ * out with the compiler loaded and set up but nothing compiled, so no
+ * state is shared between files and a crash only loses the file that
+ * caused it. What a file's compile writes to stdout and stderr goes,
+ * in the order written, to
+ *
+ *   - the report on stdout, after a line with the file's name and exit
+ *     status, in the order the files were given whichever finishes
+ *     first,
+ *   - or with -outdir=dir, to the file in dir named after the input
+ *     with .decaf replaced by .out, with only the status lines in the
+ *     report. Two inputs with the same name are refused.
+ *
+ * The exit status is 0 if every file compiled without errors, else 1.
+ * With -d batch, the number of files and the time taken are reported.
+ */
+
+#ifndef _H_batch
+#define _H_batch
+
+
+/* Function: CompileBatch()
+ * ------------------------
+ * Compiles the files given as described above, calling compile() for
+ * each one with it on stdin, and returns the exit status.
+ */
+int CompileBatch(int (*compile)());
+
+#endif
@@ -0,0 +1,45 @@
+#!/bin/sh
+# File: bench/errors.sh
+# ---------------------
+# Inputs with a flood of errors (see diagnostics.h): makes three of
+# them and times dcc on each as usual, with -fold and with
+# -maxerrors=100, best of 3, writing the messages to a file:
+#
+#   same      30000 functions with two errors each, all with one of
+#             two messages
+#   chars     30000 lines of characters the scanner does not recognize
+#   distinct  20000 functions, each error naming its own variable
+#
+# Usage: bench/errors.sh [dcc]
+
+dcc=${1:-./dcc}
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+awk -v out="$work" 'BEGIN {
+    for (i = 0; i < 30000; i++)
+        print "void f" i "() { int a; a = b; a = true; }" > (out "/same.decaf")
+    for (i = 0; i < 30000; i++)
+        print "int x" i "; @ # $ ` ~ ^" > (out "/chars.decaf")
+    for (i = 0; i < 20000; i++)
+        print "void f" i "() { int a; a = b" i "; }" > (out "/distinct.decaf")
+}'
+
+best() {    # best of 3 runs of dcc with the given options and input, in ms
+    input=$1; shift
+    min=
+    for run in 1 2 3; do
+        start=$(date +%s%N)
+        "$dcc" "$@" < "$input" > "$work/out" 2>&1
+        ns=$(( $(date +%s%N) - start ))
+        [ -z "$min" ] || [ $ns -lt $min ] && min=$ns
+    done
+    echo $((min / 1000000))
+}
+
+printf "%-10s %10s %10s %16s   (ms)\n" input plain -fold -maxerrors=100
+for name in same chars distinct; do
+    input=$work/$name.decaf
+    printf "%-10s %10d %10d %16d\n" $name $(best "$input") $(best "$input" -fold) \
+           $(best "$input" -maxerrors=100)
+done
@@ -0,0 +1,75 @@
+#!/bin/sh
+# File: bench/exprs.sh
+# --------------------
+# Expression parsing: makes n random expression statements (60000 by
+# default) mixing every operator, calls, member access, subscripts,
+# ++/-- and assignments, and times, best of 5,
+#
+#   - scanning them alone (dcc -tokens=count),
+#   - the bison parser, with the statements in a function body,
+#   - the expression parser of exprparse.h (dcc -exprs).
+#
+# The function is followed by a stray token, so the program ends in a
+# syntax error and the bison run stops after parsing, as -exprs does,
+# without checking anything. Usage: bench/exprs.sh [dcc [n]]
+
+dcc=${1:-./dcc}
+n=${2:-60000}
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+awk -v n=$n -v out="$work" '
+function primary(   r) {
+    r = int(rand() * 10)
+    if (r < 3) return name()
+    if (r == 3) return int(rand() * 1000)
+    if (r == 4) return "1.5e" int(rand() * 10)
+    if (r == 5) return "\"s" int(rand() * 100) "\""
+    if (r == 6) return name() "." name()
+    if (r == 7) return name() "[" expr(1) "]"
+    if (r == 8) return name() "(" expr(1) ", " primary() ")"
+    return rand() < 0.5 ? "true" : "this." name() "(" ")"
+}
+function name() { return substr("abcdefghijklmnopqrstuvwxyz", int(rand() * 26) + 1, 1) "x" }
+function expr(depth,   r, op) {
+    if (depth > 3) return primary()
+    r = int(rand() * 8)
+    if (r < 2) return primary()
+    if (r == 2) return "(" expr(depth + 1) ")"
+    if (r == 3) return (rand() < 0.5 ? "- " : "!") expr(depth + 1)   # "-" "-x" would be --x
+    if (r == 4) return "(" expr(depth + 1) " " substr("< > <=>===!=", 1 + 2 * int(rand() * 5), 2) " " expr(depth + 1) ")"
+    op = substr("+-*/%", int(rand() * 5) + 1, 1)
+    if (r == 5) op = rand() < 0.5 ? "&&" : "||"
+    return expr(depth + 1) " " op " " expr(depth + 1)
+}
+BEGIN {
+    srand(1)
+    program = out "/program.decaf"; exprs = out "/exprs.decaf"
+    print "void f() {" > program
+    for (i = 0; i < n; i++) {
+        r = rand()
+        if (r < 0.3) s = name() " = " expr(0)
+        else if (r < 0.35) s = name() (rand() < 0.5 ? "++" : "--")
+        else s = expr(0)
+        print s ";" > exprs
+        print "    " s ";" > program
+    }
+    print "}\nint" > program
+}'
+
+best() {    # best of 5 runs of dcc with the given options and input, in ms
+    input=$1; shift
+    min=
+    for run in 1 2 3 4 5; do
+        start=$(date +%s%N)
+        "$dcc" "$@" < "$input" > /dev/null 2>&1
+        ns=$(( $(date +%s%N) - start ))
+        [ -z "$min" ] || [ $ns -lt $min ] && min=$ns
+    done
+    echo $((min / 1000000))
+}
+
+echo "$n expression statements, $(wc -c < "$work/exprs.decaf") bytes"
+echo "scanning only:        $(best "$work/program.decaf" -tokens=count) ms"
+echo "bison parser:         $(best "$work/program.decaf") ms"
+echo "expression parser:    $(best "$work/exprs.decaf" -exprs) ms"
@@ -0,0 +1,121 @@
+/* File: bench/fastscan.cc
+ * -----------------------
+ * Microbenchmark for the bulk scanning routines of fastscan.h. Each of
+ * SkipBlanks, SkipCommentText and SkipIdentChars is run on its own over
+ * a buffer made of runs of the characters it skips, with short, medium
+ * and long runs, with and without tabs, measured separately, once for
+ * every variant this CPU has. The variants must also agree on where
+ * every run ends and on the columns, else the benchmark fails.
+ *
+ * Built and run with make bench, or on its own with
+ *   g++ -O2 -I. -o bench/fastscan bench/fastscan.cc fastscan.cc
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <string>
+#include "fastscan.h"
+
+
+static double Now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+
+enum Routine { Blanks, Comment, Ident };
+static const char *routineNames[] = { "blanks", "comment", "ident" };
+static const char *variantNames[] = { "scalar", "sse2", "avx2" };
+
+
+/* About size bytes of runs of between minRun and maxRun characters the
+ * routine skips, each ended by one it stops at. With tabs, about one in
+ * six blanks is a tab. */
+static std::string MakeInput(Routine routine, int minRun, int maxRun, bool tabs, size_t size)
+{
+    static const char ident[] = "abcXYZ_019qQ";
+    static const char *stops[] = { "x", "\n", "+" };
+    const char *chars = routine == Ident ? ident
+                      : routine == Blanks ? (tabs ? "     \t" : " ")
+                      : (tabs ? "text, * / \t()" : "text, * / ()");
+    int numChars = strlen(chars);
+    std::string s;
+    srand(1);
+    while (s.size() < size) {
+        for (int n = minRun + rand() % (maxRun - minRun + 1); n > 0; n--)
+            s += chars[rand() % numChars];
+        s += routine == Comment && rand() % 2 ? "*/" : stops[routine];
+    }
+    return s;
+}
+
+
+/* Skips every run in the input, returning a checksum of the positions
+ * and columns reached */
+static unsigned long SkipAll(Routine routine, const std::string &input)
+{
+    const char *p = input.data(), *end = p + input.size();
+    unsigned long sum = 0;
+    int col = 1;
+    while (p < end) {
+        if (routine == Blanks) p = SkipBlanks(p, end, &col);
+        else if (routine == Comment) p = SkipCommentText(p, end, &col);
+        else p = SkipIdentChars(p, end);
+        sum = sum * 31 + (p - input.data()) + col;
+        p++;                                    // the character that ended the run
+        col = 1;
+    }
+    return sum;
+}
+
+
+int main()
+{
+    static const struct { Routine routine; int minRun, maxRun; bool tabs; } cases[] = {
+        { Blanks, 1, 8, false }, { Blanks, 8, 64, false }, { Blanks, 64, 1024, false },
+        { Blanks, 1, 8, true }, { Blanks, 8, 64, true }, { Blanks, 64, 1024, true },
+        { Comment, 1, 8, false }, { Comment, 8, 64, false }, { Comment, 64, 1024, false },
+        { Comment, 8, 64, true }, { Comment, 64, 1024, true },
+        { Ident, 1, 8, false }, { Ident, 8, 64, false }, { Ident, 64, 1024, false },
+    };
+    const size_t size = 4 << 20;
+    bool agree = true;
+
+    printf("%-8s %-14s", "routine", "run");
+    for (const char *v : variantNames) printf(" %12s", v);
+    printf("   (MB/s)\n");
+    for (auto &c : cases) {
+        std::string input = MakeInput(c.routine, c.minRun, c.maxRun, c.tabs, size);
+        char label[32];
+        sprintf(label, "%d-%d%s", c.minRun, c.maxRun, c.tabs ? " tabs" : "");
+        printf("%-8s %-14s", routineNames[c.routine], label);
+        unsigned long expected = 0;
+        for (int v = 0; v < 3; v++) {
+            if (!SetFastScanVariant(variantNames[v])) {
+                printf(" %12s", "-");
+                continue;
+            }
+            unsigned long sum = SkipAll(c.routine, input);
+            if (v == 0) expected = sum;
+            else if (sum != expected) agree = false;
+            double best = 1e9;
+            for (int i = 0; i < 5; i++) {
+                double start = Now();
+                SkipAll(c.routine, input);
+                double t = Now() - start;
+                if (t < best) best = t;
+            }
+            printf(" %12.0f%s", size / best / 1e6, sum == expected ? "" : "!");
+        }
+        printf("\n");
+    }
+    if (!agree) {
+        printf("the variants marked ! disagree with the scalar one\n");
+        return 1;
+    }
+    return 0;
+}
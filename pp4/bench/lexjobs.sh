@@ -0,0 +1,42 @@
+#!/bin/sh
+# File: bench/lexjobs.sh
+# ----------------------
+# Scaling of the chunked scan (see tokenstream.h): times dcc
+# -tokens=count on about 20 MB of copies of the samples that have no
+# lexical errors, scanning serially and with -lexjobs=2, 4 and 8, best
+# of 5 runs, and prints the speedup over the serial scan. The chunks
+# are only scanned at the same time with as many cores to run on, so
+# the speedup is bounded by the number of cpus printed. Whole runs are
+# timed, so the input being read and the process starting are part of
+# it. Usage: bench/lexjobs.sh [dcc]
+
+dcc=${1:-./dcc}
+input=$(mktemp)
+trap 'rm -f "$input"' EXIT
+
+samples=$(ls samples/*.decaf | grep -v '/bad')
+size=0
+while [ $size -lt 20000000 ]; do
+    cat $samples >> "$input"
+    size=$(wc -c < "$input")
+done
+
+best() {    # best of 5 runs of dcc -tokens=count with the given options, in ns
+    min=
+    for run in 1 2 3 4 5; do
+        start=$(date +%s%N)
+        "$dcc" -tokens=count "$@" < "$input" > /dev/null
+        ns=$(( $(date +%s%N) - start ))
+        [ -z "$min" ] || [ $ns -lt $min ] && min=$ns
+    done
+    echo $min
+}
+
+echo "$size bytes, $(getconf _NPROCESSORS_ONLN) cpus"
+serial=$(best)
+echo "serial:       $((serial / 1000000)) ms"
+for jobs in 2 4 8; do
+    ns=$(best -lexjobs=$jobs)
+    awk -v jobs=$jobs -v ns=$ns -v serial=$serial \
+        'BEGIN { printf "-lexjobs=%d:  %d ms, %.2fx\n", jobs, ns / 1e6, serial / ns }'
+done
@@ -0,0 +1,168 @@
+/* File: bench/numbers.cc
+ * ----------------------
+ * Microbenchmark and cross-check for the conversions of numbers.h. For
+ * each kind of numeric constant (short and long decimal integers, hex
+ * integers, doubles that take the fast path and doubles that do not)
+ * a table of a million random lexemes, some of them out of range, is
+ * converted with ParseInteger or ParseDouble and with strtoull or
+ * strtod. Every value, and whether it is in range, must be the same as
+ * the library's, else the benchmark fails. Then both are timed over the
+ * table, best of 5, in millions of constants per second.
+ *
+ * Built and run with make bench, or on its own with
+ *   g++ -O2 -I. -o bench/numbers bench/numbers.cc numbers.cc
+ */
+
+#include <errno.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <string>
+#include <vector>
+#include "numbers.h"
+
+
+static double Now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+
+enum Kind { ShortDecimal, LongDecimal, Hex, FastDouble, SlowDouble };
+static const char *kindNames[] = { "decimal 1-4", "decimal 8-12", "hex", "double fast", "double slow" };
+
+
+static std::string Digits(int n, const char *chars)
+{
+    std::string s;
+    int numChars = strlen(chars);
+    while (n-- > 0)
+        s += chars[rand() % numChars];
+    return s;
+}
+
+/* A random lexeme of the kind, as the scanner would match it */
+static std::string MakeLexeme(Kind kind)
+{
+    switch (kind) {
+      case ShortDecimal: return Digits(1 + rand() % 4, "0123456789");
+      case LongDecimal: return Digits(8 + rand() % 5, "0123456789");
+      case Hex: return (rand() % 2 ? "0x" : "0X") + Digits(1 + rand() % 10, "0123456789abcdefABCDEF");
+      case FastDouble: {
+        std::string s = Digits(1 + rand() % 4, "0123456789") + "." + Digits(rand() % 4, "0123456789");
+        if (rand() % 3 == 0)
+            s += (rand() % 2 ? "E+" : "e-") + std::to_string(rand() % 20);
+        return s;
+      }
+      case SlowDouble: {
+        std::string s = Digits(1 + rand() % 12, "123456789") + "." + Digits(8 + rand() % 12, "0123456789");
+        return s + (rand() % 2 ? "E" : "e-") + std::to_string(rand() % 330);
+      }
+    }
+    return "";
+}
+
+
+/* The lexemes, each followed by a '\0' for the library routines */
+struct Table {
+    std::string text;
+    std::vector<int> starts, lengths;
+};
+
+static Table MakeTable(Kind kind, int count)
+{
+    Table t;
+    srand(1 + kind);
+    for (int i = 0; i < count; i++) {
+        std::string s = MakeLexeme(kind);
+        t.starts.push_back(t.text.size());
+        t.lengths.push_back(s.size());
+        t.text += s;
+        t.text += '\0';
+    }
+    return t;
+}
+
+
+/* Converts every lexeme both ways, returning the number that differ */
+static int CrossCheck(Kind kind, const Table &t)
+{
+    int bad = 0;
+    for (size_t i = 0; i < t.starts.size(); i++) {
+        const char *s = t.text.data() + t.starts[i];
+        bool ok, expectedOk;
+        if (kind == FastDouble || kind == SlowDouble) {
+            double d, expected = strtod(s, NULL);
+            ok = ParseDouble(s, t.lengths[i], &d);
+            expectedOk = isfinite(expected);
+            if (ok != expectedOk || memcmp(&d, &expected, sizeof(d)) != 0) {
+                if (++bad <= 5) printf("%s: %.17g, strtod says %.17g\n", s, d, expected);
+            }
+        } else {
+            int v;
+            errno = 0;
+            unsigned long long expected = strtoull(s, NULL, kind == Hex ? 16 : 10);
+            expectedOk = errno == 0 && expected <= (kind == Hex ? 0xFFFFFFFFULL : 0x7FFFFFFFULL);
+            ok = ParseInteger(s, t.lengths[i], &v);
+            if (ok != expectedOk || (ok && v != (int)(uint32_t)expected)) {
+                if (++bad <= 5) printf("%s: %d%s, strtoull says %llu\n", s, v, ok ? "" : " (out of range)", expected);
+            }
+        }
+    }
+    return bad;
+}
+
+
+/* Seconds to convert the table, best of 5, with ours or the library's */
+static double Time(Kind kind, const Table &t, bool library)
+{
+    bool isDouble = (kind == FastDouble || kind == SlowDouble);
+    double best = 1e9, sum = 0;
+    for (int run = 0; run < 5; run++) {
+        double start = Now();
+        for (size_t i = 0; i < t.starts.size(); i++) {
+            const char *s = t.text.data() + t.starts[i];
+            if (isDouble) {
+                double d;
+                if (library) d = strtod(s, NULL);
+                else ParseDouble(s, t.lengths[i], &d);
+                sum += d;
+            } else {
+                int v;
+                if (library) v = (int)strtoull(s, NULL, kind == Hex ? 16 : 10);
+                else ParseInteger(s, t.lengths[i], &v);
+                sum += v;
+            }
+        }
+        double elapsed = Now() - start;
+        if (elapsed < best) best = elapsed;
+    }
+    if (sum == 12345.678) printf(" ");     // keeps the conversions from being optimized away
+    return best;
+}
+
+
+int main()
+{
+    const int count = 1000000;
+    int bad = 0;
+
+    printf("%-14s %12s %12s   (M constants/s)\n", "constants", "numbers.h", "strtoull/d");
+    for (int k = ShortDecimal; k <= SlowDouble; k++) {
+        Kind kind = (Kind)k;
+        Table t = MakeTable(kind, count);
+        bad += CrossCheck(kind, t);
+        printf("%-14s %12.1f %12.1f\n", kindNames[kind],
+               count / Time(kind, t, false) / 1e6, count / Time(kind, t, true) / 1e6);
+    }
+    if (bad) {
+        printf("%d constants converted differently from the C library\n", bad);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,52 @@
+#!/bin/sh
+# File: bench/pipeline.sh
+# -----------------------
+# The scanner thread of -pipeline (see tokenstream.h): makes a program
+# of n functions (40000 by default, about 12 MB) with no errors, and
+# times compiling it with dcc as usual and with -pipeline, best of 5.
+# The scanner can only run alongside the parser with a second core to
+# run on, so on one the pipeline is just the cost of handing the tokens
+# over. Usage: bench/pipeline.sh [dcc [n]]
+
+dcc=${1:-./dcc}
+n=${2:-40000}
+input=$(mktemp)
+trap 'rm -f "$input"' EXIT
+
+awk -v n=$n 'BEGIN {
+    for (i = 0; i < n; i++) {
+        print "/* f" i " folds the numbers below a into one */"
+        print "int f" i "(int a, int b) {"
+        print "    int j;"
+        print "    int s;"
+        print "    s = 0;"
+        print "    for (j = 0; j < a; j = j + 1) {"
+        print "        if (j % 3 == 0) s = s + j * b;"
+        print "        else s = s - 1;   // count down"
+        print "    }"
+        print "    while (s > 100000) s = s / 2;"
+        print "    " (i ? "return s + f" int(rand() * i) "(a - 1, b);" : "return s;")
+        print "}"
+    }
+    print "void main() {"
+    print "    Print(\"f: \", f" n - 1 "(10, 3));"
+    print "}"
+}' > "$input"
+
+best() {    # best of 5 runs of dcc with the given options, in ms
+    min=
+    for run in 1 2 3 4 5; do
+        start=$(date +%s%N)
+        "$dcc" "$@" < "$input" > /dev/null 2>&1
+        ns=$(( $(date +%s%N) - start ))
+        [ -z "$min" ] || [ $ns -lt $min ] && min=$ns
+    done
+    echo $((min / 1000000))
+}
+
+serial=$(best)
+pipeline=$(best -pipeline)
+echo "$n functions, $(wc -c < "$input") bytes, $(getconf _NPROCESSORS_ONLN) cpus"
+echo "serial:     $serial ms"
+echo "-pipeline:  $pipeline ms"
+awk -v s=$serial -v p=$pipeline 'BEGIN { printf "speedup:    %.2fx\n", s / p }'
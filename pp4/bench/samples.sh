@@ -0,0 +1,43 @@
+#!/bin/sh
+# File: bench/samples.sh
+# ----------------------
+# Time on normal code: compiles each of the samples that have no errors
+# 20 times over, one dcc process per compile as usual, and prints the
+# time taken, best of 5. Given a second dcc to compare with, e.g. one
+# built before a change, both are timed, a round of one then a round of
+# the other, and the check fails (exit 1) if the first takes more than
+# 10% longer. Usage: bench/samples.sh [dcc [baseline-dcc]]
+
+dcc=${1:-./dcc}
+baseline=$2
+samples=$(ls samples/*.decaf | grep -v '/bad')
+
+round() {   # ns to compile the samples 20 times with the dcc given
+    start=$(date +%s%N)
+    for i in 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20; do
+        for input in $samples; do
+            "$1" < "$input" > /dev/null 2>&1
+        done
+    done
+    echo $(( $(date +%s%N) - start ))
+}
+
+best= baseBest=
+for run in 1 2 3 4 5; do
+    ns=$(round "$dcc")
+    [ -z "$best" ] || [ $ns -lt $best ] && best=$ns
+    if [ -n "$baseline" ]; then
+        ns=$(round "$baseline")
+        [ -z "$baseBest" ] || [ $ns -lt $baseBest ] && baseBest=$ns
+    fi
+done
+
+count=$(echo $samples | wc -w)
+echo "$dcc: $((count * 20)) compiles of the samples in $((best / 1000000)) ms"
+[ -z "$baseline" ] && exit 0
+echo "$baseline: $((baseBest / 1000000)) ms"
+if [ $((best * 10)) -gt $((baseBest * 11)) ]; then
+    echo "samples: $dcc is more than 10% slower than $baseline"
+    exit 1
+fi
+echo "samples: $dcc is within 10% of $baseline"
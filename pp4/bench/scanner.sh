@@ -0,0 +1,32 @@
+#!/bin/sh
+# File: bench/scanner.sh
+# ----------------------
+# Scanner throughput: times dcc -tokens=count on about 20 MB of copies
+# of the samples that have no lexical errors, best of 5 runs, and prints
+# millions of tokens per second for each dcc given (./dcc by default),
+# e.g. bench/scanner.sh dcc-flex dcc-direct. Whole runs are timed, so
+# the input being read and the process starting are part of it.
+
+[ $# = 0 ] && set -- ./dcc
+input=$(mktemp)
+trap 'rm -f "$input"' EXIT
+
+samples=$(ls samples/*.decaf | grep -v '/bad')
+size=0
+while [ $size -lt 20000000 ]; do
+    cat $samples >> "$input"
+    size=$(wc -c < "$input")
+done
+
+for dcc in "$@"; do
+    tokens=$("$dcc" -tokens=count < "$input" | awk '{ print $1 }')
+    best=
+    for run in 1 2 3 4 5; do
+        start=$(date +%s%N)
+        "$dcc" -tokens=count < "$input" > /dev/null
+        ns=$(( $(date +%s%N) - start ))
+        [ -z "$best" ] || [ $ns -lt $best ] && best=$ns
+    done
+    awk -v dcc="$dcc" -v t=$tokens -v ns=$best \
+        'BEGIN { printf "%s: %d tokens in %d ms, %.1f Mtokens/s\n", dcc, t, ns / 1e6, t * 1e3 / ns }'
+done
@@ -0,0 +1,125 @@
+/* File: client.cc
+ * ---------------
+ * dcc-client, which takes the same arguments as dcc and has the daemon
+ * started with dcc -daemon compile for it (see daemon.h), or runs the
+ * dcc next to it if there is none.
+ */
+
+#include "daemon.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
+
+/* Runs dcc itself: the one in the same directory as this program, or
+ * failing that the first on the path. */
+static void RunCompiler(char *argv[])
+{
+    char path[PATH_MAX];
+    ssize_t len = readlink("/proc/self/exe", path, sizeof(path) - 4);
+    if (len > 0) {
+        path[len] = '\0';
+        char *slash = strrchr(path, '/');
+        strcpy(slash ? slash + 1 : path, "dcc");
+        argv[0] = path;
+        execv(path, argv);
+    }
+    argv[0] = (char *)"dcc";
+    execvp("dcc", argv);
+    fprintf(stderr, "dcc-client: cannot run dcc: %s\n", strerror(errno));
+    exit(1);
+}
+
+
+static int Connect()
+{
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    DefaultSocketPath(addr.sun_path, sizeof(addr.sun_path));
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd >= 0 && connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+
+/* Sends the request: the header with the files in the same message,
+ * then whatever of the arguments did not go with it. */
+static bool Send(int fd, int argc, char *argv[])
+{
+    size_t argsLength = 0;
+    for (int i = 1; i < argc; i++)
+        argsLength += strlen(argv[i]) + 1;
+    char *args = (char *)malloc(argsLength + 1), *p = args;
+    for (int i = 1; i < argc; i++)
+        p = stpcpy(p, argv[i]) + 1;
+
+    DaemonRequest req;
+    memcpy(req.magic, "DREQ", 4);
+    req.version = DaemonVersion;
+    req.argsLength = argsLength;
+    req.numArgs = argc - 1;
+
+    int dir = open(".", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dir < 0) return false;
+    int fds[DaemonNumFds] = { 0, 1, 2, dir };
+    char control[CMSG_SPACE(sizeof(fds))];
+    memset(control, 0, sizeof(control));
+    struct iovec iov[2] = { { &req, sizeof(req) }, { args, argsLength } };
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = 2;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+    memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+    ssize_t n;
+    while ((n = sendmsg(fd, &msg, MSG_NOSIGNAL)) < 0 && errno == EINTR) ;
+    close(dir);
+    if (n < (ssize_t)sizeof(req)) return false;  // the header goes in one piece
+    for (size_t sent = n - sizeof(req); sent < argsLength; sent += n) {
+        while ((n = send(fd, args + sent, argsLength - sent, MSG_NOSIGNAL)) < 0 && errno == EINTR) ;
+        if (n <= 0) return false;
+    }
+    free(args);
+    return true;
+}
+
+
+int main(int argc, char *argv[])
+{
+    int fd = Connect();
+    if (fd < 0 || !Send(fd, argc, argv))
+        RunCompiler(argv);          // nothing compiled yet, so no harm done
+
+    int32_t status;
+    size_t got = 0;
+    while (got < sizeof(status)) {
+        ssize_t n = read(fd, (char *)&status + got, sizeof(status) - got);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            fprintf(stderr, "dcc-client: the daemon went away\n");
+            return 1;
+        }
+        got += n;
+    }
+    if (WIFSIGNALED(status)) {      // die the way dcc did
+        signal(WTERMSIG(status), SIG_DFL);
+        raise(WTERMSIG(status));
+        return 128 + WTERMSIG(status);
+    }
+    return WEXITSTATUS(status);
+}
@@ -0,0 +1,253 @@
+/* File: daemon.cc
+ * ---------------
+ * Implementation of the compile daemon: the listening loop, which keeps
+ * track of the processes compiling, and the setting up of each of them.
+ */
+
+#include "daemon.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include "list.h"
+#include "utility.h" // for ParseCommandLine(), PrintDebug(), ForkCompiler()
+
+
+/* Signals
+ * -------
+ * SIGCHLD, SIGINT and SIGTERM are turned into bytes written to a pipe,
+ * which the loop polls along with the socket, so a child that exits
+ * between two polls is not missed.
+ */
+static int wakeUp[2] = { -1, -1 };
+static volatile sig_atomic_t stopping = 0;
+
+static void OnSignal(int sig)
+{
+    int saved = errno;
+    if (sig != SIGCHLD) stopping = 1;
+    char c = 0;
+    if (write(wakeUp[1], &c, 1) < 0) {} // full, a wake-up is pending anyway
+    errno = saved;
+}
+
+static void HandleSignals(void (*handler)(int))
+{
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = handler;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGCHLD, &sa, NULL);
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+}
+
+
+static bool ReadFully(int fd, void *buf, size_t len)
+{
+    char *p = (char *)buf;
+    while (len > 0) {
+        ssize_t n = read(fd, p, len);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n;
+        len -= n;
+    }
+    return true;
+}
+
+
+/* The compiling process
+ * ---------------------
+ * Reads the request, moves the client's files to 0, 1 and 2 and its
+ * directory to the current one, and compiles. The request is read here
+ * rather than in the daemon so a slow client holds up nobody else.
+ */
+static void ServeRequest(int conn, int (*compile)())
+{
+    DaemonRequest req;
+    int fds[DaemonNumFds];
+    char control[CMSG_SPACE(sizeof(fds))];
+    struct iovec iov = { &req, sizeof(req) };
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    ssize_t n;
+    while ((n = recvmsg(conn, &msg, MSG_CMSG_CLOEXEC)) < 0 && errno == EINTR) ;
+    if (n == 0)
+        _exit(0);                   // closed without a request, as Listen() does
+    struct cmsghdr *cmsg = (n > 0 ? CMSG_FIRSTHDR(&msg) : NULL);
+    if (!cmsg || cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS ||
+        cmsg->cmsg_len != CMSG_LEN(sizeof(fds))) {
+        fprintf(stderr, "dcc: request without the client's files\n");
+        _exit(1);
+    }
+    memcpy(fds, CMSG_DATA(cmsg), sizeof(fds));
+    if (!ReadFully(conn, (char *)&req + n, sizeof(req) - n) ||
+        memcmp(req.magic, "DREQ", 4) != 0 || req.version != DaemonVersion) {
+        fprintf(stderr, "dcc: bad request\n");
+        _exit(1);
+    }
+    char *args = (char *)malloc(req.argsLength + 1);
+    char **argv = (char **)malloc((req.numArgs + 2) * sizeof(char *));
+    if (!ReadFully(conn, args, req.argsLength)) {
+        fprintf(stderr, "dcc: request cut short\n");
+        _exit(1);
+    }
+    args[req.argsLength] = '\0';
+    int argc = 0;
+    argv[argc++] = (char *)"dcc";
+    for (char *p = args; p < args + req.argsLength && argc <= req.numArgs; p += strlen(p) + 1)
+        argv[argc++] = p;
+    argv[argc] = NULL;
+
+    for (int i = 0; i < 3; i++)
+        dup2(fds[i], i);            // clears close-on-exec on the copy
+    if (fchdir(fds[3]) != 0) {
+        fprintf(stderr, "dcc: cannot change to the client's directory: %s\n", strerror(errno));
+        _exit(1);
+    }
+    for (int i = 0; i < DaemonNumFds; i++)
+        close(fds[i]);
+    close(conn);
+
+    ParseCommandLine(argc, argv);
+    CompileAndExit(compile);
+}
+
+
+/* The daemon
+ * ----------
+ * Each compiling process is kept with the connection to its client,
+ * which is sent its status once it is reaped.
+ */
+struct Running {
+    pid_t pid;
+    int conn;
+    double started;
+};
+
+static int Listen(const char *path)
+{
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "dcc: socket path too long: %s\n", path);
+        return -1;
+    }
+    strcpy(addr.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        fprintf(stderr, "dcc: cannot create a socket: %s\n", strerror(errno));
+        return -1;
+    }
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0) {
+        fprintf(stderr, "dcc: a daemon is already listening on %s\n", path);
+        close(fd);
+        return -1;
+    }
+    unlink(path);                   // left behind by one that was killed
+    mode_t mask = umask(077);
+    int ok = bind(fd, (struct sockaddr *)&addr, sizeof(addr));
+    umask(mask);
+    if (ok != 0 || listen(fd, SOMAXCONN) != 0) {
+        fprintf(stderr, "dcc: cannot listen on %s: %s\n", path, strerror(errno));
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static bool SameUser(int conn)
+{
+    struct ucred cred;
+    socklen_t len = sizeof(cred);
+    return getsockopt(conn, SOL_SOCKET, SO_PEERCRED, &cred, &len) == 0 && cred.uid == getuid();
+}
+
+/* Reaps the children that are done, or with flags 0 waits for all */
+static void Reap(List<Running> *running, int flags)
+{
+    int status;
+    pid_t pid;
+    while (running->NumElements() > 0) {
+        pid = waitpid(-1, &status, flags);
+        if (pid < 0 && errno == EINTR) continue;
+        if (pid <= 0) break;
+        for (int i = 0; i < running->NumElements(); i++) {
+            Running r = running->Nth(i);
+            if (r.pid != pid) continue;
+            int32_t answer = status;
+            if (write(r.conn, &answer, sizeof(answer)) < 0) {} // client gone
+            close(r.conn);
+            PrintDebug("daemon", "Request %d: status %d in %.2f ms", (int)pid,
+                       WIFEXITED(status) ? WEXITSTATUS(status) : -WTERMSIG(status),
+                       (Now() - r.started) * 1e3);
+            fflush(stdout);
+            running->RemoveAt(i);
+            break;
+        }
+    }
+}
+
+int ServeCompiles(const char *socketPath, int (*compile)())
+{
+    int listener = Listen(socketPath);
+    if (listener < 0) return 1;
+    if (pipe2(wakeUp, O_CLOEXEC | O_NONBLOCK) != 0) {
+        fprintf(stderr, "dcc: cannot create a pipe: %s\n", strerror(errno));
+        return 1;
+    }
+    signal(SIGPIPE, SIG_IGN);
+    HandleSignals(OnSignal);
+    PrintDebug("daemon", "Listening on %s", socketPath);
+
+    List<Running> running;
+    while (!stopping) {
+        struct pollfd polled[2] = { { wakeUp[0], POLLIN, 0 }, { listener, POLLIN, 0 } };
+        if (poll(polled, 2, -1) < 0) continue;
+        if (polled[0].revents) {
+            char drain[64];
+            while (read(wakeUp[0], drain, sizeof(drain)) > 0) ;
+            Reap(&running, WNOHANG);
+        }
+        if (!polled[1].revents) continue;
+        int conn = accept4(listener, NULL, NULL, SOCK_CLOEXEC);
+        if (conn < 0) continue;
+        if (!SameUser(conn)) {
+            close(conn);
+            continue;
+        }
+        Running r = { 0, conn, Now() };
+        r.pid = ForkCompiler();
+        if (r.pid == 0) {
+            HandleSignals(SIG_DFL);
+            signal(SIGPIPE, SIG_DFL);
+            close(listener);
+            close(wakeUp[0]);
+            close(wakeUp[1]);
+            ServeRequest(conn, compile);
+        }
+        if (r.pid < 0) {
+            fprintf(stderr, "dcc: cannot fork: %s\n", strerror(errno));
+            close(conn);
+        } else
+            running.Append(r);
+    }
+
+    close(listener);
+    unlink(socketPath);
+    Reap(&running, 0);
+    return 0;
+}
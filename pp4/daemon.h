@@ -0,0 +1,79 @@
+/* File: daemon.h
+ * --------------
+ * Compiling on behalf of other processes. dcc -daemon[=socket] listens
+ * on a Unix domain socket (by default DefaultSocketPath below) and
+ * dcc-client, built along with dcc, takes the same arguments as dcc and
+ * has the daemon compile for it instead of starting a compiler of its
+ * own. The client hands over its stdin, stdout and stderr and its
+ * working directory along with its arguments, so the program is read
+ * from, and the diagnostics written to, wherever they would have been,
+ * and the client exits with the status dcc would have had (or dies of
+ * the same signal). If no daemon is listening, the client runs dcc
+ * itself, the one next to it.
+ *
+ * The daemon is started up once, with the compiler loaded and set up,
+ * and forks a copy of itself for each request, which compiles and
+ * exits. Nothing one request leaves behind (interned names, scopes,
+ * error counts, arenas) can get into the next, and several clients are
+ * served at once. Options given to the daemon apply to every request,
+ * before those of the client: dcc -daemon -cache=/some/dir has the
+ * parsed programs of all of them kept in one cache (see astcache.h).
+ *
+ * Only clients of the user the daemon runs as are served. With
+ * -d daemon, each request is reported with its exit status and the
+ * time from accepting it to the end of the compile.
+ */
+
+#ifndef _H_daemon
+#define _H_daemon
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+
+/* A request is this header, sent along with the client's stdin, stdout,
+ * stderr and working directory (SCM_RIGHTS), followed by the arguments
+ * after the program name, each null-terminated, argsLength bytes in
+ * all. The answer is the status of the compile as waitpid() gives it,
+ * 32 bits. */
+static const uint32_t DaemonVersion = 1;
+
+struct DaemonRequest {
+    char magic[4];              // "DREQ"
+    uint32_t version;
+    uint32_t argsLength;
+    uint32_t numArgs;
+};
+
+static const int DaemonNumFds = 4;          // stdin, stdout, stderr, cwd
+
+
+/* Function: DefaultSocketPath()
+ * -----------------------------
+ * Writes to path the socket that the daemon listens on and the client
+ * connects to when not told otherwise: $DCC_SOCKET if it is set, else
+ * one in /tmp for the user.
+ */
+inline void DefaultSocketPath(char *path, size_t size)
+{
+    const char *env = getenv("DCC_SOCKET");
+    if (env && *env)
+        snprintf(path, size, "%s", env);
+    else
+        snprintf(path, size, "/tmp/dcc-%d.socket", (int)getuid());
+}
+
+
+/* Function: ServeCompiles()
+ * -------------------------
+ * Listens on socketPath and, for each request, forks a process that
+ * takes on the client's files and directory, adds its arguments to the
+ * options (see ParseCommandLine) and exits with what compile returns.
+ * Returns the exit status of the daemon, when it is stopped by SIGINT
+ * or SIGTERM or cannot listen.
+ */
+int ServeCompiles(const char *socketPath, int (*compile)());
+
+#endif
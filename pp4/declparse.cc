@@ -0,0 +1,107 @@
+/* File: declparse.cc
+ * ------------------
+ * Implementation of the parallel declaration parser.
+ *
+ * The parser has no global state and the grammar actions only make new
+ * nodes, so declarations can be parsed at the same time. The builtin
+ * types like Type::intType are shared, but nothing is written to them
+ * (see Type::SetParent).
+ */
+
+#include "declparse.h"
+#include <atomic>
+#include <thread>
+#include "tokenstream.h"
+#include "errors.h"
+#include "utility.h" // for PrintDebug()
+
+
+int DeclRange::NextToken(YYSTYPE *val, yyltype *loc)
+{
+    if (next == end)
+        return 0;
+    int code = GetToken(next < start ? start : next, val, loc);
+    return (next++ < start ? T_ParseDecl : code);
+}
+
+
+int DeclRange::GetToken(int index, YYSTYPE *val, yyltype *loc)
+{
+    return GetScannedToken(index, val, loc);
+}
+
+
+/* Cuts the tokens after each ';' outside of braces and after each '}'
+ * that closes the outermost brace (or is unmatched), which in a valid
+ * program is exactly at the end of each declaration. */
+List<DeclRange*> *SplitDecls(int numTokens)
+{
+    List<DeclRange*> *ranges = new List<DeclRange*>;
+    int depth = 0, start = 0;
+    int last = numTokens - 1; // the 0 at the end
+    YYSTYPE val;
+    yyltype loc;
+
+    for (int i = 0; i < last; i++) {
+        bool ends = false;
+        switch (GetScannedToken(i, &val, &loc)) {
+          case '{': depth++; break;
+          case '}': if (depth > 0) depth--; ends = (depth == 0); break;
+          case ';': ends = (depth == 0); break;
+        }
+        if (ends) {
+            ranges->Append(new DeclRange(start, i + 1));
+            start = i + 1;
+        }
+    }
+    if (start < last) // the input ends in the middle of one
+        ranges->Append(new DeclRange(start, last));
+    return ranges;
+}
+
+
+/* Each thread takes the next declaration nobody has taken yet. */
+static void ParseRanges(List<DeclRange*> *ranges, std::atomic<int> *nextRange)
+{
+    int n = ranges->NumElements();
+    for (int i; (i = nextRange->fetch_add(1)) < n; ) {
+        DeclRange *range = ranges->Nth(i);
+        range->parsed = (yyparse(range) == 0);
+    }
+}
+
+
+void ParseDeclsInParallel(int numThreads)
+{
+    if (numThreads < 1) numThreads = 1;
+    PrintDebug("parser", "Parsing declarations on %d threads", numThreads);
+
+    int numTokens = ScanAhead();
+    List<DeclRange*> *ranges = SplitDecls(numTokens);
+    std::atomic<int> nextRange(0);
+    std::thread *threads = new std::thread[numThreads];
+    for (int i = 0; i < numThreads; i++)
+        threads[i] = std::thread(ParseRanges, ranges, &nextRange);
+    for (int i = 0; i < numThreads; i++)
+        threads[i].join();
+    delete[] threads;
+
+    bool parsed = (ranges->NumElements() > 0); // DeclList is not empty
+    for (int i = 0; parsed && i < ranges->NumElements(); i++)
+        parsed = ranges->Nth(i)->parsed;
+    if (!parsed) {
+        PrintDebug("parser", "Parsing again to report syntax errors");
+        yyparse(NULL);
+        return;
+    }
+
+    while (yylex() != 0) // reports the lexical errors in order
+        ;
+    List<Decl*> *decls = new List<Decl*>;
+    for (int i = 0; i < ranges->NumElements(); i++)
+        decls->Append(ranges->Nth(i)->decl);
+    Program *program = new Program(decls);
+    // as in the Program rule: if no errors, advance to next phase
+    if (ReportError::NumErrors() == 0)
+        program->Check();
+}
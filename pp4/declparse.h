@@ -0,0 +1,68 @@
+/* File: declparse.h
+ * -----------------
+ * Parsing the top-level declarations of a program on several threads.
+ * With -parsejobs=N on the command line, the whole input is scanned
+ * first (see ScanAhead in tokenstream.h). A pass over the tokens then
+ * cuts them into declarations: each ends with a ';' outside of braces
+ * or with the '}' that closes its outermost brace. N threads parse
+ * the declarations, each one on its own, and the declarations are put
+ * back together into the Program in source order, as the Program rule
+ * would.
+ *
+ * Nothing is reported while the threads run. When they are done, the
+ * lexical errors are reported in the order of their tokens, and the
+ * program is checked as usual. If any declaration fails to parse,
+ * because it has a syntax error or because a malformed program was cut
+ * in the wrong places, the tokens are parsed again the usual way from
+ * the start, so that exactly the same messages come out as without
+ * -parsejobs.
+ */
+
+#ifndef _H_declparse
+#define _H_declparse
+
+#include "parser.h"
+
+
+/* A declaration, given to yyparse() to parse it on its own. yylex()
+ * then hands out T_ParseDecl, which starts the parse of a single Decl,
+ * followed by the tokens of the declaration. Given to a push parser
+ * (see pushparse.h) instead, it is where the Program rule leaves the
+ * program rather than checking it. */
+struct DeclRange {
+    int start, end;             // token indices, end is past the last
+    int next;                   // the next one for yylex(), start-1 first
+    Decl *decl;                 // the result
+    Program *program;           // the whole program, if it had no errors
+    bool parsed;                // set if the parse succeeded
+    bool reportErrors;          // yyerror() reports syntax errors
+
+    DeclRange(int first, int last)
+      : start(first), end(last), next(first - 1), decl(NULL), program(NULL),
+        parsed(false), reportErrors(false) {}
+    virtual ~DeclRange() {}
+
+    int NextToken(YYSTYPE *val, yyltype *loc);
+
+          // Returns the token at index, from the tokens of ScanAhead()
+          // unless a subclass keeps them elsewhere
+    virtual int GetToken(int index, YYSTYPE *val, yyltype *loc);
+};
+
+
+/* Function: SplitDecls()
+ * -----------------------
+ * Cuts the numTokens tokens of ScanAhead() into declarations, as
+ * described above, before the first call to yylex().
+ */
+List<DeclRange*> *SplitDecls(int numTokens);
+
+
+/* Function: ParseDeclsInParallel()
+ * --------------------------------
+ * Scans and parses all of stdin, using numThreads threads to parse
+ * declarations. Used instead of InitScanner() and yyparse().
+ */
+void ParseDeclsInParallel(int numThreads);
+
+#endif
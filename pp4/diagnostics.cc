@@ -0,0 +1,329 @@
+/* File: diagnostics.cc
+ * --------------------
+ * Implementation of recorded diagnostics and of writing them out.
+ */
+
+#include "diagnostics.h"
+#include <stdlib.h>
+#include <string.h>
+#include "scanner.h" // for GetLineNumbered
+#include "utility.h" // for Failure()
+
+
+static char *Copy(const char *s)
+{
+    return s ? strdup(s) : NULL;
+}
+
+
+static string Plural(int n, const char *word)
+{
+    return std::to_string(n) + " " + word + (n == 1 ? "" : "s");
+}
+
+
+string Diagnostic::Message() const
+{
+    static const char *reasons[] = {"type", "class", "interface", "variable", "function"};
+    string a0 = (args[0] ? args[0] : ""), a1 = (args[1] ? args[1] : ""),
+           a2 = (args[2] ? args[2] : "");
+
+    switch (kind) {
+      case UntermCommentDiag:
+        return "Input ends with unterminated comment";
+      case InvalidDirectiveDiag:
+        return "Invalid # directive";
+      case LongIdentifierDiag:
+        return "Identifier too long: \"" + a0 + "\"";
+      case UntermStringDiag:
+        return "Unterminated string constant: " + a0;
+      case UnrecogCharDiag:
+        return "Unrecognized char: '" + string(1, (char)nums[0]) + "'";
+      case ConstantOutOfRangeDiag:
+        return "Numeric constant out of range: " + a0;
+      case DeclConflictDiag:
+        return "Declaration of '" + a0 + "' here conflicts with declaration on line "
+               + std::to_string(nums[0]);
+      case OverrideMismatchDiag:
+        return "Method '" + a0 + "' must match inherited type signature";
+      case InterfaceNotImplementedDiag:
+        return "Class '" + a0 + "' does not implement entire interface '" + a1 + "'";
+      case IdentifierNotDeclaredDiag:
+        return "No declaration found for " + string(reasons[nums[0]]) + " '" + a0 + "'";
+      case IncompatibleOperandDiag:
+        return "Incompatible operand: " + a0 + " " + a1;
+      case IncompatibleOperandsDiag:
+        return "Incompatible operands: " + a0 + " " + a1 + " " + a2;
+      case ThisOutsideClassScopeDiag:
+        return "'this' is only valid within class scope";
+      case BracketsOnNonArrayDiag:
+        return "[] can only be applied to arrays";
+      case SubscriptNotIntegerDiag:
+        return "Array subscript must be an integer";
+      case NewArraySizeNotIntegerDiag:
+        return "Size for NewArray must be an integer";
+      case NumArgsMismatchDiag:
+        return "Function '" + a0 + "' expects " + Plural(nums[0], "argument")
+               + " but " + std::to_string(nums[1]) + " given";
+      case ArgMismatchDiag:
+        return "Incompatible argument " + std::to_string(nums[0]) + ": " + a0
+               + " given, " + a1 + " expected";
+      case PrintArgMismatchDiag:
+        return "Incompatible argument " + std::to_string(nums[0]) + ": " + a0
+               + " given, int/bool/string expected";
+      case FieldNotFoundInBaseDiag:
+        return a0 + " has no such field '" + a1 + "'";
+      case InaccessibleFieldDiag:
+        return a0 + " field '" + a1 + "' only accessible within class scope";
+      case TestNotBooleanDiag:
+        return "Test expression must have boolean type";
+      case ReturnMismatchDiag:
+        return "Incompatible return: " + a0 + " given, " + a1 + " expected";
+      case BreakOutsideLoopDiag:
+        return "break is only allowed inside a loop";
+      case FormattedDiag:
+        return a0;
+      case ConstantOverflowDiag:
+        return "Overflow in constant expression";
+      case DivisionByZeroDiag:
+        return "Division by zero in constant expression";
+    }
+    return "";
+}
+
+
+static bool SameText(const char *a, const char *b)
+{
+    return a == b || (a && b && strcmp(a, b) == 0);
+}
+
+
+bool Diagnostic::SameMessage(const Diagnostic &other) const
+{
+    return kind == other.kind && nums[0] == other.nums[0] && nums[1] == other.nums[1]
+           && SameText(args[0], other.args[0]) && SameText(args[1], other.args[1])
+           && SameText(args[2], other.args[2]);
+}
+
+
+/* FNV-1a over what goes into the message. */
+unsigned int Diagnostic::Hash() const
+{
+    unsigned int h = 2166136261u;
+    int words[3] = { kind, nums[0], nums[1] };
+    for (int i = 0; i < 3; i++)
+        h = (h ^ words[i]) * 16777619u;
+    for (int i = 0; i < 3; i++)
+        for (const char *p = args[i]; p && *p; p++)
+            h = (h ^ (unsigned char)*p) * 16777619u;
+    return h;
+}
+
+
+static void FreeStrings(const Diagnostic &d)
+{
+    for (int j = 0; j < 3; j++) free(d.args[j]);
+    free(d.line);
+}
+
+
+int DiagnosticBuffer::limit = 0;
+
+
+DiagnosticBuffer::DiagnosticBuffer(bool keep)
+  : elems(NULL), num(0), max(0), numErrors(0), numWarnings(0), keepLines(keep), folding(false),
+    slots(NULL), numSlots(0) {}
+
+
+DiagnosticBuffer::~DiagnosticBuffer()
+{
+    for (int i = 0; i < num; i++)
+        FreeStrings(elems[i]);
+    free(elems);
+    free(slots);
+}
+
+
+Diagnostic *DiagnosticBuffer::FindSameMessage(const Diagnostic &d)
+{
+    if (numSlots == 0)
+        return NULL;
+    for (unsigned int i = d.Hash() & (numSlots - 1); slots[i] >= 0; i = (i + 1) & (numSlots - 1))
+        if (elems[slots[i]].SameMessage(d))
+            return &elems[slots[i]];
+    return NULL;
+}
+
+
+/* The table is kept at most half full, and grown by filling a new one. */
+void DiagnosticBuffer::AddSlot(int index)
+{
+    if (2*(index + 1) > numSlots) {
+        free(slots);
+        numSlots = (numSlots ? 2*numSlots : 64);
+        slots = (int *)malloc(numSlots*sizeof(int));
+        if (!slots) Failure("Out of memory!");
+        memset(slots, -1, numSlots*sizeof(int));
+        for (int i = 0; i < index; i++)
+            AddSlot(i);
+    }
+    unsigned int i = elems[index].Hash() & (numSlots - 1);
+    while (slots[i] >= 0)
+        i = (i + 1) & (numSlots - 1);
+    slots[i] = index;
+}
+
+
+void DiagnosticBuffer::Count(const Diagnostic &d)
+{
+    if (d.IsWarning())
+        numWarnings++;
+    else
+        numErrors++;
+}
+
+
+/* Takes over the strings of d, and frees them if it is not kept. */
+void DiagnosticBuffer::Append(const Diagnostic &d)
+{
+    Count(d);
+    if (Full()) {
+        FreeStrings(d);
+        return;
+    }
+    if (folding) {
+        Diagnostic *same = FindSameMessage(d);
+        if (same) {
+            same->repeats++;
+            same->lastLine = (d.located ? d.loc.first_line : 0);
+            FreeStrings(d);
+            return;
+        }
+    }
+    if (num == max) {
+        max = (max ? 2*max : 16);
+        elems = (Diagnostic *)realloc(elems, max*sizeof(Diagnostic));
+        if (!elems) Failure("Out of memory!");
+    }
+    elems[num] = d;
+    if (keepLines && d.located && !d.line)
+        elems[num].line = Copy(GetLineNumbered(d.loc.first_line));
+    if (folding)
+        AddSlot(num);
+    num++;
+}
+
+
+void DiagnosticBuffer::Add(DiagnosticKind kind, yyltype *loc, const char *arg0,
+                           const char *arg1, const char *arg2, int num0, int num1)
+{
+    Diagnostic d;
+    d.kind = kind;
+    if (Full()) { // not even worth copying
+        Count(d);
+        return;
+    }
+    d.located = (loc != NULL);
+    if (loc) d.loc = *loc;
+    d.args[0] = Copy(arg0);
+    d.args[1] = Copy(arg1);
+    d.args[2] = Copy(arg2);
+    d.nums[0] = num0;
+    d.nums[1] = num1;
+    d.line = NULL;
+    d.repeats = 0;
+    d.lastLine = 0;
+    Append(d);
+}
+
+
+/* The strings go along with the diagnostics, other is left with none.
+ * What other recorded but did not keep is still counted. */
+void DiagnosticBuffer::TakeAll(DiagnosticBuffer *other)
+{
+    int keptErrors = 0, keptWarnings = 0;
+    for (int i = 0; i < other->num; i++) {
+        if (other->elems[i].IsWarning())
+            keptWarnings++;
+        else
+            keptErrors++;
+        Append(other->elems[i]);
+    }
+    numErrors += other->numErrors - keptErrors;
+    numWarnings += other->numWarnings - keptWarnings;
+    other->num = 0;
+}
+
+
+static void AppendInt(string *out, int n)
+{
+    char digits[16];
+    int len = snprintf(digits, sizeof(digits), "%d", n);
+    out->append(digits, len);
+}
+
+
+/* Each message as it used to be written by itself:
+ *
+ *   *** Error line 3.
+ *   int x = y;
+ *           ^
+ *   *** No declaration found for variable 'y'
+ *
+ * all of them into one string written at once. */
+void DiagnosticBuffer::Write(FILE *fp)
+{
+    string out;
+    out.reserve(num*160);
+    for (int i = 0; i < num; i++) {
+        Diagnostic *d = &elems[i];
+        const char *what = (d->IsWarning() ? "Warning" : "Error");
+        if (d->located) {
+            out += "\n*** ";
+            out += what;
+            out += " line ";
+            AppendInt(&out, d->loc.first_line);
+            out += ".\n";
+            if (d->line) {
+                out += d->line;
+                out += '\n';
+                int first = (d->loc.first_column < 1 ? 1 : d->loc.first_column);
+                if (d->loc.last_column >= first) {
+                    out.append(first - 1, ' ');
+                    out.append(d->loc.last_column - first + 1, '^');
+                } else if (d->loc.last_column > 0)
+                    out.append(d->loc.last_column, ' ');
+                out += '\n';
+            }
+        } else {
+            out += "\n*** ";
+            out += what;
+            out += ".\n";
+        }
+        out += "*** ";
+        out += d->Message();
+        out += '\n';
+        if (d->repeats > 0) {
+            out += "*** (";
+            AppendInt(&out, d->repeats);
+            out += " more like it";
+            if (d->lastLine > 0) {
+                out += ", the last on line ";
+                AppendInt(&out, d->lastLine);
+            }
+            out += ")\n";
+        }
+        out += '\n';
+        FreeStrings(*d);
+    }
+    if (Full()) {
+        out += "\n*** Stopped after ";
+        AppendInt(&out, limit);
+        out += " errors (-maxerrors)\n\n";
+    }
+    num = 0;
+    if (numSlots > 0)
+        memset(slots, -1, numSlots*sizeof(int));
+    fwrite(out.data(), 1, out.size(), fp);
+    fflush(fp);
+}
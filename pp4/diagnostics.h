@@ -0,0 +1,144 @@
+/* File: diagnostics.h
+ * -------------------
+ * The diagnostics ReportError records. Nothing is written out when an
+ * error is reported: what kind of error it is, where, and the names,
+ * types and numbers that go in its message are recorded as a Diagnostic
+ * in a DiagnosticBuffer. Messages are only made from them when a buffer
+ * is written, all of them at once, with a single write.
+ *
+ * Each thread records into a buffer of its own choosing (see
+ * ReportError::RecordTo), the program's own buffer unless it says
+ * otherwise. A thread checking one part of a program records into a
+ * buffer of its own, and the buffers of the parts are appended to the
+ * program's in source order once all of them are done, so what is
+ * written does not depend on which part was done first. The program's
+ * buffer is written out when it ends (ReportError::Flush).
+ *
+ * The source line shown under a message is copied into the diagnostic
+ * when it gets to a buffer that keeps lines, the program's. Lines are
+ * not kept everywhere for as long as the program runs (see stream.h),
+ * and looking them up is not something threads can do at once.
+ *
+ * Warnings are recorded the same way but written as warnings, and do
+ * not count as errors.
+ *
+ * For inputs with a great many errors there are two ways to cut down
+ * what is kept and written:
+ *
+ *   -maxerrors=N  No buffer keeps more than the first N diagnostics
+ *                 recorded into it, and checking stops once N are
+ *                 recorded (see ReportError::LimitReached), with a
+ *                 note at the end saying so.
+ *   -fold         A buffer that folds keeps only the first of the
+ *                 diagnostics that have the same message, and writes it
+ *                 with how many more there were and where the last one
+ *                 was. The program's buffer folds; those of the parts
+ *                 of a program checked on their own do not, so the
+ *                 ones folded and their counts are the same as when it
+ *                 is checked all at once.
+ */
+
+#ifndef _H_diagnostics
+#define _H_diagnostics
+
+#include <stdio.h>
+#include <string>
+using std::string;
+#include "location.h"
+
+
+/* One for each of the methods of ReportError. */
+typedef enum {
+    UntermCommentDiag, InvalidDirectiveDiag, LongIdentifierDiag,
+    UntermStringDiag, UnrecogCharDiag, ConstantOutOfRangeDiag,
+    DeclConflictDiag, OverrideMismatchDiag, InterfaceNotImplementedDiag,
+    IdentifierNotDeclaredDiag, IncompatibleOperandDiag,
+    IncompatibleOperandsDiag, ThisOutsideClassScopeDiag,
+    BracketsOnNonArrayDiag, SubscriptNotIntegerDiag,
+    NewArraySizeNotIntegerDiag, NumArgsMismatchDiag, ArgMismatchDiag,
+    PrintArgMismatchDiag, FieldNotFoundInBaseDiag, InaccessibleFieldDiag,
+    TestNotBooleanDiag, ReturnMismatchDiag, BreakOutsideLoopDiag,
+    FormattedDiag,
+    ConstantOverflowDiag, DivisionByZeroDiag  // warnings, the rest are errors
+} DiagnosticKind;
+
+
+/* A diagnostic owns its strings, which are malloc'd. */
+struct Diagnostic {
+    DiagnosticKind kind;
+    bool located;
+    yyltype loc;
+    char *args[3];              // names, types and operators as printed
+    int nums[2];                // line numbers, counts, argument indices
+    char *line;                 // the source line at loc, once known
+    int repeats;                // how many more were folded into it
+    int lastLine;               // where the last of them was
+
+          // The text of the message, after the "*** "
+    string Message() const;
+    bool IsWarning() const { return kind >= ConstantOverflowDiag; }
+    bool SameMessage(const Diagnostic &other) const;
+    unsigned int Hash() const;
+};
+
+
+/* Class: DiagnosticBuffer
+ * -----------------------
+ * Diagnostics in the order they were recorded.
+ */
+class DiagnosticBuffer
+{
+  protected:
+    Diagnostic *elems;          // grown as needed
+    int num, max;
+    int numErrors, numWarnings;
+    bool keepLines, folding;
+    int *slots;                 // open hash of elems by message, if folding
+    int numSlots;
+
+    void Count(const Diagnostic &d);
+    void Append(const Diagnostic &d);
+    Diagnostic *FindSameMessage(const Diagnostic &d);
+    void AddSlot(int index);
+
+  public:
+    static int limit;           // the most a buffer keeps, 0 for no limit
+
+    DiagnosticBuffer(bool keepLines = false);
+    ~DiagnosticBuffer();
+
+    void SetFolding(bool on) { folding = on; }
+
+          // Records a diagnostic of kind at loc (which may be NULL). The
+          // arguments are copied, those left NULL are not used by kind.
+    void Add(DiagnosticKind kind, yyltype *loc, const char *arg0 = NULL,
+             const char *arg1 = NULL, const char *arg2 = NULL,
+             int num0 = 0, int num1 = 0);
+
+          // Adds all of other's diagnostics after these and empties it
+    void TakeAll(DiagnosticBuffer *other);
+
+          // All errors (or warnings) that were ever added, written,
+          // folded, or not kept
+    int NumErrors() { return numErrors; }
+    int NumWarnings() { return numWarnings; }
+    bool Full() { return limit > 0 && numErrors >= limit; }
+
+          // The diagnostics kept and not yet written, in order, for
+          // saving them elsewhere (see incremental.h)
+    int NumKept() { return num; }
+    const Diagnostic &Kept(int index) { return elems[index]; }
+
+          // Counts errors and warnings that were recorded somewhere else
+          // but not kept there, as TakeAll does for those of other
+    void CountNotKept(int errors, int warnings) {
+        numErrors += errors;
+        numWarnings += warnings;
+    }
+
+          // Writes the messages of those not yet written to fp, with
+          // their source lines underlined, and lets go of them
+    void Write(FILE *fp);
+};
+
+#endif
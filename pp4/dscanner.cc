@@ -0,0 +1,415 @@
+/* File: dscanner.cc
+ * -----------------
+ * Implementation of the direct-coded scanner. The comments on each
+ * case name the rule of scanner.l it stands in for; where two rules
+ * could match, the choice follows lex's longest-match-then-first-rule
+ * policy.
+ */
+
+#include "dscanner.h"
+#include <string.h>
+#include <stdlib.h>
+#include <limits.h>
+#include "errors.h"
+#include "keywords.h"
+#include "fastscan.h"
+#include "numbers.h"
+#include "utility.h" // for PrintDebug(), Failure()
+
+
+static inline bool IsDigit(char ch)    { return ch >= '0' && ch <= '9'; }
+static inline bool IsLetter(char ch)   { return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z'); }
+static inline bool IsHexDigit(char ch) { return IsDigit(ch) || ((ch|0x20) >= 'a' && (ch|0x20) <= 'f'); }
+
+
+DirectScanner::DirectScanner(List<const char*> *savedLines)
+{
+    lines = savedLines;
+    names = &identifierNames;
+    literals = &stringLiterals;
+    SetInput("", 0);
+}
+
+
+void DirectScanner::SetInput(const char *text, int len)
+{
+    cur = text;
+    end = text + len;
+    lineNum = 1;
+    colNum = 1;
+    inComment = false;
+    copyPending = true; // copy first line at start
+    moreInput = false;
+}
+
+
+void DirectScanner::AddInput(const char *text, int len, bool more)
+{
+    Assert(cur == end);
+    Assert(!more || (len > 0 && text[len-1] == '\n'));
+    cur = text;
+    end = text + len;
+    moreInput = more;
+}
+
+
+/* Method: Match
+ * -------------
+ * Consumes len characters as one lexeme. This is the counterpart of
+ * DoBeforeEachAction() in scanner.l and records the location the same way.
+ */
+void DirectScanner::Match(yyltype *loc, int len)
+{
+    loc->first_line = lineNum;
+    loc->first_column = colNum;
+    loc->last_column = colNum + len - 1;
+    colNum += len;
+    cur += len;
+}
+
+
+/* Method: SkipRun
+ * ---------------
+ * Same as SkipAhead() in scanner.l: lets a bulk routine consume the rest
+ * of a run of blanks or comment text.
+ */
+void DirectScanner::SkipRun(yyltype *loc, const char *(*skip)(const char *, const char *, int *))
+{
+    const char *start = cur;
+    cur = skip(cur, end, &colNum);
+    if (cur != start)
+        loc->last_column = colNum - 1;
+}
+
+
+/* Method: SaveLine
+ * ----------------
+ * The <COPY>.* rule: copies the line about to be scanned.
+ */
+void DirectScanner::SaveLine(yyltype *loc)
+{
+    const char *nl = (const char *)memchr(cur, '\n', end - cur);
+    int len = (nl ? nl : end) - cur;
+
+    loc->first_line = lineNum;
+    loc->first_column = colNum;
+    loc->last_column = colNum + len - 1;
+    colNum = 1;
+    if (lines) lines->Append(strndup(cur, len));
+    copyPending = false;
+}
+
+
+int DirectScanner::Scan(YYSTYPE *val, yyltype *loc)
+{
+    for (;;) {
+        if (cur == end && moreInput)
+            return 0;                             // wait for AddInput()
+
+        if (copyPending) {
+            if (cur == end)                       // <COPY><<EOF>>
+                copyPending = false;
+            else if (*cur != '\n')
+                SaveLine(loc);
+        }
+
+        if (cur == end) {
+            if (inComment)                        // <COMM><<EOF>>
+                LexError(UntermCommentError, NULL, NULL, 0);
+            return 0;
+        }
+
+        char ch = *cur;
+        char next = (cur + 1 < end ? cur[1] : '\0');
+
+        if (ch == '\n') {                         // <*>\n
+            Match(loc, 1);
+            lineNum++;
+            colNum = 1;
+            if (copyPending) { if (lines) lines->Append(""); }
+            else copyPending = true;
+            continue;
+        }
+
+        if (ch == '\t') {                         // <*>[\t]
+            Match(loc, 1);
+            colNum += TAB_SIZE - colNum%TAB_SIZE + 1;
+            SkipRun(loc, inComment ? SkipCommentText : SkipBlanks);
+            continue;
+        }
+
+        if (inComment) {
+            if (ch == '*' && next == '/') {       // <COMM>{END_COMMENT}
+                Match(loc, 2);
+                inComment = false;
+            } else {                              // <COMM>.
+                Match(loc, 1);
+                SkipRun(loc, SkipCommentText);
+            }
+            continue;
+        }
+
+        if (IsLetter(ch))
+            return ScanWord(val, loc);
+        if (IsDigit(ch))
+            return ScanNumber(val, loc);
+
+        switch (ch) {
+          case ' ':                               // [ ]
+            Match(loc, 1);
+            SkipRun(loc, SkipBlanks);
+            continue;
+
+          case '"':                               // {STRING}, {BEG_STRING}
+            if (ScanString(val, loc))
+                return T_StringConstant;
+            continue;
+
+          case '/':
+            if (next == '*') {                    // {BEG_COMMENT}
+                Match(loc, 2);
+                inComment = true;
+                continue;
+            }
+            if (next == '/') {                    // {SINGLE_COMMENT}
+                const char *nl = (const char *)memchr(cur, '\n', end - cur);
+                Match(loc, (nl ? nl : end) - cur);
+                continue;
+            }
+            break;
+
+          case '<': if (next == '=') { Match(loc, 2); return T_LessEqual; }    break;
+          case '>': if (next == '=') { Match(loc, 2); return T_GreaterEqual; } break;
+          case '=': if (next == '=') { Match(loc, 2); return T_Equal; }        break;
+          case '!': if (next == '=') { Match(loc, 2); return T_NotEqual; }     break;
+          case '[': if (next == ']') { Match(loc, 2); return T_Dims; }         break;
+          case '+': if (next == '+') { Match(loc, 2); return T_Incr; }         break;
+          case '-': if (next == '-') { Match(loc, 2); return T_Decr; }         break;
+          case '&': if (next == '&') { Match(loc, 2); return T_And; }          break;
+          case '|': if (next == '|') { Match(loc, 2); return T_Or; }           break;
+          case ':': Match(loc, 1); return T_Colon;
+        }
+
+        if (strchr("-+/*%=.,;!<>()[]{}", ch) != NULL && ch != '\0') {
+            Match(loc, 1);                        // {OPERATOR}
+            return ch;
+        }
+
+        Match(loc, 1);                            // . (error)
+        LexError(UnrecogCharError, loc, cur - 1, 1);
+    }
+}
+
+
+/* Method: LexError
+ * ----------------
+ * The default is to report errors as they are found, like scanner.l.
+ */
+void DirectScanner::LexError(LexErrorKind kind, yyltype *loc, const char *text, int len)
+{
+    char *copy = (text ? strndup(text, len) : NULL);
+    ReportLexError(kind, loc, copy);
+    free(copy);
+}
+
+
+void ReportLexError(LexErrorKind kind, yyltype *loc, const char *text)
+{
+    switch (kind) {
+      case LongIdentifierError:     ReportError::LongIdentifier(loc, text);     break;
+      case UntermStringError:       ReportError::UntermString(loc, text);       break;
+      case UnrecogCharError:        ReportError::UnrecogChar(loc, text[0]);     break;
+      case ConstantOutOfRangeError: ReportError::ConstantOutOfRange(loc, text); break;
+      case UntermCommentError:      ReportError::UntermComment();               break;
+    }
+}
+
+
+char *ReadInput(FILE *fp, int *len)
+{
+    size_t size = 0, capacity = 1 << 16, n;
+    char *text = (char *)malloc(capacity);
+    while (text && (n = fread(text + size, 1, capacity - size, fp)) > 0) {
+        size += n;
+        if (size > INT_MAX)
+            Failure("Input too large, the limit is %d bytes", INT_MAX);
+        if (size == capacity)
+            text = (char *)realloc(text, capacity *= 2);
+    }
+    if (!text)
+        Failure("Out of memory reading the input (%zu bytes)", capacity);
+    *len = size;
+    return text;
+}
+
+
+/* The text given to TakeLinesFrom(), with the offset of every LineStep'th
+ * line, noted when first needed. */
+static const char *linesText;
+static int linesLength;
+static const int LineStep = 64;
+static List<int> lineOffsets;
+
+static const char *LineOfText(int num)
+{
+    static char *line = NULL;
+    const char *end = linesText + linesLength;
+
+    if (lineOffsets.NumElements() == 0) {
+        int n = 0;
+        for (const char *p = linesText; p; n++) {
+            if (n % LineStep == 0) lineOffsets.Append(p - linesText);
+            p = (const char *)memchr(p, '\n', end - p);
+            if (p) p++;
+        }
+    }
+    if (num <= 0 || (num - 1) / LineStep >= lineOffsets.NumElements()) return NULL;
+    const char *p = linesText + lineOffsets.Nth((num - 1) / LineStep);
+    for (int i = (num - 1) % LineStep; i > 0; i--) {
+        p = (const char *)memchr(p, '\n', end - p);
+        if (!p) return NULL;
+        p++;
+    }
+    if (p == end) return NULL; // the scanner never gets to copy it
+    const char *nl = (const char *)memchr(p, '\n', end - p);
+    free(line);
+    line = strndup(p, (nl ? nl : end) - p);
+    return line;
+}
+
+
+void TakeLinesFrom(const char *text, int len)
+{
+    linesText = text;
+    linesLength = len;
+    lineOffsets.Clear();
+    lineSource = LineOfText;
+}
+
+
+/* Method: ScanWord
+ * ----------------
+ * The {IDENTIFIER} rule, keywords included.
+ */
+int DirectScanner::ScanWord(YYSTYPE *val, yyltype *loc)
+{
+    const char *start = cur;
+    int len = SkipIdentChars(cur + 1, end) - cur;
+    Match(loc, len);
+
+    int token = LookupKeyword(start, len);
+    if (token == T_BoolConstant)
+        val->boolConstant = (start[0] == 't');
+    if (token != T_Identifier)
+        return token;
+
+    if (len > MaxIdentLen) {
+        LexError(LongIdentifierError, loc, start, len);
+        len = MaxIdentLen;
+    }
+    val->identifier = names->Intern(start, len);
+    return T_Identifier;
+}
+
+
+/* Method: ScanNumber
+ * ------------------
+ * The {HEX_INTEGER}, {INTEGER} and {DOUBLE} rules. A hex prefix needs at
+ * least one hex digit after it, a double needs digits before the point,
+ * and an exponent is only part of the double if it has digits.
+ */
+int DirectScanner::ScanNumber(YYSTYPE *val, yyltype *loc)
+{
+    const char *p = cur;
+    int token = T_IntConstant;
+
+    if (p[0] == '0' && end - p > 2 && (p[1] == 'x' || p[1] == 'X') && IsHexDigit(p[2])) {
+        for (p += 2; p < end && IsHexDigit(*p); p++) ;
+    } else {
+        while (p < end && IsDigit(*p)) p++;
+        if (p < end && *p == '.') {
+            token = T_DoubleConstant;
+            for (p++; p < end && IsDigit(*p); p++) ;
+            if (p < end && (*p == 'E' || *p == 'e')) {
+                const char *q = p + 1;
+                if (q < end && (*q == '+' || *q == '-')) q++;
+                if (q < end && IsDigit(*q)) {
+                    while (q < end && IsDigit(*q)) q++;
+                    p = q;
+                }
+            }
+        }
+    }
+
+    const char *start = cur;
+    int len = p - cur;
+    Match(loc, len);
+    bool inRange = (token == T_DoubleConstant ? ParseDouble(start, len, &val->doubleConstant)
+                                              : ParseInteger(start, len, &val->integerConstant));
+    if (!inRange)
+        LexError(ConstantOutOfRangeError, loc, start, len);
+    return token;
+}
+
+
+/* Method: ScanString
+ * ------------------
+ * The {STRING} and {BEG_STRING} rules. Returns true if a complete string
+ * constant was scanned, else reports it as unterminated.
+ */
+bool DirectScanner::ScanString(YYSTYPE *val, yyltype *loc)
+{
+    const char *p = cur + 1;
+    while (p < end && *p != '"' && *p != '\n') p++;
+
+    bool terminated = (p < end && *p == '"');
+    int len = p - cur + (terminated ? 1 : 0);
+    const char *start = cur;
+    Match(loc, len);
+
+    if (terminated) {
+        val->stringConstant = literals->Intern(start, len);
+        return true;
+    }
+    LexError(UntermStringError, loc, start, len);
+    return false;
+}
+
+
+#ifdef DIRECT_SCANNER
+
+/* The scanner interface of scanner.h
+ * ----------------------------------
+ * With SCANNER=direct these take the place of the functions and globals
+ * otherwise defined in scanner.l. The input is read from stdin as a whole
+ * before scanning starts.
+ */
+List<const char*> savedLines;
+const char *(*lineSource)(int n) = NULL;
+static DirectScanner *scanner;
+
+
+void InitScanner()
+{
+    PrintDebug("lex", "Initializing scanner");
+
+    int size;
+    char *text = ReadInput(stdin, &size);
+    scanner = new DirectScanner(&savedLines);
+    scanner->SetInput(text, size);
+}
+
+
+int ScanToken()
+{
+    return scanner->Scan(&yylval, &yylloc);
+}
+
+
+const char *GetLineNumbered(int num) {
+   if (lineSource) return lineSource(num);
+   if (num <= 0 || num > savedLines.NumElements()) return NULL;
+   return savedLines.Nth(num-1);
+}
+
+#endif
@@ -0,0 +1,108 @@
+/* File: dscanner.h
+ * ----------------
+ * A hand-written, direct-coded scanner that recognizes exactly the
+ * tokens of scanner.l. Instead of running a table-driven DFA it
+ * dispatches on the first character of each lexeme and consumes the
+ * rest with tight loops (and the bulk routines of fastscan.h). It
+ * keeps the same line and column bookkeeping as the lex rules, copies
+ * each line for error context the way the COPY state does and reports
+ * the same errors, so both scanners yield the same tokens, locations
+ * and messages for any input.
+ *
+ * All of its state lives in the object, so several inputs can be
+ * scanned independently, on different threads if need be, as long as
+ * errors are not reported directly (see LexError). Building with
+ * SCANNER=direct (see Makefile) makes it the scanner behind yylex() in
+ * place of the flex one.
+ */
+
+#ifndef _H_dscanner
+#define _H_dscanner
+
+#include <stdio.h>
+#include "list.h"
+#include "strpool.h"
+#include "parser.h" // for YYSTYPE and token codes
+
+
+/* The lexical errors, one for each scanner method of ReportError */
+typedef enum { LongIdentifierError, UntermStringError, UnrecogCharError,
+               ConstantOutOfRangeError, UntermCommentError } LexErrorKind;
+
+/* Function: ReportLexError()
+ * --------------------------
+ * Reports a lexical error through ReportError. text is the offending
+ * lexeme (null-terminated), loc and text are NULL for UntermCommentError.
+ */
+void ReportLexError(LexErrorKind kind, yyltype *loc, const char *text);
+
+
+/* Function: ReadInput()
+ * ---------------------
+ * Reads everything from fp into a malloc'ed buffer and stores its size
+ * in *len. The buffer is not null-terminated. Fails (see utility.h) if
+ * the input does not fit in memory or is more than INT_MAX bytes.
+ */
+char *ReadInput(FILE *fp, int *len);
+
+
+/* Function: TakeLinesFrom()
+ * -------------------------
+ * Makes GetLineNumbered() look the lines up in text, which must stay
+ * valid, rather than among those saved while scanning. For callers
+ * that do not scan the input the usual way, or at all.
+ */
+void TakeLinesFrom(const char *text, int len);
+
+
+class DirectScanner
+{
+  protected:
+    const char *cur, *end;      // unscanned part of the input
+    int lineNum, colNum;        // position of cur
+    bool inComment;             // inside a /* */ comment (COMM state)
+    bool copyPending;           // current line not yet saved (COPY state)
+    bool moreInput;             // end is not the end of the input
+    List<const char*> *lines;   // where the lines read are saved
+    StringPool *names;          // where identifiers are interned
+    StringPool *literals;       // where string constants are interned
+
+  public:
+          // Creates a scanner that appends each line it reads to the
+          // given list (which may be NULL if the lines are not wanted)
+    DirectScanner(List<const char*> *savedLines);
+    virtual ~DirectScanner() {}
+
+          // Sets the text to scan, which must stay valid while in use,
+          // and resets the position to the first column of line 1
+    void SetInput(const char *text, int len);
+
+          // Gives the scanner the text that follows the text it has
+          // scanned up to its end. If more is true, there is more input
+          // after this text, which must then end in a newline; Scan
+          // returns 0 at its end and resumes with the next AddInput.
+          // Only the text not yet scanned needs to stay valid.
+    void AddInput(const char *text, int len, bool more);
+
+          // Scans the next token, filling in its value and location.
+          // Returns the token code, or 0 at the end of the input.
+    int Scan(YYSTYPE *val, yyltype *loc);
+
+  protected:
+          // Called for each lexical error with the len chars of text it
+          // is about. Reports the error right away, a subclass may
+          // override this to defer it.
+    virtual void LexError(LexErrorKind kind, yyltype *loc, const char *text, int len);
+
+  private:
+    void Match(yyltype *loc, int len);
+    void SkipRun(yyltype *loc, const char *(*skip)(const char *, const char *, int *));
+    void SaveLine(yyltype *loc);
+
+    int ScanNumber(YYSTYPE *val, yyltype *loc);
+    int ScanWord(YYSTYPE *val, yyltype *loc);
+    bool ScanString(YYSTYPE *val, yyltype *loc);
+};
+
+
+#endif
@@ -4,202 +4,215 @@
  */
 
 #include "errors.h"
-#include <iostream>
 #include <sstream>
 #include <stdarg.h>
 #include <stdio.h>
 using namespace std;
 
-#include "scanner.h" // for GetLineNumbered
 #include "ast_type.h"
 #include "ast_expr.h"
 #include "ast_stmt.h"
 #include "ast_decl.h"
+#include "declparse.h" // for DeclRange
 
 
-int ReportError::numErrors = 0;
+static DiagnosticBuffer programDiagnostics(true);
+static thread_local DiagnosticBuffer *recording = NULL;
 
-void ReportError::UnderlineErrorInLine(const char *line, yyltype *pos) {
-    if (!line) return;
-    cerr << line << endl;
-    for (int i = 1; i <= pos->last_column; i++)
-        cerr << (i >= pos->first_column ? '^' : ' ');
-    cerr << endl;
+
+DiagnosticBuffer *ReportError::Recording() {
+    return recording ? recording : &programDiagnostics;
+}
+
+
+int ReportError::NumErrors() {
+    return Recording()->NumErrors();
 }
 
 
+void ReportError::RecordTo(DiagnosticBuffer *buffer) {
+    recording = buffer;
+}
+
+
+void ReportError::AddAll(DiagnosticBuffer *buffer) {
+    Recording()->TakeAll(buffer);
+}
+
+
+void ReportError::SetFolding(bool on) {
+    programDiagnostics.SetFolding(on);
+}
 
-void ReportError::OutputError(yyltype *loc, string msg) {
-    numErrors++;
+
+void ReportError::Flush() {
     fflush(stdout); // make sure any buffered text has been output
-    if (loc) {
-        cerr << endl << "*** Error line " << loc->first_line << "." << endl;
-        UnderlineErrorInLine(GetLineNumbered(loc->first_line), loc);
-    } else
-        cerr << endl << "*** Error." << endl;
-    cerr << "*** " << msg << endl << endl;
+    programDiagnostics.Write(stderr);
+}
+
+
+/* How a node prints itself, for the arguments of a diagnostic. */
+template <class Printable> static string Printed(Printable *p) {
+    stringstream s;
+    s << p;
+    return s.str();
 }
 
 
 void ReportError::Formatted(yyltype *loc, const char *format, ...) {
     va_list args;
-    char errbuf[2048];
 
     va_start(args, format);
-    vsprintf(errbuf,format, args);
+    int len = vsnprintf(NULL, 0, format, args);
     va_end(args);
-    OutputError(loc, errbuf);
+    string msg(len, '\0');
+    va_start(args, format);
+    vsnprintf(&msg[0], len + 1, format, args);
+    va_end(args);
+    Recording()->Add(FormattedDiag, loc, msg.c_str());
 }
 
 
 void ReportError::UntermComment() {
-    OutputError(NULL, "Input ends with unterminated comment");
+    Recording()->Add(UntermCommentDiag, NULL);
 }
 
 
 void ReportError::InvalidDirective(int linenum) {
     yyltype ll = {0, linenum, 0, 0};
-    OutputError(&ll, "Invalid # directive");
+    Recording()->Add(InvalidDirectiveDiag, &ll);
 }
 
 
 void ReportError::LongIdentifier(yyltype *loc, const char *ident) {
-    stringstream s;
-    s << "Identifier too long: \"" << ident << "\"";
-    OutputError(loc, s.str());
+    Recording()->Add(LongIdentifierDiag, loc, ident);
 }
 
 
 void ReportError::UntermString(yyltype *loc, const char *str) {
-    stringstream s;
-    s << "Unterminated string constant: " << str;
-    OutputError(loc, s.str());
+    Recording()->Add(UntermStringDiag, loc, str);
 }
 
 
 void ReportError::UnrecogChar(yyltype *loc, char ch) {
-    stringstream s;
-    s << "Unrecognized char: '" << ch << "'" ;
-    OutputError(loc, s.str());
+    Recording()->Add(UnrecogCharDiag, loc, NULL, NULL, NULL, (unsigned char)ch);
+}
+
+
+void ReportError::ConstantOutOfRange(yyltype *loc, const char *num) {
+    Recording()->Add(ConstantOutOfRangeDiag, loc, num);
 }
 
 
 void ReportError::DeclConflict(Decl *decl, Decl *prevDecl) {
-    stringstream s;
-    s << "Declaration of '" << decl << "' here conflicts with declaration on line "
-      << prevDecl->GetLocation()->first_line;
-    OutputError(decl->GetLocation(), s.str());
+    Recording()->Add(DeclConflictDiag, decl->GetLocation(), decl->Name(), NULL, NULL,
+                     prevDecl->GetLocation()->first_line);
 }
 
 
 void ReportError::OverrideMismatch(Decl *fnDecl) {
-    stringstream s;
-    s << "Method '" << fnDecl << "' must match inherited type signature";
-    OutputError(fnDecl->GetLocation(), s.str());
+    Recording()->Add(OverrideMismatchDiag, fnDecl->GetLocation(), fnDecl->Name());
 }
 
 
 void ReportError::InterfaceNotImplemented(Decl *cd, Type *interfaceType) {
-    stringstream s;
-    s << "Class '" << cd << "' does not implement entire interface '" << interfaceType << "'";
-    OutputError(interfaceType->GetLocation(), s.str());
+    Recording()->Add(InterfaceNotImplementedDiag, interfaceType->GetLocation(),
+                     cd->Name(), Printed(interfaceType).c_str());
 }
 
 
 void ReportError::IdentifierNotDeclared(Identifier *ident, reasonT whyNeeded) {
-    stringstream s;
-    static const char *names[] =  {"type", "class", "interface", "variable", "function"};
-    Assert(whyNeeded >= 0 && whyNeeded <= sizeof(names)/sizeof(names[0]));
-    s << "No declaration found for "<< names[whyNeeded] << " '" << ident << "'";
-    OutputError(ident->GetLocation(), s.str());
+    Assert(whyNeeded >= LookingForType && whyNeeded <= LookingForFunction);
+    Recording()->Add(IdentifierNotDeclaredDiag, ident->GetLocation(), ident->Name(),
+                     NULL, NULL, whyNeeded);
 }
 
 
 void ReportError::IncompatibleOperands(Operator *op, Type *lhs, Type *rhs) {
-    stringstream s;
-    s << "Incompatible operands: " << lhs << " " << op << " " << rhs;
-    OutputError(op->GetLocation(), s.str());
+    Recording()->Add(IncompatibleOperandsDiag, op->GetLocation(), Printed(lhs).c_str(),
+                     Printed(op).c_str(), Printed(rhs).c_str());
 }
 
 
 void ReportError::IncompatibleOperand(Operator *op, Type *rhs) {
-    stringstream s;
-    s << "Incompatible operand: " << op << " " << rhs;
-    OutputError(op->GetLocation(), s.str());
+    Recording()->Add(IncompatibleOperandDiag, op->GetLocation(), Printed(op).c_str(),
+                     Printed(rhs).c_str());
 }
 
 
 void ReportError::ThisOutsideClassScope(This *th) {
-    OutputError(th->GetLocation(), "'this' is only valid within class scope");
+    Recording()->Add(ThisOutsideClassScopeDiag, th->GetLocation());
 }
 
 
 void ReportError::BracketsOnNonArray(Expr *baseExpr) {
-    OutputError(baseExpr->GetLocation(), "[] can only be applied to arrays");
+    Recording()->Add(BracketsOnNonArrayDiag, baseExpr->GetLocation());
 }
 
 
 void ReportError::SubscriptNotInteger(Expr *subscriptExpr) {
-    OutputError(subscriptExpr->GetLocation(), "Array subscript must be an integer");
+    Recording()->Add(SubscriptNotIntegerDiag, subscriptExpr->GetLocation());
 }
 
 
 void ReportError::NewArraySizeNotInteger(Expr *sizeExpr) {
-    OutputError(sizeExpr->GetLocation(), "Size for NewArray must be an integer");
+    Recording()->Add(NewArraySizeNotIntegerDiag, sizeExpr->GetLocation());
 }
 
 
 void ReportError::NumArgsMismatch(Identifier *fnIdent, int numExpected, int numGiven) {
-    stringstream s;
-    s << "Function '"<< fnIdent << "' expects " << numExpected << " argument" << (numExpected==1?"":"s")
-      << " but " << numGiven << " given";
-    OutputError(fnIdent->GetLocation(), s.str());
+    Recording()->Add(NumArgsMismatchDiag, fnIdent->GetLocation(), fnIdent->Name(),
+                     NULL, NULL, numExpected, numGiven);
 }
 
 
 void ReportError::ArgMismatch(Expr *arg, int argIndex, Type *given, Type *expected) {
-  stringstream s;
-  s << "Incompatible argument " << argIndex << ": " << given << " given, " << expected << " expected";
-  OutputError(arg->GetLocation(), s.str());
+    Recording()->Add(ArgMismatchDiag, arg->GetLocation(), Printed(given).c_str(),
+                     Printed(expected).c_str(), NULL, argIndex);
 }
 
 
 void ReportError::ReturnMismatch(ReturnStmt *rStmt, Type *given, Type *expected) {
-    stringstream s;
-    s << "Incompatible return: " << given << " given, " << expected << " expected";
-    OutputError(rStmt->GetLocation(), s.str());
+    Recording()->Add(ReturnMismatchDiag, rStmt->GetLocation(), Printed(given).c_str(),
+                     Printed(expected).c_str());
 }
 
 
 void ReportError::FieldNotFoundInBase(Identifier *field, Type *base) {
-    stringstream s;
-    s << base << " has no such field '" << field <<"'";
-    OutputError(field->GetLocation(), s.str());
+    Recording()->Add(FieldNotFoundInBaseDiag, field->GetLocation(), Printed(base).c_str(),
+                     field->Name());
 }
 
 
 void ReportError::InaccessibleField(Identifier *field, Type *base) {
-    stringstream s;
-    s  << base << " field '" << field << "' only accessible within class scope";
-    OutputError(field->GetLocation(), s.str());
+    Recording()->Add(InaccessibleFieldDiag, field->GetLocation(), Printed(base).c_str(),
+                     field->Name());
 }
 
 
 void ReportError::PrintArgMismatch(Expr *arg, int argIndex, Type *given) {
-    stringstream s;
-    s << "Incompatible argument " << argIndex << ": " << given
-        << " given, int/bool/string expected";
-    OutputError(arg->GetLocation(), s.str());
+    Recording()->Add(PrintArgMismatchDiag, arg->GetLocation(), Printed(given).c_str(),
+                     NULL, NULL, argIndex);
 }
 
 
 void ReportError::TestNotBoolean(Expr *expr) {
-    OutputError(expr->GetLocation(), "Test expression must have boolean type");
+    Recording()->Add(TestNotBooleanDiag, expr->GetLocation());
 }
 
 
 void ReportError::BreakOutsideLoop(BreakStmt *bStmt) {
-    OutputError(bStmt->GetLocation(), "break is only allowed inside a loop");
+    Recording()->Add(BreakOutsideLoopDiag, bStmt->GetLocation());
+}
+
+
+void ReportError::ConstantOverflow(Expr *expr) {
+    Recording()->Add(ConstantOverflowDiag, expr->GetLocation());
+}
+
+
+void ReportError::DivisionByZero(Expr *expr) {
+    Recording()->Add(DivisionByZeroDiag, expr->GetLocation());
 }
 
 /* Function: yyerror()
@@ -209,8 +222,11 @@ void ReportError::BreakOutsideLoop(BreakStmt *bStmt) {
  * the last token read. If you want to suppress the ordinary "parse error"
  * message from yacc, you can implement yyerror to do nothing and
  * then call ReportError::Formatted yourself with a more descriptive
- * message.
+ * message. Errors in a declaration parsed on its own (range is not NULL)
+ * are only reported if the range asks for it, otherwise the caller parses
+ * the program again to report them.
  */
-void yyerror(const char *msg) {
-    ReportError::Formatted(&yylloc, "%s", msg);
+void yyerror(yyltype *loc, DeclRange *range, const char *msg) {
+    if (range == NULL || range->reportErrors)
+        ReportError::Formatted(loc, "%s", msg);
 }
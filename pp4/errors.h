@@ -15,6 +15,7 @@
 #include <string>
 using std::string;
 #include "location.h"
+#include "diagnostics.h"
 class Type;
 class Identifier;
 class Expr;
@@ -41,6 +42,10 @@ class Operator;
  * if there is no appropriate position to point out. For other methods,
  * location is accessed by messaging the node in error which is passed
  * as an argument. You cannot pass NULL for these arguments.
+ *
+ * Nothing is written when an error is reported. It is recorded (see
+ * diagnostics.h) and all of them are written out by Flush() when the
+ * compiler is done.
  */
 
 
@@ -60,6 +65,7 @@ class ReportError
   static void LongIdentifier(yyltype *loc, const char *ident);
   static void UntermString(yyltype *loc, const char *str);
   static void UnrecogChar(yyltype *loc, char ch);
+  static void ConstantOutOfRange(yyltype *loc, const char *num);
 
 
   // Errors used by semantic analyzer for declarations
@@ -95,6 +101,11 @@ class ReportError
   static void InaccessibleField(Identifier *field, Type *base);
 
 
+  // Warnings used by semantic analyzer for constant folding
+  static void ConstantOverflow(Expr *expr);
+  static void DivisionByZero(Expr *expr);
+
+
   // Errors used by semantic analyzer for control structures
   static void TestNotBoolean(Expr *testExpr);
   static void ReturnMismatch(ReturnStmt *rStmt, Type *given, Type *expected);
@@ -105,14 +116,32 @@ class ReportError
   static void Formatted(yyltype *loc, const char *format, ...);
 
 
-  // Returns number of error messages printed
-  static int NumErrors() { return numErrors; }
+  // Returns number of errors recorded into this thread's buffer
+  static int NumErrors();
+
+  // Records the errors reported on this thread into buffer from now on,
+  // or into the program's own buffer if it is NULL
+  static void RecordTo(DiagnosticBuffer *buffer);
+
+  // Adds the errors recorded into buffer after those of this thread's
+  static void AddAll(DiagnosticBuffer *buffer);
+
+  // Writes out the errors in the program's buffer
+  static void Flush();
+
+  // Keeps no more than max errors in any buffer, see diagnostics.h
+  static void SetLimit(int max) { DiagnosticBuffer::limit = max; }
+
+  // True once this thread's buffer has as many errors as it keeps, when
+  // there is no point in checking any further
+  static bool LimitReached() { return Recording()->Full(); }
+
+  // Folds errors with the same message in the program's buffer
+  static void SetFolding(bool on);
 
  private:
 
-  static void UnderlineErrorInLine(const char *line, yyltype *pos);
-  static void OutputError(yyltype *loc, string msg);
-  static int numErrors;
+  static DiagnosticBuffer *Recording();
 
 };
 
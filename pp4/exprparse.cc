@@ -0,0 +1,351 @@
+/* File: exprparse.cc
+ * ------------------
+ * Implementation of the expression parser. The comment on each case
+ * names the Expr, LValue or Call rule of parser.y it stands in for.
+ */
+
+#include "exprparse.h"
+#include "scanner.h" // for yylex()
+#include "errors.h"
+
+void yyerror(yyltype *loc, DeclRange *range, const char *msg);
+
+
+/* Binary operators, with the precedence levels of parser.y ('=' is at
+ * level 1, but only ever follows an lvalue, see ParsePostfix). */
+typedef enum { Arithmetic, Relational, Equality, Logical } BinaryKind;
+
+struct BinaryOp {
+    int token;
+    OpCode code;
+    int prec;
+    bool nonassoc;
+    BinaryKind kind;
+};
+
+static const BinaryOp binaryOps[] = {
+    { T_Or,           OpOr,           2, false, Logical },
+    { T_And,          OpAnd,          3, false, Logical },
+    { T_Equal,        OpEqual,        4, true,  Equality },
+    { T_NotEqual,     OpNotEqual,     4, true,  Equality },
+    { '<',            OpLess,         5, true,  Relational },
+    { '>',            OpGreater,      5, true,  Relational },
+    { T_LessEqual,    OpLessEqual,    5, true,  Relational },
+    { T_GreaterEqual, OpGreaterEqual, 5, true,  Relational },
+    { '+',            OpPlus,         6, false, Arithmetic },
+    { '-',            OpMinus,        6, false, Arithmetic },
+    { '*',            OpTimes,        7, false, Arithmetic },
+    { '/',            OpDivide,       7, false, Arithmetic },
+    { '%',            OpModulo,       7, false, Arithmetic },
+};
+
+static const BinaryOp *FindBinaryOp(int token)
+{
+    for (int i = 0; i < (int)(sizeof(binaryOps)/sizeof(binaryOps[0])); i++)
+        if (binaryOps[i].token == token) return &binaryOps[i];
+    return NULL;
+}
+
+
+/* The lookahead is fetched only when it is needed, which is when bison
+ * would fetch it too. */
+int ExprParser::Peek()
+{
+    if (token == NoToken) {
+        token = yylex();
+        value = yylval;
+        loc = yylloc;
+    }
+    return token;
+}
+
+
+bool ExprParser::Expect(int tok)
+{
+    if (Peek() != tok) {
+        SyntaxError();
+        return false;
+    }
+    Advance();
+    return true;
+}
+
+
+/* Reported at the lookahead, as bison does. */
+Expr *ExprParser::SyntaxError()
+{
+    Peek();
+    yyerror(&loc, NULL, "syntax error");
+    return NULL;
+}
+
+
+Expr *ExprParser::ParseExpr(yyltype *span)
+{
+    return ParseBinary(0, span);
+}
+
+
+/* Method: ParseBinary
+ * -------------------
+ * Precedence climbing: parses an operand and then every operator with a
+ * precedence of at least minPrec, the right operand of each taking the
+ * operators that bind tighter. For non-associative operators, another
+ * operator of the same level right after is an error, as in bison.
+ */
+Expr *ExprParser::ParseBinary(int minPrec, yyltype *span)
+{
+    Expr *left = ParseUnary(span);
+    int lastNonassoc = -1;
+
+    while (left) {
+        const BinaryOp *op = FindBinaryOp(Peek());
+        if (!op || op->prec < minPrec) return left;
+        if (op->prec == lastNonassoc) return SyntaxError();
+
+        Operator *o = new Operator(loc, op->code);
+        Advance();
+        yyltype rightSpan;
+        Expr *right = ParseBinary(op->prec + 1, &rightSpan);
+        if (!right) return NULL;
+
+        switch (op->kind) {                          // Expr op Expr
+          case Arithmetic: left = new ArithmeticExpr(left, o, right); break;
+          case Relational: left = new RelationalExpr(left, o, right); break;
+          case Equality:   left = new EqualityExpr(left, o, right);   break;
+          case Logical:    left = new LogicalExpr(left, o, right);    break;
+        }
+        *span = Join(*span, rightSpan);
+        lastNonassoc = (op->nonassoc ? op->prec : -1);
+    }
+    return NULL;
+}
+
+
+Expr *ExprParser::ParseUnary(yyltype *span)
+{
+    if (Peek() != '-' && Peek() != '!')
+        return ParsePostfix(span);
+
+    int tok = Peek();
+    yyltype opLoc = loc;
+    Operator *o = new Operator(loc, tok == '-' ? OpMinus : OpNot);
+    Advance();
+    yyltype operandSpan;
+    Expr *operand = ParseUnary(&operandSpan);
+    if (!operand) return NULL;
+    *span = Join(opLoc, operandSpan);
+    if (tok == '-')
+        return new ArithmeticExpr(o, operand);              // '-' Expr
+    return new LogicalExpr(o, operand);                     // '!' Expr
+}
+
+
+/* Method: ParsePostfix
+ * --------------------
+ * A primary followed by any number of member accesses, method calls,
+ * subscripts and, after an lvalue, ++, -- or an assignment. These all
+ * bind tighter than the operators, bison shifts them in preference to
+ * reducing.
+ */
+Expr *ExprParser::ParsePostfix(yyltype *span)
+{
+    bool isLValue;
+    Expr *e = ParsePrimary(span, &isLValue);
+
+    while (e) {
+        switch (Peek()) {
+          case '.': {
+            Advance();
+            if (Peek() != T_Identifier) return SyntaxError();
+            yyltype fieldLoc = loc;
+            Identifier *field = new Identifier(loc, value.identifier);
+            Advance();
+            if (Peek() == '(') {
+                Advance();
+                List<Expr*> *actuals = ParseActuals();
+                yyltype closeLoc = loc;
+                if (!actuals || !Expect(')')) return NULL;
+                *span = Join(*span, closeLoc);             // Expr '.' T_Identifier '(' Actuals ')'
+                e = new Call(*span, e, field, actuals);
+                isLValue = false;
+            } else {
+                e = new FieldAccess(e, field);             // Expr '.' T_Identifier
+                *span = Join(*span, fieldLoc);
+                isLValue = true;
+            }
+            break;
+          }
+          case '[': {
+            Advance();
+            yyltype subscriptSpan;
+            Expr *subscript = ParseBinary(0, &subscriptSpan);
+            yyltype closeLoc = loc;
+            if (!subscript || !Expect(']')) return NULL;
+            *span = Join(*span, closeLoc);                 // Expr '[' Expr ']'
+            e = new ArrayAccess(*span, e, subscript);
+            isLValue = true;
+            break;
+          }
+          case T_Incr:
+          case T_Decr:
+            if (!isLValue) return e;
+            e = new PostfixExpr(e, new Operator(loc, Peek() == T_Incr ? OpIncrement : OpDecrement));
+            *span = Join(*span, loc);                      // LValue T_Incr, LValue T_Decr
+            Advance();
+            isLValue = false;
+            break;
+          case '=': {
+            if (!isLValue) return e;
+            Operator *o = new Operator(loc, OpAssign);
+            Advance();
+            yyltype rightSpan;
+            Expr *right = ParseBinary(0, &rightSpan);
+            if (!right) return NULL;
+            *span = Join(*span, rightSpan);                // LValue '=' Expr
+            return new AssignExpr(e, o, right);
+          }
+          default:
+            return e;
+        }
+    }
+    return NULL;
+}
+
+
+Expr *ExprParser::ParsePrimary(yyltype *span, bool *isLValue)
+{
+    int tok = Peek();
+    yyltype first = loc;
+    *span = loc;
+    *isLValue = false;
+
+    switch (tok) {
+      case T_IntConstant:    Advance(); return new IntConstant(first, value.integerConstant);
+      case T_BoolConstant:   Advance(); return new BoolConstant(first, value.boolConstant);
+      case T_DoubleConstant: Advance(); return new DoubleConstant(first, value.doubleConstant);
+      case T_StringConstant: Advance(); return new StringConstant(first, value.stringConstant);
+      case T_Null:           Advance(); return new NullConstant(first);
+      case T_This:           Advance(); return new This(first);
+
+      case T_Identifier: {
+        Identifier *id = new Identifier(first, value.identifier);
+        Advance();
+        if (Peek() != '(') {
+            *isLValue = true;
+            return new FieldAccess(NULL, id);              // T_Identifier
+        }
+        Advance();
+        List<Expr*> *actuals = ParseActuals();
+        yyltype closeLoc = loc;
+        if (!actuals || !Expect(')')) return NULL;
+        *span = Join(first, closeLoc);                     // T_Identifier '(' Actuals ')'
+        return new Call(*span, NULL, id, actuals);
+      }
+
+      case '(': {
+        Advance();
+        yyltype innerSpan;
+        Expr *e = ParseBinary(0, &innerSpan);
+        yyltype closeLoc = loc;
+        if (!e || !Expect(')')) return NULL;
+        *span = Join(first, closeLoc);                     // '(' Expr ')'
+        return e;
+      }
+
+      case T_ReadInteger:
+      case T_ReadLine: {
+        Advance();
+        if (!Expect('(')) return NULL;
+        if (Peek() != ')') return SyntaxError();
+        yyltype closeLoc = loc;
+        Advance();
+        *span = Join(first, closeLoc);
+        if (tok == T_ReadInteger)
+            return new ReadIntegerExpr(*span);             // T_ReadInteger '(' ')'
+        return new ReadLineExpr(*span);                    // T_ReadLine '(' ')'
+      }
+
+      case T_New: {
+        Advance();
+        if (!Expect('(')) return NULL;
+        if (Peek() != T_Identifier) return SyntaxError();
+        Identifier *id = new Identifier(loc, value.identifier);
+        Advance();
+        if (Peek() != ')') return SyntaxError();
+        yyltype closeLoc = loc;
+        Advance();
+        *span = Join(first, closeLoc);                     // T_New '(' T_Identifier ')'
+        return new NewExpr(*span, new NamedType(id));
+      }
+
+      case T_NewArray: {
+        Advance();
+        if (!Expect('(')) return NULL;
+        yyltype sizeSpan;
+        Expr *size = ParseBinary(0, &sizeSpan);
+        if (!size || !Expect(',')) return NULL;
+        Type *elemType = ParseType();
+        yyltype closeLoc = loc;
+        if (!elemType || !Expect(')')) return NULL;
+        *span = Join(first, closeLoc);                     // T_NewArray '(' Expr ',' Type ')'
+        return new NewArrayExpr(*span, size, elemType);
+      }
+
+      default:
+        return SyntaxError();
+    }
+}
+
+
+List<Expr*> *ExprParser::ParseActuals()
+{
+    List<Expr*> *actuals = new List<Expr*>;
+    if (Peek() == ')')
+        return actuals;                                    // empty Actuals
+    for (;;) {
+        yyltype span;
+        Expr *e = ParseBinary(0, &span);
+        if (!e) return NULL;
+        actuals->Append(e);
+        if (Peek() != ',') return actuals;
+        Advance();                                         // ExprList ',' Expr
+    }
+}
+
+
+/* The Type rules, as needed for NewArray. */
+Type *ExprParser::ParseType()
+{
+    int tok = Peek();
+    yyltype span = loc;
+    Type *type;
+    switch (tok) {
+      case T_Int:        type = Type::intType;    break;
+      case T_Bool:       type = Type::boolType;   break;
+      case T_String:     type = Type::stringType; break;
+      case T_Double:     type = Type::doubleType; break;
+      case T_Identifier: type = new NamedType(new Identifier(loc, value.identifier)); break;
+      default:           SyntaxError(); return NULL;
+    }
+    Advance();
+    while (Peek() == T_Dims) {
+        span = Join(span, loc);                            // Type T_Dims
+        type = new ArrayType(span, type);
+        Advance();
+    }
+    return type;
+}
+
+
+List<Expr*> *ExprParser::ParseExprStmts()
+{
+    List<Expr*> *stmts = new List<Expr*>;
+    while (Peek() != 0) {
+        yyltype span;
+        Expr *e = (Peek() == ';' ? new EmptyExpr() : ParseExpr(&span));
+        if (!e || !Expect(';')) return NULL;
+        stmts->Append(e);
+    }
+    return stmts;
+}
@@ -0,0 +1,68 @@
+/* File: exprparse.h
+ * -----------------
+ * A hand-written operator precedence parser for the expressions of
+ * parser.y. Binary operators are handled by precedence climbing with
+ * a small table instead of the LALR tables, everything else (prefix
+ * operators, primaries, member access, subscripts, calls, ++/-- and
+ * assignment) by recursive descent.
+ *
+ * It accepts exactly the language of the Expr rules and builds the
+ * same nodes, with the same locations, as their actions, including the
+ * effects of the precedence declarations there:
+ *
+ *   - '=' only follows a syntactic lvalue (LValue '=' Expr) and then
+ *     takes everything to its right, so x * y = 1 + 2 is x * (y = 1 + 2)
+ *     and a = b = c is a = (b = c).
+ *   - ++ and -- only follow lvalues and bind tighter than prefix - and !.
+ *   - Equality and relational operators do not associate, a < b < c is
+ *     a syntax error.
+ *
+ * Tokens come from yylex(), fetched no earlier than bison would fetch
+ * them, so lexical errors are reported in the same order. A syntax
+ * error is reported through yyerror() at the same token where the
+ * bison parser would report it, after which the parse stops, again as
+ * the bison parser does (the grammar has no error rules).
+ */
+
+#ifndef _H_exprparse
+#define _H_exprparse
+
+#include "parser.h"
+
+
+class ExprParser
+{
+  protected:
+    int token;                  // the lookahead, NoToken if not fetched yet
+    YYSTYPE value;
+    yyltype loc;
+
+    int Peek();
+    void Advance() { Peek(); token = NoToken; }
+    bool Expect(int tok);
+    Expr *SyntaxError();
+
+    Expr *ParseBinary(int minPrec, yyltype *span);
+    Expr *ParseUnary(yyltype *span);
+    Expr *ParsePostfix(yyltype *span);
+    Expr *ParsePrimary(yyltype *span, bool *isLValue);
+    List<Expr*> *ParseActuals();
+    Type *ParseType();
+
+  public:
+    static const int NoToken = -1;
+
+    ExprParser() : token(NoToken) {}
+
+          // Parses one Expr. Returns NULL if there was a syntax error.
+          // span is set to the location bison would give the Expr
+          // nonterminal (not always that of the node).
+    Expr *ParseExpr(yyltype *span);
+
+          // Parses a sequence of expression statements (OptExpr ';')
+          // up to the end of the input. Returns NULL after a syntax
+          // error.
+    List<Expr*> *ParseExprStmts();
+};
+
+#endif
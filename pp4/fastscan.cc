@@ -0,0 +1,292 @@
+/* File: fastscan.cc
+ * -----------------
+ * Implementation of the bulk scanning routines. Every routine comes in
+ * a scalar version, which also finishes the tail of the input that is
+ * too short for a full vector, and in SSE2 and AVX2 versions that use
+ * byte compares and a movemask to classify a whole block at once. The
+ * position of the first byte that ends the run is then the number of
+ * trailing zeros of the inverted mask.
+ */
+
+#include "fastscan.h"
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define FASTSCAN_X86 1
+#include <immintrin.h>
+#endif
+
+
+/* Scalar versions
+ * ---------------
+ */
+static const char *ScalarBlanks(const char *p, const char *end, int *col)
+{
+    int c = *col;
+    for (; p < end; p++) {
+        if (*p == ' ') c++;
+        else if (*p == '\t') c = TabStop(c);
+        else break;
+    }
+    *col = c;
+    return p;
+}
+
+static const char *ScalarCommentText(const char *p, const char *end, int *col)
+{
+    int c = *col;
+    for (; p < end; p++) {
+        if (*p == '\n') break;
+        if (*p == '*' && (p + 1 == end || p[1] == '/')) break;
+        c = (*p == '\t' ? TabStop(c) : c + 1);
+    }
+    *col = c;
+    return p;
+}
+
+static inline bool IsIdentChar(char ch)
+{
+    return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') ||
+           (ch >= '0' && ch <= '9') || ch == '_';
+}
+
+static const char *ScalarIdentChars(const char *p, const char *end)
+{
+    while (p < end && IsIdentChar(*p)) p++;
+    return p;
+}
+
+
+/* Adds the columns taken by the n characters at p, tabs marks which of
+ * them are tabs (bit i set for p[i]). Only the tabs need a look, the
+ * characters between them take one column each. */
+static inline int AdvanceColumns(const char *p, int n, unsigned tabs, int col)
+{
+    int done = 0;
+    while (tabs != 0) {
+        int i = __builtin_ctz(tabs);
+        col = TabStop(col + i - done);
+        done = i + 1;
+        tabs &= tabs - 1;
+    }
+    return col + n - done;
+}
+
+
+#ifdef FASTSCAN_X86
+
+/* SSE2 versions
+ * -------------
+ * SSE2 is part of the x86-64 baseline, the target attribute only makes
+ * a difference for 32-bit builds.
+ */
+__attribute__((target("sse2")))
+static const char *SSE2Blanks(const char *p, const char *end, int *col)
+{
+    const __m128i space = _mm_set1_epi8(' '), tab = _mm_set1_epi8('\t');
+    int c = *col;
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)p);
+        __m128i t = _mm_cmpeq_epi8(v, tab);
+        unsigned tabs = _mm_movemask_epi8(t);
+        unsigned blanks = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, space), t));
+        if (blanks != 0xFFFF) {
+            int n = __builtin_ctz(~blanks);
+            *col = AdvanceColumns(p, n, tabs & ((1u << n) - 1), c);
+            return p + n;
+        }
+        c = AdvanceColumns(p, 16, tabs, c);
+        p += 16;
+    }
+    *col = c;
+    return ScalarBlanks(p, end, col);
+}
+
+__attribute__((target("sse2")))
+static const char *SSE2CommentText(const char *p, const char *end, int *col)
+{
+    const __m128i star = _mm_set1_epi8('*'), slash = _mm_set1_epi8('/');
+    const __m128i newline = _mm_set1_epi8('\n'), tab = _mm_set1_epi8('\t');
+    int c = *col;
+    while (end - p >= 17) { // the block plus the byte after it
+        __m128i v = _mm_loadu_si128((const __m128i *)p);
+        __m128i next = _mm_loadu_si128((const __m128i *)(p + 1));
+        __m128i close = _mm_and_si128(_mm_cmpeq_epi8(v, star), _mm_cmpeq_epi8(next, slash));
+        unsigned stops = _mm_movemask_epi8(_mm_or_si128(close, _mm_cmpeq_epi8(v, newline)));
+        unsigned tabs = _mm_movemask_epi8(_mm_cmpeq_epi8(v, tab));
+        if (stops != 0) {
+            int n = __builtin_ctz(stops);
+            *col = AdvanceColumns(p, n, tabs & ((1u << n) - 1), c);
+            return p + n;
+        }
+        c = AdvanceColumns(p, 16, tabs, c);
+        p += 16;
+    }
+    *col = c;
+    return ScalarCommentText(p, end, col);
+}
+
+/* Letters are folded to lower case by setting bit 0x20, which leaves
+ * digits and the underscore alone. Bytes above 0x7f compare as negative
+ * and therefore never fall inside one of the ranges. */
+__attribute__((target("sse2")))
+static inline unsigned SSE2IdentMask(__m128i v)
+{
+    __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+    __m128i alpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                                  _mm_cmplt_epi8(lower, _mm_set1_epi8('z' + 1)));
+    __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)),
+                                  _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1)));
+    __m128i under = _mm_cmpeq_epi8(v, _mm_set1_epi8('_'));
+    return _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(alpha, digit), under));
+}
+
+__attribute__((target("sse2")))
+static const char *SSE2IdentChars(const char *p, const char *end)
+{
+    while (end - p >= 16) {
+        unsigned ident = SSE2IdentMask(_mm_loadu_si128((const __m128i *)p));
+        if (ident != 0xFFFF)
+            return p + __builtin_ctz(~ident);
+        p += 16;
+    }
+    return ScalarIdentChars(p, end);
+}
+
+
+/* AVX2 versions
+ * -------------
+ * Same as above on 32-byte blocks, only used if the CPU reports AVX2.
+ */
+__attribute__((target("avx2")))
+static const char *AVX2Blanks(const char *p, const char *end, int *col)
+{
+    const __m256i space = _mm256_set1_epi8(' '), tab = _mm256_set1_epi8('\t');
+    int c = *col;
+    while (end - p >= 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)p);
+        __m256i t = _mm256_cmpeq_epi8(v, tab);
+        unsigned tabs = _mm256_movemask_epi8(t);
+        unsigned blanks = _mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(v, space), t));
+        if (blanks != 0xFFFFFFFFu) {
+            int n = __builtin_ctz(~blanks);
+            *col = AdvanceColumns(p, n, tabs & ((1u << n) - 1), c);
+            return p + n;
+        }
+        c = AdvanceColumns(p, 32, tabs, c);
+        p += 32;
+    }
+    *col = c;
+    return SSE2Blanks(p, end, col);
+}
+
+__attribute__((target("avx2")))
+static const char *AVX2CommentText(const char *p, const char *end, int *col)
+{
+    const __m256i star = _mm256_set1_epi8('*'), slash = _mm256_set1_epi8('/');
+    const __m256i newline = _mm256_set1_epi8('\n'), tab = _mm256_set1_epi8('\t');
+    int c = *col;
+    while (end - p >= 33) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)p);
+        __m256i next = _mm256_loadu_si256((const __m256i *)(p + 1));
+        __m256i close = _mm256_and_si256(_mm256_cmpeq_epi8(v, star), _mm256_cmpeq_epi8(next, slash));
+        unsigned stops = _mm256_movemask_epi8(_mm256_or_si256(close, _mm256_cmpeq_epi8(v, newline)));
+        unsigned tabs = _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, tab));
+        if (stops != 0) {
+            int n = __builtin_ctz(stops);
+            *col = AdvanceColumns(p, n, tabs & ((1u << n) - 1), c);
+            return p + n;
+        }
+        c = AdvanceColumns(p, 32, tabs, c);
+        p += 32;
+    }
+    *col = c;
+    return SSE2CommentText(p, end, col);
+}
+
+__attribute__((target("avx2")))
+static const char *AVX2IdentChars(const char *p, const char *end)
+{
+    while (end - p >= 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)p);
+        __m256i lower = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+        __m256i alpha = _mm256_and_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)),
+                                         _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), lower));
+        __m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('0' - 1)),
+                                         _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), v));
+        __m256i under = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('_'));
+        unsigned ident = _mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(alpha, digit), under));
+        if (ident != 0xFFFFFFFFu)
+            return p + __builtin_ctz(~ident);
+        p += 32;
+    }
+    return SSE2IdentChars(p, end);
+}
+
+#endif
+
+
+/* Dispatch
+ * --------
+ * The variant to use is decided once, when the pointers below are
+ * initialized during static construction.
+ */
+typedef const char *(*ColumnSkipper)(const char *, const char *, int *);
+typedef const char *(*Skipper)(const char *, const char *);
+
+#ifdef FASTSCAN_X86
+static bool HasAVX2()
+{
+    __builtin_cpu_init(); // we may run before the library's own constructor
+    return __builtin_cpu_supports("avx2");
+}
+static ColumnSkipper blankSkipper = HasAVX2() ? AVX2Blanks : SSE2Blanks;
+static ColumnSkipper commentSkipper = HasAVX2() ? AVX2CommentText : SSE2CommentText;
+static Skipper identSkipper = HasAVX2() ? AVX2IdentChars : SSE2IdentChars;
+#else
+static ColumnSkipper blankSkipper = ScalarBlanks;
+static ColumnSkipper commentSkipper = ScalarCommentText;
+static Skipper identSkipper = ScalarIdentChars;
+#endif
+
+
+const char *SkipBlanks(const char *p, const char *end, int *col)
+{
+    return blankSkipper(p, end, col);
+}
+
+const char *SkipCommentText(const char *p, const char *end, int *col)
+{
+    return commentSkipper(p, end, col);
+}
+
+const char *SkipIdentChars(const char *p, const char *end)
+{
+    return identSkipper(p, end);
+}
+
+
+bool SetFastScanVariant(const char *name)
+{
+    if (strcmp(name, "scalar") == 0) {
+        blankSkipper = ScalarBlanks;
+        commentSkipper = ScalarCommentText;
+        identSkipper = ScalarIdentChars;
+        return true;
+    }
+#ifdef FASTSCAN_X86
+    if (strcmp(name, "sse2") == 0) {
+        blankSkipper = SSE2Blanks;
+        commentSkipper = SSE2CommentText;
+        identSkipper = SSE2IdentChars;
+        return true;
+    }
+    if (strcmp(name, "avx2") == 0 && HasAVX2()) {
+        blankSkipper = AVX2Blanks;
+        commentSkipper = AVX2CommentText;
+        identSkipper = AVX2IdentChars;
+        return true;
+    }
+#endif
+    return false;
+}
@@ -0,0 +1,66 @@
+/* File: fastscan.h
+ * ----------------
+ * Bulk scanning routines for the runs of characters that make up most
+ * of a large input: blanks, comment text and identifiers. Each routine
+ * starts at p, looks at no character at or beyond end, and returns the
+ * position of the first character that does not belong to the run.
+ * On x86 the work is done 16 (SSE2) or 32 (AVX2) bytes at a time, the
+ * variant is picked once at start-up based on what the CPU supports.
+ * On other machines plain scalar loops are used.
+ *
+ * Columns are kept the same way the scanner rules keep them: every
+ * character advances the column by one, and a tab then also skips to
+ * the next tab stop (see TabStop below).
+ */
+
+#ifndef _H_fastscan
+#define _H_fastscan
+
+#include "scanner.h" // for TAB_SIZE
+
+
+/* Function: TabStop()
+ * -------------------
+ * Returns the column that follows a tab read at column col.
+ */
+inline int TabStop(int col)
+{
+    col++;
+    return col + TAB_SIZE - col%TAB_SIZE + 1;
+}
+
+
+/* Function: SkipBlanks()
+ * ----------------------
+ * Skips spaces and tabs, advancing *col past them.
+ */
+const char *SkipBlanks(const char *p, const char *end, int *col);
+
+
+/* Function: SkipCommentText()
+ * ---------------------------
+ * Skips the body of a block comment, advancing *col past it. Stops at a
+ * newline or at the "*" of a "*" "/" pair. A "*" right before end is not
+ * skipped, as the "/" that may complete it is not visible yet.
+ */
+const char *SkipCommentText(const char *p, const char *end, int *col);
+
+
+/* Function: SkipIdentChars()
+ * --------------------------
+ * Skips letters, digits and underscores, i.e. the characters that may
+ * follow the first letter of an identifier.
+ */
+const char *SkipIdentChars(const char *p, const char *end);
+
+
+/* Function: SetFastScanVariant()
+ * ------------------------------
+ * Makes the routines above use the named variant, "scalar", "sse2" or
+ * "avx2", instead of the one picked at start-up. Returns false, leaving
+ * things as they were, if there is no such variant on this machine.
+ * Meant for the benchmarks, which compare the variants with each other.
+ */
+bool SetFastScanVariant(const char *name);
+
+#endif
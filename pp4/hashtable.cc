@@ -32,7 +32,7 @@ template <class Value> void Hashtable<Value>::Remove(const char *key, Value val)
   if (mmap.count(key) == 0) // no matches at all
     return;
 
-  typename std::multimap<const char *, Value>::iterator itr;
+  typename Map::iterator itr;
   itr = mmap.find(key); // start at first occurrence
   while (itr != mmap.upper_bound(key)) {
     if (itr->second == val) { // iterate to find matching pair
@@ -54,7 +54,7 @@ template <class Value> Value Hashtable<Value>::Lookup(const char *key)
   Value found = NULL;
 
   if (mmap.count(key) > 0) {
-    typename std::multimap<const char *, Value>::iterator cur, last, prev;
+    typename Map::iterator cur, last, prev;
     cur = mmap.find(key); // start at first occurrence
     last = mmap.upper_bound(key);
     while (cur != last) { // iterate to find last entered
@@ -36,6 +36,7 @@
 
 #include <map>
 #include <string.h>
+#include "arena.h"
 
 struct ltstr {
   bool operator()(const char* s1, const char* s2) const
@@ -45,10 +46,14 @@ struct ltstr {
 
 template <class Value> class Iterator;
 
-template<class Value> class Hashtable {
+template<class Value> class Hashtable : public ArenaAllocated {
+
+  public:
+     typedef std::multimap<const char*, Value, ltstr,
+                           ArenaAllocator<std::pair<const char* const, Value> > > Map;
 
   private: 
-     std::multimap<const char*, Value, ltstr> mmap;
+     Map mmap;
  
    public:
             // ctor creates a new empty hashtable
@@ -92,8 +97,8 @@ template<class Value> class Iterator {
   friend class Hashtable<Value>;
 
   private:
-    typename std::multimap<const char*, Value , ltstr>::iterator cur, end;
-    Iterator(std::multimap<const char*, Value, ltstr>& t)
+    typename Hashtable<Value>::Map::iterator cur, end;
+    Iterator(typename Hashtable<Value>::Map& t)
       : cur(t.begin()), end(t.end()) {}
 
   public:
@@ -0,0 +1,620 @@
+/* File: incremental.cc
+ * --------------------
+ * Implementation of incremental compiling: summing up the declarations
+ * from their tokens, reading and writing the graph, working out which
+ * declarations to parse and check, and putting their diagnostics
+ * together with those of the rest.
+ */
+
+#include "incremental.h"
+#include <string.h>
+#include <atomic>
+#include <string>
+#include <vector>
+#include "ast_decl.h"
+#include "ast_stmt.h"
+#include "declparse.h"
+#include "tokenstream.h"
+#include "diagnostics.h"
+#include "errors.h"
+#include "strpool.h"
+#include "walk.h"
+#include "workpool.h"
+#include "utility.h" // for PrintDebug(), Fnv1a(), ReplaceFile()
+
+
+/* What the tokens of a declaration of the input say about it. */
+struct DeclSummary {
+    const PooledString *name;   // NULL if it has none to be seen
+    uint64_t body, interface;
+    int firstLine;
+    std::vector<const PooledString*> names;          // each one once
+    std::vector<const PooledString*> interfaceNames; // those in the interface
+};
+
+/* A diagnostic as it was saved, lines counted from the declaration's
+ * first one. The line a DeclConflict says the other declaration is on
+ * is counted the same way; it is in the same declaration unless it was
+ * found while checking (see SavedDecl::pointsElsewhere). */
+struct SavedDiagnostic {
+    DiagnosticKind kind;
+    bool located;
+    yyltype loc;
+    std::string args[3];
+    bool hasArg[3];
+    int nums[2];
+};
+
+struct SavedDiagnostics {
+    int numErrors, numWarnings;
+    std::vector<SavedDiagnostic> kept;
+};
+
+/* A declaration as the last run left it. */
+struct SavedDecl {
+    const PooledString *name;
+    uint64_t body, interface;
+    std::vector<const PooledString*> names;
+    SavedDiagnostics scoped, checked;
+    bool pointsElsewhere;       // checking it found a DeclConflict
+    const char *record;         // where it is in the file
+    size_t recordSize;
+};
+
+
+/* The graph as read, and the one being written */
+static std::vector<char> fileData;
+static std::vector<const PooledString*> fileNames;     // by number
+static std::vector<SavedDecl> savedDecls;
+static std::vector<const PooledString*> graphNames;    // those of fileNames first
+static std::vector<int> nameNumbers;                   // by pool index, -1 for none
+static std::vector<char> graph;                        // the records
+
+
+/* Tokens are hashed a 64-bit word at a time, names and literals by the
+ * hash of their characters, worked out once for each entry. */
+static uint64_t Mix(uint64_t hash, uint64_t word)
+{
+    hash = (hash ^ word) * FnvPrime;
+    return hash ^ (hash >> 32);
+}
+
+static std::vector<uint64_t> nameHashes, literalHashes; // by pool index, 0 if not yet
+
+static uint64_t EntryHash(const PooledString *entry, std::vector<uint64_t> *hashes)
+{
+    if (entry->index >= (int)hashes->size())
+        hashes->resize(entry->index + 1, 0);
+    uint64_t &hash = (*hashes)[entry->index];
+    if (hash == 0)
+        hash = Fnv1a(entry->chars, entry->length) | 1;
+    return hash;
+}
+
+static uint64_t TokenValue(int code, const YYSTYPE &val)
+{
+    uint64_t bits = 0;
+    switch (code) {
+      case T_Identifier: return EntryHash(val.identifier, &nameHashes);
+      case T_StringConstant: return EntryHash(val.stringConstant, &literalHashes);
+      case T_IntConstant: return (uint32_t)val.integerConstant;
+      case T_DoubleConstant: memcpy(&bits, &val.doubleConstant, sizeof bits); return bits;
+      case T_BoolConstant: return val.boolConstant;
+    }
+    return 0;
+}
+
+
+/* The interface of a class or interface is what is not inside the
+ * bodies of its methods, that of a function what is not inside its
+ * body, and that of a variable all of it. The name of a class or
+ * interface follows the keyword, that of a function or variable is
+ * the identifier before the first '(' or ';'. seen and interfaceSeen
+ * hold the stamp of the last declaration each name was listed for. */
+static void Summarize(DeclRange *range, DeclSummary *s, int stamp,
+                      std::vector<int> *seen, std::vector<int> *interfaceSeen)
+{
+    YYSTYPE val;
+    yyltype loc;
+    int code = GetScannedToken(range->start, &val, &loc);
+    int outer = (code == T_Class || code == T_Interface ? 1 : 0);
+    s->name = NULL;
+    s->firstLine = loc.first_line;
+    s->body = s->interface = FnvBasis;
+
+    const PooledString *last = NULL; // the identifier just before, if it was one
+    bool named = false;
+    for (int i = range->start, depth = 0; i < range->end; i++) {
+        code = GetScannedToken(i, &val, &loc);
+        if (code == '}' && depth > 0) depth--;
+        bool inInterface = (depth <= outer);
+        if (code == '{') depth++;
+
+        uint64_t value = TokenValue(code, val);
+        uint64_t where = ((uint64_t)(loc.first_line - s->firstLine) << 40 ^ // the scanners
+                          (uint64_t)loc.first_column << 20 ^ loc.last_column); // leave last_line
+        s->body = Mix(Mix(Mix(s->body, code), value), where);
+        if (inInterface)
+            s->interface = Mix(Mix(s->interface, code), value);
+
+        if (!named && (outer ? i == range->start + 1 : code == '(' || code == ';')) {
+            s->name = (outer ? (code == T_Identifier ? val.identifier : NULL) : last);
+            named = true;
+        }
+        last = NULL;
+        if (code != T_Identifier)
+            continue;
+        last = val.identifier;
+        int index = val.identifier->index;
+        if ((*seen)[index] != stamp) {
+            (*seen)[index] = stamp;
+            s->names.push_back(val.identifier);
+        }
+        if (inInterface && (*interfaceSeen)[index] != stamp) {
+            (*interfaceSeen)[index] = stamp;
+            s->interfaceNames.push_back(val.identifier);
+        }
+    }
+}
+
+
+/* Writing
+ * -------
+ * The records are put together in graph as the declarations are done,
+ * and written out after the header and the names.
+ */
+static void Put(std::vector<char> *out, const void *data, size_t len)
+{
+    out->insert(out->end(), (const char *)data, (const char *)data + len);
+}
+
+static void PutNumber(std::vector<char> *out, int32_t n) { Put(out, &n, sizeof n); }
+static void PutHash(std::vector<char> *out, uint64_t h) { Put(out, &h, sizeof h); }
+
+static void PutString(std::vector<char> *out, const char *s)
+{
+    PutNumber(out, s ? strlen(s) : -1);
+    if (s) Put(out, s, strlen(s));
+}
+
+static void PutName(const PooledString *name)
+{
+    if (nameNumbers[name->index] < 0) {
+        nameNumbers[name->index] = graphNames.size();
+        graphNames.push_back(name);
+    }
+    PutNumber(&graph, nameNumbers[name->index]);
+}
+
+
+static void SaveDiagnostics(DiagnosticBuffer *found, int firstLine)
+{
+    PutNumber(&graph, found->NumErrors());
+    PutNumber(&graph, found->NumWarnings());
+    PutNumber(&graph, found->NumKept());
+    for (int i = 0; i < found->NumKept(); i++) {
+        const Diagnostic &d = found->Kept(i);
+        PutNumber(&graph, d.kind);
+        PutNumber(&graph, d.located);
+        PutNumber(&graph, d.located ? d.loc.first_line - firstLine : 0);
+        PutNumber(&graph, d.located ? d.loc.first_column : 0);
+        PutNumber(&graph, d.located ? d.loc.last_line : 0);
+        PutNumber(&graph, d.located ? d.loc.last_column : 0);
+        for (int j = 0; j < 3; j++)
+            PutString(&graph, d.args[j]);
+        PutNumber(&graph, d.nums[0] - (d.kind == DeclConflictDiag ? firstLine : 0));
+        PutNumber(&graph, d.nums[1]);
+    }
+}
+
+
+static void SaveDecl(DeclSummary *s, DiagnosticBuffer *scoped, DiagnosticBuffer *checked)
+{
+    PutName(s->name);
+    PutHash(&graph, s->body);
+    PutHash(&graph, s->interface);
+    PutNumber(&graph, s->names.size());
+    for (size_t i = 0; i < s->names.size(); i++)
+        PutName(s->names[i]);
+    SaveDiagnostics(scoped, s->firstLine);
+    SaveDiagnostics(checked, s->firstLine);
+}
+
+
+static bool WriteGraph(const char *path, int numDecls)
+{
+    std::vector<char> names;
+    for (size_t i = 0; i < graphNames.size(); i++)
+        PutString(&names, graphNames[i]->chars);
+
+    DepGraphHeader header;
+    memcpy(header.magic, "DDEP", 4);
+    header.version = DepGraphVersion;
+    header.maxErrors = DiagnosticBuffer::limit;
+    header.numNames = graphNames.size();
+    header.numDecls = numDecls;
+    header.unused = 0;
+    header.checksum = Fnv1a(graph.data(), graph.size(), Fnv1a(names.data(), names.size()));
+
+    const void *parts[] = { &header, names.data(), graph.data() };
+    size_t sizes[] = { sizeof(header), names.size(), graph.size() };
+    return ReplaceFile(path, 3, parts, sizes);
+}
+
+
+/* Reading
+ * -------
+ * The file is read as a whole and checked before anything in it is
+ * used. Its names are interned, so they can be compared with those of
+ * the input by address.
+ */
+struct GraphReader {
+    const char *next, *end;
+    bool ok;
+
+    bool Get(void *data, size_t len) {
+        ok = ok && (size_t)(end - next) >= len;
+        if (ok) memcpy(data, next, len);
+        if (ok) next += len;
+        return ok;
+    }
+    int32_t Number() { int32_t n = 0; Get(&n, sizeof n); return n; }
+    uint64_t Hash() { uint64_t h = 0; Get(&h, sizeof h); return h; }
+
+          // Sets *s to the next string, returns false if there is none
+    bool String(std::string *s) {
+        int32_t len = Number();
+        ok = ok && len >= -1 && end - next >= len;
+        if (!ok || len < 0) return false;
+        s->assign(next, len);
+        next += len;
+        return true;
+    }
+    const PooledString *Name() {
+        int32_t n = Number();
+        ok = ok && n >= 0 && n < (int)fileNames.size();
+        return ok ? fileNames[n] : NULL;
+    }
+};
+
+
+static void ReadDiagnostics(GraphReader *r, SavedDiagnostics *saved)
+{
+    saved->numErrors = r->Number();
+    saved->numWarnings = r->Number();
+    int numKept = r->Number();
+    for (int i = 0; r->ok && i < numKept; i++) {
+        SavedDiagnostic s;
+        s.kind = (DiagnosticKind)r->Number();
+        s.located = r->Number();
+        s.loc.timestamp = 0;
+        s.loc.first_line = r->Number();
+        s.loc.first_column = r->Number();
+        s.loc.last_line = r->Number();
+        s.loc.last_column = r->Number();
+        s.loc.text = NULL;
+        for (int j = 0; j < 3; j++)
+            s.hasArg[j] = r->String(&s.args[j]);
+        s.nums[0] = r->Number();
+        s.nums[1] = r->Number();
+        r->ok = r->ok && s.kind >= 0 && s.kind <= DivisionByZeroDiag;
+        saved->kept.push_back(s);
+    }
+}
+
+
+static bool ReadDecl(GraphReader *r, SavedDecl *d)
+{
+    d->record = r->next;
+    d->name = r->Name();
+    d->body = r->Hash();
+    d->interface = r->Hash();
+    int numNames = r->Number();
+    for (int i = 0; r->ok && i < numNames; i++)
+        d->names.push_back(r->Name());
+    ReadDiagnostics(r, &d->scoped);
+    ReadDiagnostics(r, &d->checked);
+    d->recordSize = r->next - d->record;
+
+    d->pointsElsewhere = false;
+    for (size_t i = 0; i < d->checked.kept.size(); i++)
+        if (d->checked.kept[i].kind == DeclConflictDiag)
+            d->pointsElsewhere = true;
+    return r->ok;
+}
+
+
+static bool ReadGraph(const char *path)
+{
+    FILE *fp = fopen(path, "rb");
+    if (!fp) return false;
+    char chunk[65536];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof chunk, fp)) > 0)
+        fileData.insert(fileData.end(), chunk, chunk + n);
+    fclose(fp);
+
+    DepGraphHeader header;
+    if (fileData.size() < sizeof header)
+        return false;
+    memcpy(&header, fileData.data(), sizeof header);
+    if (memcmp(header.magic, "DDEP", 4) != 0 || header.version != DepGraphVersion ||
+        header.maxErrors != DiagnosticBuffer::limit ||
+        header.checksum != Fnv1a(fileData.data() + sizeof header, fileData.size() - sizeof header))
+        return false;
+
+    GraphReader r = { fileData.data() + sizeof header, fileData.data() + fileData.size(), true };
+    std::string name;
+    for (uint32_t i = 0; i < header.numNames && r.String(&name); i++)
+        fileNames.push_back(identifierNames.Intern(name.data(), name.size()));
+    if (fileNames.size() != header.numNames)
+        return false;
+    savedDecls.resize(header.numDecls);
+    for (uint32_t i = 0; i < header.numDecls; i++)
+        if (!ReadDecl(&r, &savedDecls[i]))
+            return false;
+    return r.next == r.end;
+}
+
+
+/* Puts what was saved in found as if it had been recorded there again,
+ * with the declaration starting at firstLine. */
+static void Replay(SavedDiagnostics *saved, int firstLine, DiagnosticBuffer *found)
+{
+    int keptErrors = 0, keptWarnings = 0;
+    for (size_t i = 0; i < saved->kept.size(); i++) {
+        SavedDiagnostic &s = saved->kept[i];
+        yyltype loc = s.loc;
+        loc.first_line += firstLine;
+        const char *args[3];
+        for (int j = 0; j < 3; j++)
+            args[j] = (s.hasArg[j] ? s.args[j].c_str() : NULL);
+        found->Add(s.kind, s.located ? &loc : NULL, args[0], args[1], args[2],
+                   s.nums[0] + (s.kind == DeclConflictDiag ? firstLine : 0), s.nums[1]);
+        if (s.kind >= ConstantOverflowDiag)
+            keptWarnings++;
+        else
+            keptErrors++;
+    }
+    found->CountNotKept(saved->numErrors - keptErrors, saved->numWarnings - keptWarnings);
+}
+
+
+/* A declaration has to be checked again if it changed, or if it uses
+ * the name of one whose interface is not what it was, directly or
+ * through the interfaces of others. Those names are found by going
+ * from the ones that changed to the declarations whose interfaces use
+ * them, and so on. Those to check are parsed, and so are those whose
+ * names they use, and those whose names the interfaces of those use,
+ * and so on. Sets what is to be done with each declaration and what
+ * was saved for it, or returns false if they cannot be told apart by
+ * name. */
+static bool FindChanged(std::vector<DeclSummary> *decls, std::vector<SavedDecl*> *saved,
+                        std::vector<bool> *check, std::vector<bool> *parse)
+{
+    int n = decls->size();
+    int numNames = identifierNames.NumEntries();
+    std::vector<int> current(numNames, -1);     // declaration of each name
+    for (int i = 0; i < n; i++) {
+        const PooledString *name = (*decls)[i].name;
+        if (!name || current[name->index] >= 0)
+            return false;
+        current[name->index] = i;
+    }
+    std::vector<SavedDecl*> before(numNames, NULL);
+    for (size_t i = 0; i < savedDecls.size(); i++)
+        before[savedDecls[i].name->index] = &savedDecls[i];
+    saved->resize(n);
+    for (int i = 0; i < n; i++)
+        (*saved)[i] = before[(*decls)[i].name->index];
+
+    std::vector<bool> changed(numNames, false);
+    std::vector<int> queue;
+    for (int i = 0; i < n; i++)
+        if (!(*saved)[i] || (*saved)[i]->interface != (*decls)[i].interface)
+            queue.push_back((*decls)[i].name->index);
+    for (size_t i = 0; i < savedDecls.size(); i++)
+        if (current[savedDecls[i].name->index] < 0)
+            queue.push_back(savedDecls[i].name->index);
+    for (size_t i = 0; i < queue.size(); i++)
+        changed[queue[i]] = true;
+
+    std::vector<std::vector<int> > usedBy(numNames);
+    for (int i = 0; i < n; i++) {
+        std::vector<const PooledString*> &used = (*decls)[i].interfaceNames;
+        for (size_t j = 0; j < used.size(); j++)
+            if (used[j] != (*decls)[i].name)
+                usedBy[used[j]->index].push_back(i);
+    }
+    for (size_t i = 0; i < queue.size(); i++) {
+        std::vector<int> &users = usedBy[queue[i]];
+        for (size_t j = 0; j < users.size(); j++) {
+            int user = (*decls)[users[j]].name->index;
+            if (!changed[user]) {
+                changed[user] = true;
+                queue.push_back(user);
+            }
+        }
+    }
+
+    check->assign(n, true);
+    parse->assign(n, false);
+    std::vector<int> toParse;
+    for (int i = 0; i < n; i++) {
+        SavedDecl *d = (*saved)[i];
+        if (d && d->body == (*decls)[i].body && !d->pointsElsewhere) {
+            bool affected = false;
+            for (size_t j = 0; j < d->names.size() && !affected; j++)
+                affected = changed[d->names[j]->index];
+            (*check)[i] = affected;
+        }
+        if ((*check)[i]) {
+            (*parse)[i] = true;
+            toParse.push_back(i);
+        }
+    }
+    for (size_t i = 0; i < toParse.size(); i++) {
+        DeclSummary &s = (*decls)[toParse[i]];
+        std::vector<const PooledString*> &used = ((*check)[toParse[i]] ? s.names : s.interfaceNames);
+        for (size_t j = 0; j < used.size(); j++) {
+            int d = current[used[j]->index];
+            if (d >= 0 && !(*parse)[d]) {
+                (*parse)[d] = true;
+                toParse.push_back(d);
+            }
+        }
+    }
+    return true;
+}
+
+
+/* Parses the declarations marked in parse, each on its own, and returns
+ * false unless all of them parse, to the names they were taken to have. */
+static bool ParseDecls(List<DeclRange*> *ranges, std::vector<DeclSummary> *decls,
+                       std::vector<bool> *parse)
+{
+    for (int i = 0; i < ranges->NumElements(); i++) {
+        DeclRange *range = ranges->Nth(i);
+        if (!(*parse)[i])
+            continue;
+        range->parsed = (yyparse(range) == 0);
+        if (!range->parsed || strcmp(range->decl->Name(), (*decls)[i].name->chars) != 0)
+            return false;
+    }
+    return true;
+}
+
+
+/* Those to check are checked as in Program::CheckInParallel, each one
+ * with its errors kept in a buffer of its own, and none after the
+ * first with as many as are kept. */
+struct IncrementalChecks {
+    std::vector<Decl*> decls;   // NULL for those not parsed
+    DiagnosticBuffer *found;
+    std::vector<int> toCheck;
+    std::atomic<int> firstFull;
+};
+
+static void CheckAgain(int task, void *data)
+{
+    IncrementalChecks *checks = (IncrementalChecks *)data;
+    int index = checks->toCheck[task];
+    if (index > checks->firstFull)
+        return;
+    ReportError::RecordTo(&checks->found[index]);
+    CheckTree(checks->decls[index]);
+    ReportError::RecordTo(NULL);
+
+    int first = checks->firstFull;
+    while (checks->found[index].Full() && index < first &&
+           !checks->firstFull.compare_exchange_weak(first, index))
+        ;
+}
+
+
+/* As Program::Check does, the scopes of all declarations are built
+ * before any is checked, and the diagnostics of building them come
+ * first. Returns how many declarations are done, and can be saved. */
+static int CheckChanged(List<DeclRange*> *ranges, std::vector<DeclSummary> *decls,
+                        std::vector<SavedDecl*> *saved, std::vector<bool> *check)
+{
+    int n = ranges->NumElements();
+    IncrementalChecks checks;
+    List<Decl*> *parsed = new List<Decl*>;
+    for (int i = 0; i < n; i++) {
+        checks.decls.push_back(ranges->Nth(i)->decl);
+        if (checks.decls[i])
+            parsed->Append(checks.decls[i]);
+    }
+    new Program(parsed); // their parent
+    for (int i = 0; i < parsed->NumElements(); i++)
+        Program::gScope->AddDeclaration(parsed->Nth(i));
+
+    DiagnosticBuffer *scoped = new DiagnosticBuffer[n];
+    for (int i = 0; i < n; i++) {
+        if (!checks.decls[i]) {
+            Replay(&(*saved)[i]->scoped, (*decls)[i].firstLine, &scoped[i]);
+            continue;
+        }
+        ReportError::RecordTo(&scoped[i]);
+        BuildScopes(checks.decls[i], Program::gScope);
+        ReportError::RecordTo(NULL);
+    }
+
+    checks.found = new DiagnosticBuffer[n];
+    checks.firstFull = n;
+    for (int i = 0; i < n; i++) {
+        if ((*check)[i]) {
+            checks.toCheck.push_back(i);
+            continue;
+        }
+        Replay(&(*saved)[i]->checked, (*decls)[i].firstLine, &checks.found[i]);
+        if (checks.found[i].Full() && i < checks.firstFull)
+            checks.firstFull = i;
+    }
+    PrintDebug("incremental", "Parsed %d and checked %d of %d declarations",
+               parsed->NumElements(), (int)checks.toCheck.size(), n);
+
+    const char *jobs = GetOption("j");
+    if (jobs && atoi(jobs) > 1)
+        RunTasks(checks.toCheck.size(), atoi(jobs), CheckAgain, &checks);
+    else
+        for (size_t task = 0; task < checks.toCheck.size(); task++)
+            CheckAgain(task, &checks);
+
+    nameNumbers.assign(identifierNames.NumEntries(), -1);
+    graphNames = fileNames;
+    for (size_t i = 0; i < fileNames.size(); i++)
+        nameNumbers[fileNames[i]->index] = i;
+    int numDone = (checks.firstFull < n ? checks.firstFull + 1 : n);
+    for (int i = 0; i < numDone; i++) {
+        if (checks.decls[i])
+            SaveDecl(&(*decls)[i], &scoped[i], &checks.found[i]);
+        else // as it was
+            Put(&graph, (*saved)[i]->record, (*saved)[i]->recordSize);
+    }
+
+    for (int i = 0; i < n; i++)
+        ReportError::AddAll(&scoped[i]);
+    for (int i = 0; i < n; i++)
+        ReportError::AddAll(&checks.found[i]);
+    delete[] scoped;
+    delete[] checks.found;
+    return numDone;
+}
+
+
+void CompileIncrementally(const char *path)
+{
+    int numTokens = ScanAhead();
+    List<DeclRange*> *ranges = SplitDecls(numTokens);
+    int n = ranges->NumElements();
+    std::vector<DeclSummary> decls(n);
+    std::vector<int> seen(identifierNames.NumEntries(), -1);
+    std::vector<int> interfaceSeen(identifierNames.NumEntries(), -1);
+    for (int i = 0; i < n; i++)
+        Summarize(ranges->Nth(i), &decls[i], i, &seen, &interfaceSeen);
+
+    if (!ReadGraph(path)) {
+        PrintDebug("incremental", "No usable %s, compiling everything", path);
+        fileNames.clear();
+        savedDecls.clear();
+    }
+
+    std::vector<SavedDecl*> saved;
+    std::vector<bool> check, parse;
+    if (n == 0 || !FindChanged(&decls, &saved, &check, &parse) ||
+        !ParseDecls(ranges, &decls, &parse)) {
+        PrintDebug("incremental", "Cannot take the declarations apart, compiling as usual");
+        yyparse(NULL);
+        return;
+    }
+
+    while (yylex() != 0) // reports the lexical errors in order
+        ;
+    if (ReportError::NumErrors() > 0) // as in the Program rule
+        return;
+    int numDone = CheckChanged(ranges, &decls, &saved, &check);
+    if (!WriteGraph(path, numDone))
+        PrintDebug("incremental", "Cannot write %s", path);
+}
@@ -0,0 +1,69 @@
+/* File: incremental.h
+ * -------------------
+ * Compiling again only what an edit can have changed. With
+ * -incremental[=file] on the command line, the whole input is scanned
+ * first (see ScanAhead in tokenstream.h) and cut into top-level
+ * declarations as declparse.h does. Two hashes are taken of the tokens
+ * of each one: of all of them, with their lines counted from its first
+ * one, and of those that make up its interface, the tokens outside of
+ * the bodies of its functions. Its dependencies are the names it uses.
+ *
+ * Once the program is checked, file (by default .dcc-deps) is written
+ * with, for each declaration, its name, hashes and dependencies and the
+ * diagnostics building its scopes and checking it recorded. The next
+ * run checks a declaration again only if
+ *
+ *   - it is new or its tokens changed,
+ *   - one of the names it uses is that of a declaration whose interface
+ *     changed, or which was added or removed, or that of one whose own
+ *     interface uses such a name, and so on,
+ *   - or one of its diagnostics says where another declaration is.
+ *
+ * Only those are parsed, along with the declarations they use and the
+ * ones those use in their interfaces, which checking them can look
+ * into. Each declaration is parsed on its own, as with -parsejobs. The
+ * diagnostics of the rest are taken from the file, moved to where the
+ * declaration is now, and the messages come out in the same order as
+ * if everything had been compiled. With -j=N, those to check are
+ * checked on N threads.
+ *
+ * The whole input is parsed the usual way, and checked without the
+ * file, if a declaration has no name or fails to parse on its own, or
+ * if two have the same name. The file is not used if it was written
+ * with another -maxerrors. With -d incremental, the numbers parsed and
+ * checked are reported.
+ */
+
+#ifndef _H_incremental
+#define _H_incremental
+
+#include <stdint.h>
+
+
+/* The file starts with this header, followed by the names, and then a
+ * record for each declaration in source order: its name, its two
+ * hashes, the names it uses, and the diagnostics of building its
+ * scopes and of checking it, each as counts of errors and warnings and
+ * those that were kept, lines counted from its first one. Names are
+ * numbers in the list of names, strings a 32-bit length followed by
+ * the characters, -1 for none. */
+static const uint32_t DepGraphVersion = 1;
+
+struct DepGraphHeader {
+    char magic[4];              // "DDEP"
+    uint32_t version;
+    int32_t maxErrors;          // the -maxerrors it was written with
+    uint32_t numNames, numDecls;
+    uint32_t unused;
+    uint64_t checksum;          // FNV-1a of everything after the header
+};
+
+
+/* Function: CompileIncrementally()
+ * --------------------------------
+ * Compiles all of stdin as described above, with the graph kept in
+ * path. Used instead of InitScanner() and yyparse().
+ */
+void CompileIncrementally(const char *path);
+
+#endif
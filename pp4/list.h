@@ -29,14 +29,15 @@
 #define _H_list
 
 #include <deque>
+#include "arena.h"    // for ArenaAllocated
 #include "utility.h"  // for Assert()
 
 class Node;
 
-template<class Element> class List {
+template<class Element> class List : public ArenaAllocated {
 
  private:
-    std::deque<Element> elems;
+    std::deque<Element, ArenaAllocator<Element> > elems;
 
  public:
            // Create a new empty list
@@ -52,6 +53,12 @@ template<class Element> class List {
 	{ Assert(index >= 0 && index < NumElements());
 	  return elems[index]; }
 
+          // Replaces the element at index with elem
+          // Raises assert if index out of range
+    void SetNth(const Element &elem, int index)
+	{ Assert(index >= 0 && index < NumElements());
+	  elems[index] = elem; }
+
           // Inserts element at index, shuffling over others
           // Raises assert if index out of range
     void InsertAt(const Element &elem, int index)
@@ -62,6 +69,10 @@ template<class Element> class List {
     void Append(const Element &elem)
 	{ elems.push_back(elem); }
 
+          // Removes all elements
+    void Clear()
+	{ elems.clear(); }
+
          // Removes element at index, shuffling down others
          // Raises assert if index out of range
     void RemoveAt(int index)
@@ -24,6 +24,7 @@ typedef struct yyltype
 } yyltype;
 
 #define YYLTYPE yyltype
+#define YYLTYPE_IS_TRIVIAL 1     // so the parser's stacks can grow
 
 
 /* Global variable: yylloc
@@ -1,32 +1,160 @@
 /* File: main.cc
  * -------------
  * This file defines the main() routine for the program and not much else.
- * You should not need to modify this file.
  */
  
 
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
 #include "utility.h"
 #include "errors.h"
 #include "parser.h"
+#include "tokenstream.h"
+#include "pushparse.h"
+#include "exprparse.h"
+#include "declparse.h"
+#include "stream.h"
+#include "astcache.h"
+#include "incremental.h"
+#include "daemon.h"
+#include "batch.h"
+
+
+/* Writes out the errors reported and returns the exit status. */
+static int Finish()
+{
+    ReportError::Flush();
+    return (ReportError::NumErrors() == 0? 0 : -1);
+}
+
+
+/* The value of the option -name=N, which must be a positive number, or
+ * byDefault for -name on its own. Fails for any other value. */
+static int PositiveOption(const char *name, int byDefault)
+{
+    const char *value = GetOption(name);
+    if (!*value) return byDefault;
+    char *end;
+    long n = strtol(value, &end, 10);
+    if (*end != '\0' || n <= 0 || n > INT_MAX)
+        Failure("-%s needs a positive number, not \"%s\"", name, value);
+    return n;
+}
+
+
+/* Function: Compile()
+ * -------------------
+ * Compiles the program on stdin with the options on the command line.
+ * InitScanner() is used to set up the scanner, or with -pipeline or
+ * -lexjobs, StartScannerThread() or StartChunkedScan() to scan on
+ * separate threads. With -push[=size] the input is instead read and
+ * parsed in pieces of that many bytes (see pushparse.h), with
+ * -parsejobs=N its declarations are parsed on N threads (see
+ * declparse.h), and with -stream it is compiled one declaration at a
+ * time (see stream.h). -cache[=dir] keeps parsed programs in dir to
+ * skip parsing them again (see astcache.h), and -incremental[=file]
+ * checks again only the declarations an edit can have changed since
+ * the last run (see incremental.h). With -j=N the declarations of the
+ * program are checked on N threads (see Program::CheckInParallel and
+ * workpool.h). -maxerrors=N and -fold cut down the errors reported for
+ * inputs with a great many (see diagnostics.h). With -exprs the input
+ * is taken to be a list of expression statements, for the expression
+ * parser of exprparse.h. -tokens only scans the input and lists the
+ * tokens (see DumpTokens in tokenstream.h), -tokens=count only counts
+ * them.
+ * InitParser() is used to set up the parser. The call to yyparse() will
+ * attempt to parse a complete program from the input. 
+ */
+static int Compile()
+{
+    if (GetOption("maxerrors"))
+        ReportError::SetLimit(atoi(GetOption("maxerrors")));
+    if (GetOption("fold"))
+        ReportError::SetFolding(true);
+  
+    if (GetOption("push")) {
+        int pieceSize = PositiveOption("push", 4096);
+        InitParser();
+        ParseInPieces(stdin, pieceSize);
+        return Finish();
+    }
+
+    if (GetOption("parsejobs")) {
+        InitParser();
+        ParseDeclsInParallel(atoi(GetOption("parsejobs")));
+        return Finish();
+    }
+
+    if (GetOption("stream")) {
+        InitParser();
+        CompileStreaming();
+        return Finish();
+    }
+
+    const char *cacheDir = GetOption("cache");
+    if (cacheDir) {
+        InitParser();
+        CompileWithCache(*cacheDir ? cacheDir : ".dcc-cache");
+        return Finish();
+    }
+
+    const char *depsFile = GetOption("incremental");
+    if (depsFile) {
+        InitParser();
+        CompileIncrementally(*depsFile ? depsFile : ".dcc-deps");
+        return Finish();
+    }
+
+    if (GetOption("lexjobs"))
+        StartChunkedScan(atoi(GetOption("lexjobs")));
+    else if (GetOption("pipeline"))
+        StartScannerThread();
+    else
+        InitScanner();
+    InitParser();
+    const char *tokens = GetOption("tokens");
+    if (tokens) {
+        int count = DumpTokens(strcmp(tokens, "count") ? stdout : NULL);
+        if (!strcmp(tokens, "count"))
+            printf("%d tokens\n", count);
+    } else if (GetOption("exprs")) {
+        List<Expr*> *stmts = ExprParser().ParseExprStmts();
+        if (stmts)
+            PrintDebug("parser", "Parsed %d expression statements", stmts->NumElements());
+    } else
+        yyparse(NULL);
+    return Finish();
+}
+
+
+/* Compiles stdin, or the files given with -batch */
+static int CompileRequested()
+{
+    return GetOption("batch") ? CompileBatch(Compile) : Compile();
+}
 
 
 /* Function: main()
  * ----------------
  * Entry point to the entire program.  We parse the command line and turn
  * on any debugging flags requested by the user when invoking the program.
- * InitScanner() is used to set up the scanner.
- * InitParser() is used to set up the parser. The call to yyparse() will
- * attempt to parse a complete program from the input. 
+ * With -daemon[=socket], programs are compiled for dcc-client rather
+ * than from stdin (see daemon.h), and with -batch[=jobs] the files
+ * named on the command line are (see batch.h).
  */
 int main(int argc, char *argv[])
 {
     ParseCommandLine(argc, argv);
-  
-    InitScanner();
-    InitParser();
-    yyparse();
-    return (ReportError::NumErrors() == 0? 0 : -1);
+    const char *socketPath = GetOption("daemon");
+    if (socketPath) {
+        char path[256];
+        if (!*socketPath) {
+            DefaultSocketPath(path, sizeof(path));
+            socketPath = path;
+        }
+        return ServeCompiles(socketPath, CompileRequested);
+    }
+    return CompileRequested();
 }
-
@@ -0,0 +1,148 @@
+/* File: numbers.cc
+ * ----------------
+ * Implementation of the numeric conversions.
+ *
+ * Integers are accumulated in 64 bits, which cannot overflow for the
+ * at most 10 decimal or 8 hex significant digits that can be in range,
+ * so the range check is one compare at the end. Runs of 8 decimal
+ * digits are converted with a handful of multiplies on the digits
+ * loaded as one word.
+ *
+ * Doubles take Clinger's fast path whenever the significand has at
+ * most 19 digits and fits in 53 bits and the decimal exponent is at
+ * most 22 in magnitude: both the significand and the power of ten are
+ * then exact doubles and one IEEE multiply or divide gives the
+ * correctly rounded result. That covers the constants people write.
+ * Anything else is handed to strtod under the "C" locale, which is
+ * correctly rounded as well.
+ */
+
+#include "numbers.h"
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <locale.h>
+
+
+static inline int DigitValue(char ch) { return ch - '0'; }
+
+/* 0-9 keep their low nibble, a-f and A-F have bit 0x40 set and get 9 added */
+static inline int HexDigitValue(char ch) { return (ch & 0xF) + 9 * ((ch >> 6) & 1); }
+
+
+/* Converts the 8 decimal digits at p with SWAR arithmetic. The digits are
+ * loaded little-endian, so the first one ends up in the lowest byte. */
+static inline uint32_t EightDigits(const char *p)
+{
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    v -= 0x3030303030303030ULL;
+    v = (v * 10) + (v >> 8);
+    v = (((v & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+         (((v >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+    return (uint32_t)v;
+}
+
+static inline bool LittleEndian()
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    return true;
+#else
+    return false;
+#endif
+}
+
+
+bool ParseInteger(const char *text, int len, int *value)
+{
+    const char *p = text, *end = text + len;
+    uint64_t v = 0, limit;
+
+    *value = 0;
+    if (len > 2 && (p[1] == 'x' || p[1] == 'X')) {
+        for (p += 2; p < end && *p == '0'; p++) ;
+        if (end - p > 8) return false;
+        for (; p < end; p++)
+            v = (v << 4) | HexDigitValue(*p);
+        limit = 0xFFFFFFFFULL;
+    } else {
+        for (; p < end && *p == '0'; p++) ;
+        if (end - p > 10) return false;
+        if (LittleEndian() && end - p >= 8) {
+            v = EightDigits(p);
+            p += 8;
+        }
+        for (; p < end; p++)
+            v = v * 10 + DigitValue(*p);
+        limit = 0x7FFFFFFFULL;
+    }
+
+    if (v > limit) return false;
+    *value = (int)(uint32_t)v;
+    return true;
+}
+
+
+static const double exactPowersOfTen[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+static const int MaxExactPower = 22;
+static const uint64_t MaxExactSignificand = 1ULL << 53;
+
+
+/* Function: SlowParseDouble
+ * -------------------------
+ * The fallback, strtod is correctly rounded but needs a terminated string
+ * and must not see a locale whose decimal point is not '.'.
+ */
+static double SlowParseDouble(const char *text, int len)
+{
+    static locale_t cLocale = newlocale(LC_ALL_MASK, "C", (locale_t)0);
+    char buf[64];
+    char *copy = (len < (int)sizeof(buf) ? buf : (char *)malloc(len + 1));
+
+    memcpy(copy, text, len);
+    copy[len] = '\0';
+    double d = strtod_l(copy, NULL, cLocale);
+    if (copy != buf) free(copy);
+    return d;
+}
+
+
+bool ParseDouble(const char *text, int len, double *value)
+{
+    const char *p = text, *end = text + len;
+    uint64_t significand = 0;
+    int digits = 0, exponent = 0;
+
+    for (; p < end && *p == '0'; p++) ;
+    for (; p < end && *p != '.'; p++, digits++)
+        significand = significand * 10 + DigitValue(*p);
+    if (p < end) p++; // the decimal point
+    if (digits == 0)
+        for (; p < end && *p == '0'; p++) exponent--;
+    for (; p < end && *p != 'e' && *p != 'E'; p++, digits++, exponent--)
+        significand = significand * 10 + DigitValue(*p);
+
+    if (p < end) {
+        bool negative = false;
+        int e = 0;
+        p++;
+        if (*p == '+' || *p == '-') negative = (*p++ == '-');
+        for (; p < end; p++)
+            if (e < 100000) e = e * 10 + DigitValue(*p);
+        exponent += (negative ? -e : e);
+    }
+
+    if (digits <= 19 && significand <= MaxExactSignificand &&
+        exponent >= -MaxExactPower && exponent <= MaxExactPower) {
+        double d = (double)significand;
+        *value = (exponent < 0 ? d / exactPowersOfTen[-exponent]
+                               : d * exactPowersOfTen[exponent]);
+        return true;
+    }
+
+    *value = SlowParseDouble(text, len);
+    return *value <= __DBL_MAX__;
+}
@@ -0,0 +1,33 @@
+/* File: numbers.h
+ * ---------------
+ * Conversion of the text of numeric constants into their values. The
+ * scanner already knows the extent and the shape of a lexeme, so these
+ * routines take it as (text, length), need no terminator and do not
+ * depend on the locale. Unlike strtol/atof they tell the caller when a
+ * value does not fit, so the scanner can report it.
+ */
+
+#ifndef _H_numbers
+#define _H_numbers
+
+
+/* Function: ParseInteger()
+ * Usage: if (!ParseInteger(yytext, yyleng, &val)) ...
+ * ---------------------------------------------------
+ * Converts an {INTEGER} or {HEX_INTEGER} lexeme. Decimal constants must
+ * not exceed 2147483647. Hex constants may use all 32 bits, those with
+ * the top bit set denote negative values. Returns false, setting *value
+ * to 0, if the constant is out of range.
+ */
+bool ParseInteger(const char *text, int len, int *value);
+
+
+/* Function: ParseDouble()
+ * Usage: if (!ParseDouble(yytext, yyleng, &val)) ...
+ * --------------------------------------------------
+ * Converts a {DOUBLE} lexeme to the nearest double. Returns false if the
+ * constant is too large to be represented (*value is then infinity).
+ */
+bool ParseDouble(const char *text, int len, double *value);
+
+#endif
@@ -21,7 +21,7 @@
 
  
 // Next, we want to get the exported defines for the token codes and
-// typedef for YYSTYPE and exported global variable yylval.  These
+// typedef for YYSTYPE.  These
 // definitions are generated and written to the y.tab.h header file. But
 // because that header does not have any protection against being
 // re-included and those definitions are also present in the y.tab.c,
@@ -29,11 +29,15 @@
 // we are compiling y.tab.c, which we use the YYBISON symbol for. 
 // Managing C headers can be such a mess! 
 
+struct DeclRange;           // the parser's parameter, see declparse.h
+
 #ifndef YYBISON                 
 #include "y.tab.h"              
+extern YYSTYPE yylval;      // the last token scanned, defined in tokenstream.cc
 #endif
 
-int yyparse();              // Defined in the generated y.tab.c file
+int yyparse(DeclRange *range); // Defined in the generated y.tab.c file
 void InitParser();          // Defined in parser.y
+const char *TokenName(int token); // ditto
 
 #endif
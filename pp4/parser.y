@@ -10,10 +10,35 @@
 #include "parser.h"
 #include "errors.h"
 
-void yyerror(const char *msg); // standard error-handling routine
+void yyerror(yyltype *loc, DeclRange *range, const char *msg); // standard error-handling routine
+
+// Input nested deeper than the stacks start out for makes them grow, up
+// to this many entries (see YYLTYPE_IS_TRIVIAL in location.h)
+#define YYMAXDEPTH 1000000
 
 %}
 
+/* Besides yyparse(), which pulls tokens from yylex(), generate a push
+ * parser (yypush_parse) that is handed one token at a time. See
+ * pushparse.h.
+ */
+%define api.push-pull both
+
+/* The parser keeps its state in locals rather than globals, so that
+ * declarations can be parsed on several threads at once (see
+ * declparse.h). yylval and yylloc are then only where the scanner
+ * leaves each token, yylex() gives the parser copies. range is NULL
+ * unless parsing a single declaration.
+ */
+%define api.pure full
+%param {DeclRange *range}
+
+%code {
+#include "declparse.h"
+
+int yylex(YYSTYPE *val, yyltype *loc, DeclRange *range); // in tokenstream.cc
+}
+
  
 /* yylval 
  * ------
@@ -21,9 +46,9 @@ void yyerror(const char *msg); // standard error-handling routine
 %union {
     int integerConstant;
     bool boolConstant;
-    char *stringConstant;
+    const PooledString *stringConstant;
     double doubleConstant;
-    char identifier[MaxIdentLen+1]; // +1 for terminating null
+    const PooledString *identifier;
     Decl *decl;
     List<Decl*> *declList;
     Type *type;
@@ -53,6 +78,7 @@ void yyerror(const char *msg); // standard error-handling routine
 %token   T_While T_For T_If T_Else T_Return T_Break
 %token   T_New T_NewArray T_Print T_ReadInteger T_ReadLine
 %token   T_Incr T_Decr T_Switch T_Case T_Default T_Colon
+%token   T_ParseDecl  /* never scanned, see Input below */
 
 %token   <identifier> T_Identifier
 %token   <stringConstant> T_StringConstant 
@@ -104,12 +130,20 @@ void yyerror(const char *msg); // standard error-handling routine
  * -----
 	 
  */
+/* With T_ParseDecl in front, the input is a single declaration */
+Input     :    Program
+          |    T_ParseDecl Decl     { range->decl = $2; }
+          ;
+
 Program   :    DeclList            { 
                                       @1; 
                                       Program *program = new Program($1);
                                       // if no errors, advance to next phase
-                                      if (ReportError::NumErrors() == 0) 
-                                          program->Check(); 
+                                      // or hand the program to the caller
+                                      if (ReportError::NumErrors() == 0) {
+                                          if (range) range->program = program;
+                                          else program->Check();
+                                      }
                                     }
           ;
 
@@ -254,32 +288,32 @@ OptExpr   :    Expr                 { $$ = $1; }
           ;
 
 Expr      :    LValue               { $$ = $1; }
-          |    LValue T_Incr        { $$ = new PostfixExpr($1,(new Operator(@2, "++"))); }
+          |    LValue T_Incr        { $$ = new PostfixExpr($1,(new Operator(@2, OpIncrement))); }
                                     //{ $$ = new AssignExpr($1, new Operator(@2,"="), new ArithmeticExpr($1, new Operator(@2, "+"), new IntConstant(@2,1))); }
-          |    LValue T_Decr        { $$ = new PostfixExpr($1,(new Operator(@2, "--"))); }
+          |    LValue T_Decr        { $$ = new PostfixExpr($1,(new Operator(@2, OpDecrement))); }
                                     //{ $$ = new AssignExpr($1, new Operator(@2,"="), new ArithmeticExpr($1, new Operator(@2, "-"), new IntConstant(@2,1))); }
           |    Call
           |    Constant
-          |    LValue '=' Expr      { $$ = new AssignExpr($1, new Operator(@2,"="), $3); }
-          |    Expr '+' Expr        { $$ = new ArithmeticExpr($1, new Operator(@2, "+"), $3); }
-          |    Expr '-' Expr        { $$ = new ArithmeticExpr($1, new Operator(@2, "-"), $3); }
-          |    Expr '/' Expr        { $$ = new ArithmeticExpr($1, new Operator(@2,"/"), $3); }
-          |    Expr '*' Expr        { $$ = new ArithmeticExpr($1, new Operator(@2,"*"), $3); }
-          |    Expr '%' Expr        { $$ = new ArithmeticExpr($1, new Operator(@2,"%"), $3); }
-          |    Expr T_Equal Expr    { $$ = new EqualityExpr($1, new Operator(@2,"=="), $3); }
-          |    Expr T_NotEqual Expr { $$ = new EqualityExpr($1, new Operator(@2,"!="), $3); }
-          |    Expr '<' Expr        { $$ = new RelationalExpr($1, new Operator(@2,"<"), $3); }
-          |    Expr '>' Expr        { $$ = new RelationalExpr($1, new Operator(@2,">"), $3); }
+          |    LValue '=' Expr      { $$ = new AssignExpr($1, new Operator(@2, OpAssign), $3); }
+          |    Expr '+' Expr        { $$ = new ArithmeticExpr($1, new Operator(@2, OpPlus), $3); }
+          |    Expr '-' Expr        { $$ = new ArithmeticExpr($1, new Operator(@2, OpMinus), $3); }
+          |    Expr '/' Expr        { $$ = new ArithmeticExpr($1, new Operator(@2, OpDivide), $3); }
+          |    Expr '*' Expr        { $$ = new ArithmeticExpr($1, new Operator(@2, OpTimes), $3); }
+          |    Expr '%' Expr        { $$ = new ArithmeticExpr($1, new Operator(@2, OpModulo), $3); }
+          |    Expr T_Equal Expr    { $$ = new EqualityExpr($1, new Operator(@2, OpEqual), $3); }
+          |    Expr T_NotEqual Expr { $$ = new EqualityExpr($1, new Operator(@2, OpNotEqual), $3); }
+          |    Expr '<' Expr        { $$ = new RelationalExpr($1, new Operator(@2, OpLess), $3); }
+          |    Expr '>' Expr        { $$ = new RelationalExpr($1, new Operator(@2, OpGreater), $3); }
           |    Expr T_LessEqual Expr 
-                                    { $$ = new RelationalExpr($1, new Operator(@2,"<="), $3); }
+                                    { $$ = new RelationalExpr($1, new Operator(@2, OpLessEqual), $3); }
           |    Expr T_GreaterEqual Expr 
-                                    { $$ = new RelationalExpr($1, new Operator(@2,">="), $3); }
-          |    Expr T_And Expr      { $$ = new LogicalExpr($1, new Operator(@2,"&&"), $3); }
-          |    Expr T_Or Expr       { $$ = new LogicalExpr($1, new Operator(@2,"||"), $3); }
+                                    { $$ = new RelationalExpr($1, new Operator(@2, OpGreaterEqual), $3); }
+          |    Expr T_And Expr      { $$ = new LogicalExpr($1, new Operator(@2, OpAnd), $3); }
+          |    Expr T_Or Expr       { $$ = new LogicalExpr($1, new Operator(@2, OpOr), $3); }
           |    '(' Expr ')'         { $$ = $2; }
           |    '-' Expr  %prec T_UnaryMinus 
-                                    { $$ = new ArithmeticExpr(new Operator(@1,"-"), $2); }
-          |    '!' Expr             { $$ = new LogicalExpr(new Operator(@1,"!"), $2); }
+                                    { $$ = new ArithmeticExpr(new Operator(@1, OpMinus), $2); }
+          |    '!' Expr             { $$ = new LogicalExpr(new Operator(@1, OpNot), $2); }
           |    T_ReadInteger '(' ')'   
                                     { $$ = new ReadIntegerExpr(Join(@1,@3)); }
           |    T_ReadLine '(' ')'   { $$ = new ReadLineExpr(Join(@1,@3)); }
@@ -331,3 +365,14 @@ void InitParser()
    PrintDebug("parser", "Initializing parser");
    yydebug = false;
 }
+
+
+/* Function: TokenName
+ * -------------------
+ * Returns the name the grammar gives a token code, such as "T_Identifier"
+ * or "'+'", for dcc -tokens.
+ */
+const char *TokenName(int token)
+{
+   return yytname[YYTRANSLATE(token)];
+}
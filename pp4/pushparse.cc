@@ -0,0 +1,98 @@
+/* File: pushparse.cc
+ * ------------------
+ * Implementation of the push parser driver.
+ */
+
+#include "pushparse.h"
+#include <string.h>
+#include <stdlib.h>
+#include "parser.h"
+#include "utility.h" // for PrintDebug()
+
+extern List<const char*> savedLines; // defined with the scanner
+
+
+PushParser::PushParser(DeclRange *r) : scanner(&savedLines), range(r)
+{
+    state = yypstate_new();
+    capacity = 1 << 16;
+    buffer = (char *)malloc(capacity);
+    length = 0;
+    status = YYPUSH_MORE;
+}
+
+
+PushParser::~PushParser()
+{
+    yypstate_delete(state);
+    free(buffer);
+}
+
+
+/* Method: ScanAndPush
+ * -------------------
+ * Pushes tokens until the scanner runs out of text, or the parser is
+ * done. Unless atEnd, running out of text is not the end of the input.
+ */
+void PushParser::ScanAndPush(bool atEnd)
+{
+    while (status == YYPUSH_MORE) {
+        int token = scanner.Scan(&yylval, &yylloc);
+        if (token == 0 && !atEnd)
+            return;
+        status = yypush_parse(state, token, &yylval, &yylloc, range);
+        if (token == 0)
+            return;
+    }
+}
+
+
+/* Method: Feed
+ * ------------
+ * The new text is added to the partial line left from before. All the
+ * complete lines are scanned, then the partial line that remains is
+ * moved to the front of the buffer.
+ */
+void PushParser::Feed(const char *text, int len)
+{
+    if (status != YYPUSH_MORE) return; // the parse is over
+
+    if (length + len > capacity) {
+        while (length + len > capacity) capacity *= 2;
+        buffer = (char *)realloc(buffer, capacity);
+    }
+    memcpy(buffer + length, text, len);
+    length += len;
+
+    char *lastNewline = (char *)memrchr(buffer, '\n', length);
+    if (!lastNewline) return;
+
+    int complete = lastNewline + 1 - buffer;
+    scanner.AddInput(buffer, complete, true);
+    ScanAndPush(false);
+    length -= complete;
+    memmove(buffer, buffer + complete, length);
+}
+
+
+void PushParser::Finish()
+{
+    if (status != YYPUSH_MORE) return;
+    scanner.AddInput(buffer, length, false);
+    length = 0;
+    ScanAndPush(true);
+}
+
+
+void ParseInPieces(FILE *fp, int pieceSize)
+{
+    PrintDebug("parser", "Parsing input in pieces of %d bytes", pieceSize);
+
+    PushParser parser;
+    char *piece = (char *)malloc(pieceSize);
+    int n;
+    while ((n = fread(piece, 1, pieceSize, fp)) > 0)
+        parser.Feed(piece, n);
+    parser.Finish();
+    free(piece);
+}
@@ -0,0 +1,65 @@
+/* File: pushparse.h
+ * -----------------
+ * Parsing input that arrives piecemeal. yyparse() pulls its tokens from
+ * a scanner that owns the whole input, so a caller that receives the
+ * source in pieces (from a socket, a pipe, a decompressor) would have
+ * to collect all of it first. A PushParser is instead fed the pieces
+ * as they come. It scans the complete lines it has so far with a
+ * DirectScanner and pushes the tokens into the bison push parser,
+ * keeping only the partial line at the end until the rest of it
+ * arrives. Tokens never span lines and the scanner keeps its state
+ * (comments, line numbers) across pieces, so the result is the same as
+ * scanning and parsing the whole input at once.
+ *
+ * Tokens are scanned into the globals yylval and yylloc, and the lines
+ * saved for error messages are the global ones, so there can be only
+ * one PushParser at a time.
+ */
+
+#ifndef _H_pushparse
+#define _H_pushparse
+
+#include <stdio.h>
+#include "dscanner.h"
+
+struct DeclRange;           // the parser's parameter, see declparse.h
+
+
+class PushParser
+{
+  protected:
+    DirectScanner scanner;
+    struct yypstate *state;
+    DeclRange *range;           // given to the parser, or NULL
+    char *buffer;               // text not scanned yet, a partial line
+    int length, capacity;
+    int status;                 // of the last yypush_parse()
+
+    void ScanAndPush(bool atEnd);
+
+  public:
+          // With a range, the Program rule leaves the program in it
+          // unchecked
+    PushParser(DeclRange *range = NULL);
+    ~PushParser();
+
+          // Adds the next len chars of the input and parses as much of
+          // it as can be
+    void Feed(const char *text, int len);
+
+          // Tells the parser the input is complete and finishes the parse
+    void Finish();
+
+          // True if the parse is over and found no syntax error
+    bool Accepted() { return status == 0; }
+};
+
+
+/* Function: ParseInPieces()
+ * -------------------------
+ * Parses fp by feeding it to a PushParser in pieces of the given size.
+ * Used instead of InitScanner() and yyparse().
+ */
+void ParseInPieces(FILE *fp, int pieceSize);
+
+#endif
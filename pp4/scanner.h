@@ -12,15 +12,20 @@
 #include <stdio.h>
 
 #define MaxIdentLen 31    // Maximum length for identifiers
+#define TAB_SIZE 8        // Distance between tab stops
 
 extern char *yytext;      // Text of lexeme just scanned
 
 
-int yylex();              // Defined in the generated lex.yy.c file
+int yylex();              // Defined in tokenstream.cc, calls ScanToken or
+                          // takes tokens scanned on another thread
+int ScanToken();          // Defined in the generated lex.yy.c file
 void yyrestart(FILE *fp); // ditto
 
 
 void InitScanner();                 // Defined in scanner.l user subroutines
 const char *GetLineNumbered(int n); // ditto
+extern const char *(*lineSource)(int n); // ditto, set to supply the lines
+                                         // of GetLineNumbered() elsewhere
  
 #endif
@@ -0,0 +1,241 @@
+/* File: stream.cc
+ * ---------------
+ * Implementation of streaming compilation.
+ */
+
+#include "stream.h"
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "declparse.h"
+#include "dscanner.h"
+#include "arena.h"
+#include "errors.h"
+#include "walk.h"
+#include "utility.h" // for PrintDebug()
+
+
+/* The input
+ * ---------
+ * Mapped if stdin is a file, else read. Nothing is copied out of it for
+ * error messages, the lines are looked up in it (see TakeLinesFrom).
+ */
+static const char *input;
+static int inputLen;
+static bool mapped;
+static int dropped;             // bytes at the start of the mapping given back
+
+static void ReadStdin()
+{
+    struct stat st;
+    if (fstat(0, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        void *p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, 0, 0);
+        if (p != MAP_FAILED) {
+            input = (const char *)p;
+            inputLen = st.st_size;
+            mapped = true;
+            return;
+        }
+    }
+    input = ReadInput(stdin, &inputLen);
+}
+
+
+/* Gives back the pages of the mapping before pos, they are read again
+ * from the file if they are needed after all. */
+static void DropInputBefore(const char *pos)
+{
+    if (!mapped) return;
+    long pageSize = sysconf(_SC_PAGESIZE);
+    int upTo = (pos - input) / pageSize * pageSize;
+    if (upTo <= dropped) return;
+    madvise((char *)input + dropped, upTo - dropped, MADV_DONTNEED);
+    dropped = upTo;
+}
+
+
+/* A scanner that saves no lines and, in the second pass, does not
+ * report the errors the first pass has reported already. */
+class StreamScanner : public DirectScanner
+{
+  protected:
+    bool quiet;
+
+    void LexError(LexErrorKind kind, yyltype *loc, const char *text, int len) {
+        if (!quiet) DirectScanner::LexError(kind, loc, text, len);
+    }
+
+  public:
+    StreamScanner(bool reportErrors) : DirectScanner(NULL), quiet(!reportErrors) {
+        SetInput(input, inputLen);
+    }
+    const char *Position() { return cur; }
+};
+
+
+/* The tokens of the current declaration */
+struct StreamToken {
+    int code;
+    YYSTYPE value;
+    yyltype loc;
+};
+
+static StreamToken *tokens = NULL;
+static int numTokens, maxTokens;
+
+static void AddToken(int code, YYSTYPE *val, yyltype *loc)
+{
+    if (numTokens == maxTokens) {
+        maxTokens = (maxTokens ? 2*maxTokens : 1024);
+        tokens = (StreamToken *)realloc(tokens, maxTokens*sizeof(StreamToken));
+        if (!tokens) Failure("Out of memory!");
+    }
+    tokens[numTokens].code = code;
+    tokens[numTokens].value = *val;
+    tokens[numTokens].loc = *loc;
+    numTokens++;
+}
+
+
+/* Function: ScanDecl
+ * ------------------
+ * Scans the next declaration into tokens: up to a ';' outside of braces
+ * or the '}' that closes the outermost brace (or is unmatched), as in
+ * declparse.cc. At the end of the input the 0 is kept as well. With
+ * skipBodies, the tokens between the braces of a function body (the
+ * '{' that follows a ')') are scanned but left out.
+ */
+static void ScanDecl(StreamScanner *scanner, bool skipBodies)
+{
+    int depth = 0, bodyDepth = 0, prev = 0; // bodyDepth 0 when not in a body
+    YYSTYPE val;
+    yyltype loc;
+
+    numTokens = 0;
+    for (;;) {
+        int code = scanner->Scan(&val, &loc);
+        bool keep = (bodyDepth == 0);
+        if (code == '{') {
+            depth++;
+            if (skipBodies && bodyDepth == 0 && prev == ')') bodyDepth = depth;
+        } else if (code == '}') {
+            if (depth == bodyDepth) bodyDepth = 0, keep = true;
+            if (depth > 0) depth--;
+        }
+        if (keep || code == 0) AddToken(code, &val, &loc);
+        if (code == 0) return;
+        if (bodyDepth == 0 && depth == 0 && (code == ';' || code == '}')) return;
+        prev = code;
+    }
+}
+
+
+/* The declaration in tokens, for yyparse() */
+struct ScannedDecl : public DeclRange {
+    ScannedDecl(bool report) : DeclRange(0, numTokens) { reportErrors = report; }
+
+    int GetToken(int index, YYSTYPE *val, yyltype *loc) {
+        *val = tokens[index].value;
+        *loc = tokens[index].loc;
+        return tokens[index].code;
+    }
+};
+
+
+/* Function: SwapBodies
+ * --------------------
+ * Exchanges the bodies of the functions in kept, a declaration from the
+ * first pass, with those of full, the same one parsed again. If
+ * buildScopes, the scopes of the bodies kept gets are built as
+ * FnDecl::ScopeBuilder would.
+ */
+static void SwapBodies(Decl *kept, Decl *full, bool buildScopes)
+{
+    FnDecl *fn = dynamic_cast<FnDecl*>(kept);
+    if (fn) {
+        FnDecl *other = dynamic_cast<FnDecl*>(full);
+        Stmt *body = fn->GetBody();
+        fn->SetFunctionBody(other->GetBody());
+        other->SetFunctionBody(body);
+        if (buildScopes)
+            BuildScopes(fn->GetBody(), fn->GetScope());
+        return;
+    }
+    ClassDecl *c = dynamic_cast<ClassDecl*>(kept);
+    if (c) {
+        List<Decl*> *members = c->GetMembers();
+        List<Decl*> *others = dynamic_cast<ClassDecl*>(full)->GetMembers();
+        for (int i = 0, n = members->NumElements(); i < n; ++i)
+            SwapBodies(members->Nth(i), others->Nth(i), buildScopes);
+    }
+}
+
+
+static bool StartsDecl(int code)
+{
+    switch (code) {
+      case T_Void: case T_Int: case T_Double: case T_Bool: case T_String:
+      case T_Identifier: case T_Class: case T_Interface:
+        return true;
+      default:
+        return false;
+    }
+}
+
+
+void CompileStreaming()
+{
+    PrintDebug("stream", "Compiling one declaration at a time");
+    ReadStdin();
+    TakeLinesFrom(input, inputLen);
+
+    // A syntax error found here is not reported: it may be one the
+    // second pass finds earlier, in a function body, or bodies left out
+    // because of unbalanced braces may have put it in the wrong place.
+    List<Decl*> *decls = new List<Decl*>;
+    StreamScanner scanner(true);
+    bool parsed = true;
+    for (;;) {
+        ScanDecl(&scanner, true);
+        if (numTokens == 1 && tokens[0].code == 0 && decls->NumElements() > 0)
+            break; // DeclList is not empty
+        ScannedDecl range(false);
+        if (!(parsed = (yyparse(&range) == 0))) break;
+        decls->Append(range.decl);
+        DropInputBefore(scanner.Position());
+    }
+    Program *program = new Program(decls);
+    // as in the Program rule: if no errors, advance to next phase (bison
+    // reduces it before reporting a token that cannot start a Decl)
+    bool check = ((parsed || !StartsDecl(tokens[0].code)) &&
+                  ReportError::NumErrors() == 0);
+    if (check)
+        program->ScopeBuilder();
+    PrintDebug("stream", "Kept %d declarations", decls->NumElements());
+
+    // If the first pass stopped at a syntax error, this one goes on
+    // until it reports it (the tokens are the same but for the bodies).
+    dropped = 0;
+    Arena arena(1024*1024);
+    StreamScanner again(false);
+    for (int i = 0; i < decls->NumElements() || !parsed; i++) {
+        ScanDecl(&again, false);
+        ScannedDecl range(true);
+        bool ok;
+        {
+            UseArena use(&arena);
+            ok = (yyparse(&range) == 0);
+            if (ok && check && !ReportError::LimitReached()) {
+                Decl *decl = decls->Nth(i);
+                SwapBodies(decl, range.decl, true);
+                CheckTree(decl);
+                SwapBodies(decl, range.decl, false);
+            }
+        }
+        arena.Reset();
+        if (!ok) return;
+        DropInputBefore(again.Position());
+    }
+}
@@ -0,0 +1,47 @@
+/* File: stream.h
+ * --------------
+ * Compiling programs too big to hold in memory as a whole. With -stream
+ * on the command line, the input is gone through twice, one top-level
+ * declaration at a time (cut the way declparse.h does it):
+ *
+ *   1. Each declaration is parsed with the bodies of its functions left
+ *      out. They are still scanned, so every lexical error is reported
+ *      in this pass, but only the braces around them get to the parser.
+ *      What is left (classes and interfaces with their members, global
+ *      variables, function signatures) is kept and makes up the Program,
+ *      whose global scope is then built, so every declaration can see
+ *      all the others.
+ *   2. Each declaration is parsed again, bodies included. The bodies
+ *      are put into the declaration kept from the first pass, which is
+ *      then checked, and taken out again. The nodes, scopes and lists
+ *      made while doing that come from an arena (see UseArena in
+ *      arena.h) that is emptied before the next declaration.
+ *
+ * So memory use follows the size of the signatures and of the largest
+ * declaration rather than the size of the program. No lines are copied
+ * for error messages either, they are looked up in the input when they
+ * are needed, and the input itself is mapped rather than read when it
+ * is a file, with the pages that have been scanned given back.
+ *
+ * A valid program gives the same output as without -stream, and so do
+ * most invalid ones, but some messages come out in a different order:
+ * conflicting declarations in a function body are reported with the
+ * other errors of that function, after the errors of the declarations
+ * before it, and a syntax error inside a function body only shows up in
+ * the second pass, after all lexical errors and the errors found in the
+ * declarations before it. Lexical errors that follow a syntax error in
+ * the same declaration are reported too.
+ */
+
+#ifndef _H_stream
+#define _H_stream
+
+
+/* Function: CompileStreaming()
+ * ----------------------------
+ * Scans, parses and checks all of stdin as described above. Used
+ * instead of InitScanner() and yyparse().
+ */
+void CompileStreaming();
+
+#endif
@@ -0,0 +1,85 @@
+/* File: strpool.cc
+ * ----------------
+ * Implementation of the string pool, a chained hash table on FNV-1a
+ * hashes that doubles its bucket array when it gets full.
+ */
+
+#include "strpool.h"
+#include <string.h>
+#include <stdlib.h>
+
+
+StringPool stringLiterals;
+StringPool identifierNames;
+
+static const int InitialBuckets = 256;
+
+
+static inline unsigned Hash(const char *text, int len)
+{
+    unsigned h = 2166136261u;
+    for (int i = 0; i < len; i++)
+        h = (h ^ (unsigned char)text[i]) * 16777619u;
+    return h;
+}
+
+
+StringPool::StringPool()
+{
+    numBuckets = InitialBuckets;
+    buckets = (PooledString **)calloc(numBuckets, sizeof(PooledString*));
+}
+
+
+StringPool::~StringPool()
+{
+    free(buckets);
+}
+
+
+const PooledString *StringPool::Intern(const char *text, int len)
+{
+    unsigned h = Hash(text, len);
+    for (PooledString *s = buckets[h & (numBuckets-1)]; s; s = s->chain)
+        if (s->length == len && memcmp(s->chars, text, len) == 0)
+            return s;
+
+    if (entries.NumElements() >= numBuckets)
+        Grow();
+
+    PooledString *s = (PooledString *)arena.Alloc(sizeof(PooledString));
+    s->chars = arena.CopyString(text, len);
+    s->length = len;
+    s->index = entries.NumElements();
+    s->chain = buckets[h & (numBuckets-1)];
+    buckets[h & (numBuckets-1)] = s;
+    entries.Append(s);
+    return s;
+}
+
+
+/* Method: Grow
+ * ------------
+ * Doubles the number of buckets and rehashes the entries into them.
+ */
+void StringPool::Grow()
+{
+    free(buckets);
+    numBuckets *= 2;
+    buckets = (PooledString **)calloc(numBuckets, sizeof(PooledString*));
+    for (int i = 0; i < entries.NumElements(); i++) {
+        PooledString *s = entries.Nth(i);
+        unsigned slot = Hash(s->chars, s->length) & (numBuckets-1);
+        s->chain = buckets[slot];
+        buckets[slot] = s;
+    }
+}
+
+
+void StringPool::Clear()
+{
+    while (entries.NumElements() > 0)
+        entries.RemoveAt(entries.NumElements()-1);
+    memset(buckets, 0, numBuckets * sizeof(PooledString*));
+    arena.Reset();
+}
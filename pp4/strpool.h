@@ -0,0 +1,63 @@
+/* File: strpool.h
+ * ---------------
+ * A pool of unique strings. Interning a piece of text returns the one
+ * entry for that text, creating it on first use, so equal texts share
+ * the same storage and the entries can be compared by address. The
+ * characters live in an arena owned by the pool and stay valid until
+ * the pool is cleared. Each entry knows its length and its index, the
+ * order in which the distinct strings were first seen.
+ *
+ * The scanner interns the lexemes of all string constants into the
+ * global stringLiterals pool, which therefore ends up as the constant
+ * pool of the program being compiled, and the (possibly truncated)
+ * names of all identifiers into identifierNames, so that a token value
+ * is a single pointer and names can be compared by address.
+ */
+
+#ifndef _H_strpool
+#define _H_strpool
+
+#include "arena.h"
+#include "list.h"
+
+
+struct PooledString
+{
+    const char *chars;          // null-terminated
+    int length;                 // not counting the null
+    int index;                  // position in the pool
+    PooledString *chain;        // next entry in the same bucket
+};
+
+
+class StringPool
+{
+  protected:
+    Arena arena;
+    PooledString **buckets;
+    int numBuckets;
+    List<PooledString*> entries;
+
+    void Grow();
+
+  public:
+    StringPool();
+    ~StringPool();
+
+          // Returns the entry for the len chars at text (which need not be
+          // null-terminated), adding it if this text was not seen before
+    const PooledString *Intern(const char *text, int len);
+
+          // Number of distinct strings and access to them by index
+    int NumEntries() const { return entries.NumElements(); }
+    const PooledString *Nth(int index) const { return entries.Nth(index); }
+
+          // Forgets all entries and frees their storage
+    void Clear();
+};
+
+
+extern StringPool stringLiterals;  // lexemes of string constants, quotes included
+extern StringPool identifierNames; // names of identifiers
+
+#endif
@@ -0,0 +1,36 @@
+#!/bin/sh
+# File: tests/batch.sh
+# --------------------
+# Checks -batch (see batch.h): compiles every sample in one ./dcc
+# -batch=2, and compares each file's part of the report, its status line
+# and the output after it, with what ./dcc < file prints and its exit
+# status. The exit status of the batch must be 1 if any file failed.
+# Exits 1 if anything differs.
+
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+./dcc -batch=2 samples/*.decaf > "$work/got" 2>&1
+gotStatus=$?
+
+expectedStatus=0
+for input in samples/*.decaf; do
+    ./dcc < "$input" > "$work/out" 2>&1
+    status=$?
+    [ $status = 0 ] || expectedStatus=1
+    echo "=== $input: exit status $status"
+    cat "$work/out"
+done > "$work/expected"
+
+failed=0
+if ! cmp -s "$work/got" "$work/expected"; then
+    echo "FAIL: ./dcc -batch=2 samples/*.decaf"
+    diff "$work/expected" "$work/got" | head -5
+    failed=1
+fi
+if [ $gotStatus != $expectedStatus ]; then
+    echo "FAIL: ./dcc -batch=2 exit status $gotStatus, not $expectedStatus"
+    failed=1
+fi
+[ $failed = 0 ] && echo "batch: the report matches dcc on every sample"
+exit $failed
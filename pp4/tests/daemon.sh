@@ -0,0 +1,70 @@
+#!/bin/sh
+# File: tests/daemon.sh
+# ---------------------
+# Checks dcc-client through a daemon (see daemon.h): starts ./dcc -daemon
+# on a socket in a scratch directory, compiles every sample with
+# ./dcc-client, as is and with -j=2, and compares what it prints and its
+# exit status with those of ./dcc. The daemon must have served them all
+# (the client would otherwise compile on its own), a second daemon on
+# the same socket must refuse to start, and the first must have written
+# no messages by the time it is stopped. Exits 1 if anything differs.
+
+work=$(mktemp -d)
+DCC_SOCKET=$work/socket
+export DCC_SOCKET
+daemon=
+trap '[ -n "$daemon" ] && kill $daemon 2>/dev/null; rm -rf "$work"' EXIT
+
+./dcc -daemon -d daemon > "$work/daemon.out" 2> "$work/daemon.err" &
+daemon=$!
+for i in $(seq 100); do
+    [ -S "$DCC_SOCKET" ] && break
+    sleep 0.05
+done
+if [ ! -S "$DCC_SOCKET" ]; then
+    echo "FAIL: the daemon did not start"
+    cat "$work/daemon.err"
+    exit 1
+fi
+
+failed=0
+requests=0
+for input in samples/*.decaf; do
+    for options in "" -j=2; do
+        ./dcc-client $options < "$input" > "$work/got" 2>&1
+        gotStatus=$?
+        ./dcc $options < "$input" > "$work/expected" 2>&1
+        expectedStatus=$?
+        if [ $gotStatus != $expectedStatus ] || ! cmp -s "$work/got" "$work/expected"; then
+            echo "FAIL: ./dcc-client $options < $input, exit status $gotStatus"
+            diff "$work/expected" "$work/got" | head -5
+            failed=1
+        fi
+        requests=$((requests + 1))
+    done
+done
+
+if ./dcc -daemon 2> "$work/second.err"; then
+    echo "FAIL: a second daemon started on the same socket"
+    failed=1
+fi
+
+kill $daemon
+wait $daemon
+daemon=
+if [ -s "$work/daemon.err" ]; then
+    echo "FAIL: the daemon wrote"
+    head -5 "$work/daemon.err"
+    failed=1
+fi
+served=$(grep -c "Request .*: status" "$work/daemon.out")
+if [ $served -lt $requests ]; then
+    echo "FAIL: the daemon served $served of the $requests requests"
+    failed=1
+fi
+if [ -e "$DCC_SOCKET" ]; then
+    echo "FAIL: the daemon left its socket behind"
+    failed=1
+fi
+[ $failed = 0 ] && echo "daemon: dcc-client gives the same output as dcc on every sample"
+exit $failed
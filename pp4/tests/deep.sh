@@ -0,0 +1,53 @@
+#!/bin/sh
+# File: tests/deep.sh
+# -------------------
+# Compiles deeply nested programs with ./dcc (or the dcc given) limited
+# to a 1 MB stack (ulimit -s 1024), to check that parsing, building the
+# scopes, checking and typing do not recurse once per level (see
+# walk.h). The programs, made here, have no errors, so dcc must print
+# nothing and exit with 0:
+#
+#   parens   x = ((( ... 1 ... )));        50000 levels
+#   chain    x = x + x + ... + x;          100000 terms
+#   blocks   { { ... } }                   10000 levels
+#   ifs      if (true) if (true) ... x = 1; 10000 levels
+#   right    x = 1 + (1 + (1 + ... ));     20000 levels
+#   minus    x = - - - ... 1;              50000 levels
+#
+# Usage: tests/deep.sh [dcc]. Exits 1 if any of them fails.
+
+dcc=${1:-./dcc}
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+awk -v out="$work" '
+function program(name, body) {
+    print "void main() {\n    int x;\n    " body "\n}" > (out "/" name ".decaf")
+}
+function repeat(s, n,   r) {
+    r = ""
+    for (; n > 0; n--) r = r s
+    return r
+}
+BEGIN {
+    program("parens", "x = " repeat("(", 50000) "1" repeat(")", 50000) ";")
+    program("chain", "x = x" repeat(" + x", 99999) ";")
+    program("blocks", repeat("{ ", 10000) "x = 1;" repeat(" }", 10000))
+    program("ifs", repeat("if (true) ", 10000) "x = 1;")
+    program("right", "x = " repeat("1 + (", 20000) "1" repeat(")", 20000) ";")
+    program("minus", "x = " repeat("- ", 50000) "1;")
+}'
+
+failed=0
+for input in "$work"/*.decaf; do
+    name=$(basename "$input" .decaf)
+    (ulimit -s 1024 && exec "$dcc" < "$input") > "$work/out" 2>&1
+    status=$?
+    if [ $status != 0 ] || [ -s "$work/out" ]; then
+        echo "FAIL: $name, exit status $status"
+        head -4 "$work/out" | cut -c1-72
+        failed=1
+    fi
+done
+[ $failed = 0 ] && echo "deep: all pass with $dcc in a 1 MB stack"
+exit $failed
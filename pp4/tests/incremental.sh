@@ -0,0 +1,114 @@
+#!/bin/sh
+# File: tests/incremental.sh
+# --------------------------
+# Checks -incremental (see incremental.h) along a chain of edits to one
+# program: each version is compiled with ./dcc -incremental, keeping the
+# file from the version before, and what it prints and its exit status
+# are compared with those of ./dcc on its own. The edits change a
+# function body, an interface and a superclass under a class that is
+# not edited, add and remove a global that an unchanged function uses
+# without declaring it, and the file is truncated and filled with
+# garbage in between. The chain is run as is and with -j=2 -fold. The
+# body edit must check only the function edited, as -d incremental
+# reports. Exits 1 if anything differs.
+
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+program=$work/program.decaf
+failed=0
+
+# Compiles the program both ways; the name says what the step did
+compare() {
+    ./dcc $options -incremental="$work/deps" -d incremental < "$program" > "$work/out" 2>&1
+    gotStatus=$?
+    grep -v '^+++ (incremental)' "$work/out" > "$work/got"
+    ./dcc $options < "$program" > "$work/expected" 2>&1
+    expectedStatus=$?
+    if [ $gotStatus != $expectedStatus ] || ! cmp -s "$work/got" "$work/expected"; then
+        echo "FAIL: $1, with $options -incremental"
+        diff "$work/expected" "$work/got" | head -5
+        failed=1
+    fi
+}
+
+# Edits the program with the sed script given
+edit() {
+    sed "$1" "$program" > "$work/edited" && mv "$work/edited" "$program"
+}
+
+for options in "" "-j=2 -fold"; do
+    rm -f "$work/deps"
+    cat > "$program" <<'EOF'
+interface Shape {
+  double Area();
+}
+
+class Point {
+  int x;
+  int GetX() { return x; }
+}
+
+class Square extends Point {
+  double side;
+}
+
+class Circle extends Point implements Shape {
+  double r;
+  double Area() { return 3.14 * r * r; }
+}
+
+int Twice(int n) {
+  return n * 2;
+}
+
+void Use() {
+  Circle c;
+  c = New(Circle);
+  Print(c.GetX(), c.Area(), Twice(3));
+  Print(total);
+}
+
+void main() {
+  Use();
+}
+EOF
+    compare "first compile"
+    compare "unchanged"
+
+    edit 's/return n \* 2;/return n * true;/'
+    compare "body edit"
+    if ! grep -q "checked 1 of 7 declarations" "$work/out"; then
+        echo "FAIL: the body edit did not check only the function edited, with $options"
+        grep '^+++ (incremental)' "$work/out"
+        failed=1
+    fi
+    edit 's/return n \* true;/return n + n;/'
+    compare "body edit back"
+
+    edit 's/  double Area();/  double Area();\n  int Sides();/'
+    compare "interface gains a method"
+    edit 's/  double Area() { return 3.14 \* r \* r; }/&\n  int Sides() { return 0; }/'
+    compare "class implements it"
+
+    edit 's/class Circle extends Point/class Circle extends Square/'
+    compare "superclass changed"
+    edit 's/  double side;/  double side;\n  int Area() { return 0; }/'
+    compare "superclass gains a clashing method"
+    edit '/  int Area() { return 0; }/d'
+    compare "superclass loses it"
+
+    edit 's/^void Use() {/int total;\n\nvoid Use() {/'
+    compare "global added for an undeclared name"
+    edit '/^int total;$/d'
+    compare "global removed"
+
+    head -c 40 "$work/deps" > "$work/truncated" && mv "$work/truncated" "$work/deps"
+    edit 's/Twice(3)/Twice(4)/'
+    compare "truncated file"
+    echo "garbage" > "$work/deps"
+    edit 's/Twice(4)/Twice(true)/'
+    compare "garbage file"
+    compare "after the garbage file"
+done
+[ $failed = 0 ] && echo "incremental: every step matches dcc without -incremental"
+exit $failed
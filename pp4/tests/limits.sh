@@ -0,0 +1,23 @@
+#!/bin/sh
+# File: tests/limits.sh
+# ---------------------
+# Checks -fold and -maxerrors (see diagnostics.h) on samples/bad15, a
+# flood of errors, many of them with the same message. It is compiled
+# with -fold, -maxerrors=5 and both, on their own and with -j=2 and
+# -stream, and what ./dcc prints is compared with samples/bad15.fold.out,
+# bad15.maxerrors5.out and bad15.fold-maxerrors5.out. Exits 1 if any
+# differ.
+
+failed=0
+for test in fold:-fold maxerrors5:-maxerrors=5 fold-maxerrors5:"-fold -maxerrors=5"; do
+    expected=samples/bad15.${test%%:*}.out
+    options=${test#*:}
+    for mode in "" -j=2 -stream; do
+        if ! ./dcc $options $mode < samples/bad15.decaf 2>&1 | cmp -s - "$expected"; then
+            echo "FAIL: ./dcc $options $mode < samples/bad15.decaf"
+            failed=1
+        fi
+    done
+done
+[ $failed = 0 ] && echo "limits: all pass with -fold and -maxerrors"
+exit $failed
@@ -0,0 +1,22 @@
+#!/bin/sh
+# File: tests/options.sh
+# ----------------------
+# Checks that ./dcc refuses option values it cannot use: each of the
+# command lines below must fail with a message that names the option,
+# rather than compile the program some other way. Exits 1 if any does
+# not.
+
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+failed=0
+for options in -push=0 -push=-5 -push=abc -push=12x; do
+    status=$( (./dcc $options < samples/t1.decaf > "$work/out" 2>&1; echo $?) 2>/dev/null)
+    if [ $status = 0 ] || ! grep -q "^\*\*\* Failure: ${options%%=*} " "$work/out"; then
+        echo "FAIL: ./dcc $options, exit status $status"
+        head -4 "$work/out"
+        failed=1
+    fi
+done
+[ $failed = 0 ] && echo "options: all bad values refused"
+exit $failed
@@ -0,0 +1,17 @@
+#!/bin/sh
+# File: tests/samples.sh
+# ----------------------
+# Compiles every sample with ./dcc and the options given, and compares
+# what it prints with the sample's .out file. Run from the directory
+# with dcc in it, e.g. tests/samples.sh -stream. Exits 1 if any differ.
+
+failed=0
+for input in samples/*.decaf; do
+    expected=${input%.decaf}.out
+    if ! ./dcc "$@" < "$input" 2>&1 | cmp -s - "$expected"; then
+        echo "FAIL: ./dcc $* < $input"
+        failed=1
+    fi
+done
+[ $failed = 0 ] && echo "samples: all pass with ./dcc $*"
+exit $failed
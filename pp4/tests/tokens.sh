@@ -0,0 +1,85 @@
+#!/bin/sh
+# File: tests/tokens.sh
+# ---------------------
+# Checks that the flex scanner and the DirectScanner (see dscanner.h)
+# see the same tokens. Runs dcc -tokens built with each of them over the
+# samples and over some inputs made here to catch the edge cases (runs
+# of blanks and comments far longer than flex's buffer, unterminated
+# comments and strings, stray characters), and diffs the dumps, errors
+# included. The direct build is also run with -pipeline and with
+# -lexjobs=2, 3 and 4, which scan on other threads. Two of the inputs
+# are over 1 MB, so that -lexjobs cuts them into chunks: one with
+# comments, strings and stray characters on every few lines around
+# wherever the cuts fall, one in which a single comment runs over all
+# the cuts but the first and last, so that the chunks after them are
+# scanned again (checked with -d lex).
+#
+# Usage: tests/tokens.sh [flex-dcc direct-dcc]
+# Without arguments both are built in a scratch copy of this directory,
+# which needs flex. Exits 1 if any dump differs.
+
+src=$(pwd)
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+if [ $# = 2 ]; then
+    flexdcc=$1 directdcc=$2
+else
+    cp "$src"/Makefile "$src"/*.cc "$src"/*.h "$src"/*.l "$src"/*.y "$work"/ || exit 1
+    for scanner in flex direct; do
+        (cd "$work" && make clean >/dev/null && make SCANNER=$scanner dcc >/dev/null 2>&1 &&
+         mv dcc dcc-$scanner) || { echo "tokens: cannot build dcc with SCANNER=$scanner"; exit 1; }
+    done
+    flexdcc=$work/dcc-flex directdcc=$work/dcc-direct
+fi
+
+mkdir "$work/inputs"
+awk 'BEGIN {
+    s = ""; for (i = 0; i < 40000; i++) s = s " ";
+    t = ""; for (i = 0; i < 3000; i++) t = t "\t \t";
+    c = ""; for (i = 0; i < 6000; i++) c = c "** /*\t/ ";
+    print "int x;" s "int y;" t "x = 1;"  > "'"$work"'/inputs/blanks.decaf";
+    print "/*" c "*/ void f() { x = 0x1F + 1.5E+3; }" > "'"$work"'/inputs/comment.decaf";
+    print "/* a\n\t" c "\n" c "*" > "'"$work"'/inputs/unterm.decaf";
+    print "\"abc\n\"" s "\"\nx @ # $ 12.e3 1.5e 0X 00012 a_b_" s "c" > "'"$work"'/inputs/odd.decaf";
+}'
+awk -v mixed="$work/inputs/mixed.decaf" -v long="$work/inputs/longcomment.decaf" 'BEGIN {
+    srand(1);
+    for (i = 0; i < 40000; i++) {
+        r = rand();
+        if (r < 0.3) print "  s = \"a /* not " i " */ b\" + \"//\";" > mixed;
+        else if (r < 0.45) print "  /* from " i " \"" > mixed;
+        else if (r < 0.6) print "  * still \"/* " i " */ x = " i ";" > mixed;
+        else if (r < 0.7) print "  // " i " /* not a comment" > mixed;
+        else if (r < 0.72) print "  x = \"unterminated " i " @ #;" > mixed;
+        else print "  x = x + " i " * 1.5E+3; y = 0x" i ";" > mixed;
+    }
+    for (i = 0; i < 40000; i++) {
+        if (i == 8000) print "/* from here on to 4/5 of the way \"" > long;
+        else if (i == 32000) print "\" */ x = " i "; @" > long;
+        else if (i > 8000 && i < 32000) print "  ** \"/* " i " \" x = 1; ++" > long;
+        else print "  x = \"/* " i " */\" + " i "; // */" > long;
+    }
+}'
+
+failed=0
+for input in samples/*.decaf "$work"/inputs/*.decaf; do
+    "$flexdcc" -tokens < "$input" > "$work/expected" 2>&1
+    for options in "" -pipeline -lexjobs=2 -lexjobs=3 -lexjobs=4; do
+        "$directdcc" -tokens $options < "$input" > "$work/got" 2>&1
+        if ! cmp -s "$work/expected" "$work/got"; then
+            echo "FAIL: $(basename "$input") $options"
+            diff "$work/expected" "$work/got" | head -5
+            failed=1
+        fi
+    done
+done
+for jobs in 2 3 4; do
+    if ! "$directdcc" -tokens=count -lexjobs=$jobs -d lex < "$work/inputs/longcomment.decaf" 2>/dev/null |
+         grep -q "Scanning chunk $((jobs - 1)) again"; then
+        echo "FAIL: longcomment.decaf -lexjobs=$jobs did not scan the last chunk again"
+        failed=1
+    fi
+done
+[ $failed = 0 ] && echo "tokens: the scanners agree on every input"
+exit $failed
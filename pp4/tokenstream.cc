@@ -0,0 +1,454 @@
+/* File: tokenstream.cc
+ * --------------------
+ * Implementation of the scanner/parser pipeline, and of yylex().
+ *
+ * The flex scanner keeps its state in globals that it shares with the
+ * parser (yylval, yylloc), so the scanner thread always runs a
+ * DirectScanner, whichever scanner was picked at build time.
+ *
+ * A fixed number of blocks circulate between the two threads through
+ * two single-producer single-consumer rings: full blocks go from the
+ * scanner to the parser, empty ones back. A thread that finds its ring
+ * empty yields until the other one catches up.
+ *
+ * A chunk scanner instead appends newly allocated blocks to a list of
+ * the chunk, which the parser takes over after joining its thread.
+ * ScanAhead() does the same for the whole input on the calling thread.
+ *
+ * The parser is pure (see parser.y) and gets copies of yylval and
+ * yylloc from yylex(); the globals are the scanner's.
+ */
+
+#include "tokenstream.h"
+#include "declparse.h"
+#include <atomic>
+#include <thread>
+#include <stdlib.h>
+#include <string.h>
+#include "scanner.h"
+#include "dscanner.h"
+#include "parser.h"
+#include "utility.h" // for PrintDebug()
+
+extern List<const char*> savedLines; // defined with the scanner
+
+YYSTYPE yylval;
+yyltype yylloc = { 1, 1, 1, 1 }; // as bison initialized it
+
+static const int BlockSize = 1024;          // tokens per block
+static const int RingSize = 8;              // blocks in circulation, a power of 2
+static const int MinChunkSize = 256*1024;   // smaller inputs are not split as much
+
+
+/* A lexical error found while filling a block, it is reported just
+ * before the token at tokenIndex is handed to the parser. */
+struct LexErrorRecord {
+    int tokenIndex;
+    LexErrorKind kind;
+    int line, firstColumn, lastColumn;
+    char *text;
+};
+
+struct TokenBlock {
+    int numTokens;
+    int codes[BlockSize];
+    YYSTYPE values[BlockSize];
+    int lines[BlockSize];           // the parts of yylloc set by the scanner
+    int firstColumns[BlockSize];
+    int lastColumns[BlockSize];
+    List<const char*> savedLines;   // lines copied while filling the block
+    List<LexErrorRecord> errors;
+};
+
+
+class BlockRing
+{
+  protected:
+    TokenBlock *slots[RingSize];
+    std::atomic<unsigned> head, tail; // next slot to pop, next to push
+
+  public:
+    BlockRing() : head(0), tail(0) {}
+
+    void Push(TokenBlock *block) {
+        unsigned t = tail.load(std::memory_order_relaxed);
+        while (t - head.load(std::memory_order_acquire) == RingSize)
+            std::this_thread::yield();
+        slots[t & (RingSize-1)] = block;
+        tail.store(t + 1, std::memory_order_release);
+    }
+
+    TokenBlock *Pop() {
+        unsigned h = head.load(std::memory_order_relaxed);
+        while (tail.load(std::memory_order_acquire) == h)
+            std::this_thread::yield();
+        TokenBlock *block = slots[h & (RingSize-1)];
+        head.store(h + 1, std::memory_order_release);
+        return block;
+    }
+};
+
+static BlockRing fullBlocks, emptyBlocks;
+static bool pipelined = false; // tokens come from blocks
+
+
+/* Scanner side
+ * ------------
+ * A DirectScanner that saves lines and errors into the block being filled.
+ */
+class BlockScanner : public DirectScanner
+{
+  protected:
+    TokenBlock *block;
+    bool atEnd;                 // the text ends the input
+
+    void LexError(LexErrorKind kind, yyltype *loc, const char *text, int len);
+
+  public:
+    BlockScanner(StringPool *namePool, StringPool *literalPool, bool endsInput)
+      : DirectScanner(NULL), block(NULL), atEnd(endsInput) {
+        names = namePool;
+        literals = literalPool;
+    }
+
+          // Scans tokens into b until it is full or the text ends,
+          // returns false in the latter case
+    bool Fill(TokenBlock *b, yyltype *loc);
+
+    void SetInComment(bool b) { inComment = b; }
+    bool InComment() { return inComment; }
+    int NumLinesScanned() { return lineNum - 1; }
+};
+
+
+bool BlockScanner::Fill(TokenBlock *b, yyltype *loc)
+{
+    block = b;
+    lines = &b->savedLines;
+    b->savedLines.Clear();
+    b->errors.Clear();
+
+    for (b->numTokens = 0; b->numTokens < BlockSize; b->numTokens++) {
+        int i = b->numTokens;
+        b->codes[i] = Scan(&b->values[i], loc);
+        b->lines[i] = loc->first_line;
+        b->firstColumns[i] = loc->first_column;
+        b->lastColumns[i] = loc->last_column;
+        if (b->codes[i] == 0) {
+            b->numTokens++;
+            return false;
+        }
+    }
+    return true;
+}
+
+
+void BlockScanner::LexError(LexErrorKind kind, yyltype *loc, const char *text, int len)
+{
+    if (kind == UntermCommentError && !atEnd)
+        return; // the comment goes on in the next chunk
+
+    LexErrorRecord err = { block->numTokens, kind, 0, 0, 0, NULL };
+    if (loc) {
+        err.line = loc->first_line;
+        err.firstColumn = loc->first_column;
+        err.lastColumn = loc->last_column;
+    }
+    if (text) err.text = strndup(text, len);
+    block->errors.Append(err);
+}
+
+
+static void ScanAll(const char *text, int len, yyltype loc)
+{
+    BlockScanner scanner(&identifierNames, &stringLiterals, true);
+    scanner.SetInput(text, len);
+    for (bool more = true; more; ) {
+        TokenBlock *block = emptyBlocks.Pop();
+        more = scanner.Fill(block, &loc);
+        fullBlocks.Push(block);
+    }
+}
+
+
+void StartScannerThread()
+{
+    PrintDebug("lex", "Starting scanner thread");
+
+    int len;
+    char *text = ReadInput(stdin, &len);
+    for (int i = 0; i < RingSize; i++)
+        emptyBlocks.Push(new TokenBlock);
+    std::thread(ScanAll, text, len, yylloc).detach();
+    pipelined = true;
+}
+
+
+struct Chunk {
+    const char *text;
+    int len;
+    bool last;                  // the chunk at the end of the input
+    bool startsInComment;       // as assumed when it was scanned
+    bool endsInComment;
+    int numLines;
+    List<TokenBlock*> blocks;
+    StringPool names, literals;
+    std::thread scanner;
+};
+
+static Chunk **chunks = NULL;   // only used with StartChunkedScan
+static int numChunks;
+
+
+static void ScanChunk(Chunk *chunk, yyltype loc)
+{
+    BlockScanner scanner(&chunk->names, &chunk->literals, chunk->last);
+    scanner.SetInput(chunk->text, chunk->len);
+    scanner.SetInComment(chunk->startsInComment);
+    for (bool more = true; more; ) {
+        TokenBlock *block = new TokenBlock;
+        more = scanner.Fill(block, &loc);
+        chunk->blocks.Append(block);
+    }
+    chunk->endsInComment = scanner.InComment();
+    chunk->numLines = scanner.NumLinesScanned();
+}
+
+
+void StartChunkedScan(int numThreads)
+{
+    PrintDebug("lex", "Starting chunked scan");
+
+    int len;
+    char *text = ReadInput(stdin, &len);
+    int maxChunks = len / MinChunkSize;
+    if (numThreads > maxChunks) numThreads = maxChunks;
+    if (numThreads < 1) numThreads = 1;
+
+    chunks = new Chunk*[numThreads];
+    numChunks = 0;
+    const char *p = text, *end = text + len;
+    do {
+        const char *stop = text + (long)len * (numChunks + 1) / numThreads;
+        if (stop < p) stop = p;
+        if (stop < end) {
+            const char *nl = (const char *)memchr(stop, '\n', end - stop);
+            stop = (nl ? nl + 1 : end);
+        }
+        Chunk *chunk = new Chunk;
+        chunk->text = p;
+        chunk->len = stop - p;
+        chunk->last = (stop == end);
+        chunk->startsInComment = false;
+        chunks[numChunks++] = chunk;
+        p = stop;
+    } while (p < end);
+
+    for (int i = 0; i < numChunks; i++)
+        chunks[i]->scanner = std::thread(ScanChunk, chunks[i], yylloc);
+    pipelined = true;
+}
+
+
+static List<TokenBlock*> *scannedBlocks = NULL; // only used with ScanAhead
+
+
+int ScanAhead()
+{
+    PrintDebug("lex", "Scanning the whole input");
+
+    int len;
+    char *text = ReadInput(stdin, &len);
+    BlockScanner scanner(&identifierNames, &stringLiterals, true);
+    scanner.SetInput(text, len);
+    yyltype loc = yylloc;
+    int numTokens = 0;
+    scannedBlocks = new List<TokenBlock*>;
+    for (bool more = true; more; ) {
+        TokenBlock *block = new TokenBlock;
+        more = scanner.Fill(block, &loc);
+        scannedBlocks->Append(block);
+        numTokens += block->numTokens;
+    }
+    pipelined = true;
+    return numTokens;
+}
+
+
+int GetScannedToken(int index, YYSTYPE *val, yyltype *loc)
+{
+    TokenBlock *block = scannedBlocks->Nth(index / BlockSize);
+    int i = index % BlockSize;
+    *val = block->values[i];
+    *loc = yylloc;
+    loc->first_line = block->lines[i];
+    loc->first_column = block->firstColumns[i];
+    loc->last_column = block->lastColumns[i];
+    return block->codes[i];
+}
+
+
+/* Parser side
+ * -----------
+ */
+static TokenBlock *current = NULL;
+static int nextToken, nextError;
+static int curChunk = -1;
+static int lineOffset = 0;      // lines in the chunks before curChunk
+static const PooledString **nameMap, **literalMap; // chunk pool entries to global
+
+
+/* Function: EnterChunk
+ * --------------------
+ * Waits for the chunk to be scanned and scans it again if it was
+ * scanned in the wrong state. The previous chunk is done with.
+ */
+static void EnterChunk(int n)
+{
+    Chunk *chunk = chunks[n];
+    chunk->scanner.join();
+    if (n > 0) {
+        Chunk *prev = chunks[n-1];
+        if (chunk->startsInComment != prev->endsInComment) {
+            PrintDebug("lex", "Scanning chunk %d again", n);
+            while (chunk->blocks.NumElements() > 0) {
+                delete chunk->blocks.Nth(0);
+                chunk->blocks.RemoveAt(0);
+            }
+            chunk->names.Clear();
+            chunk->literals.Clear();
+            chunk->startsInComment = prev->endsInComment;
+            ScanChunk(chunk, yylloc);
+        }
+        lineOffset += prev->numLines;
+        delete prev;
+        free(nameMap);
+        free(literalMap);
+    }
+    nameMap = (const PooledString **)calloc(chunk->names.NumEntries() + 1, sizeof(PooledString*));
+    literalMap = (const PooledString **)calloc(chunk->literals.NumEntries() + 1, sizeof(PooledString*));
+    curChunk = n;
+}
+
+
+static TokenBlock *TakeBlock()
+{
+    if (scannedBlocks) {
+        TokenBlock *block = scannedBlocks->Nth(0);
+        scannedBlocks->RemoveAt(0);
+        return block;
+    }
+    if (!chunks) return fullBlocks.Pop();
+
+    while (curChunk < 0 || chunks[curChunk]->blocks.NumElements() == 0) {
+        Assert(curChunk + 1 < numChunks);
+        EnterChunk(curChunk + 1);
+    }
+    TokenBlock *block = chunks[curChunk]->blocks.Nth(0);
+    chunks[curChunk]->blocks.RemoveAt(0);
+    return block;
+}
+
+
+static void GiveBackBlock(TokenBlock *block)
+{
+    if (!chunks && !scannedBlocks) emptyBlocks.Push(block);
+    else delete block;
+}
+
+
+static const PooledString *Reintern(const PooledString **map, StringPool *pool,
+                                    const PooledString *s)
+{
+    if (!map[s->index])
+        map[s->index] = pool->Intern(s->chars, s->length);
+    return map[s->index];
+}
+
+
+static void ReplayError(const LexErrorRecord &err)
+{
+    yyltype loc = yylloc;
+    loc.first_line = err.line + lineOffset;
+    loc.first_column = err.firstColumn;
+    loc.last_column = err.lastColumn;
+    ReportLexError(err.kind, err.kind == UntermCommentError ? NULL : &loc, err.text);
+    free(err.text);
+}
+
+
+static int NextToken()
+{
+    for (;;) {
+        if (current == NULL) {
+            current = TakeBlock();
+            nextToken = nextError = 0;
+            for (int i = 0; i < current->savedLines.NumElements(); i++)
+                savedLines.Append(current->savedLines.Nth(i));
+        }
+
+        while (nextError < current->errors.NumElements() &&
+               current->errors.Nth(nextError).tokenIndex == nextToken)
+            ReplayError(current->errors.Nth(nextError++));
+
+        if (nextToken < current->numTokens) {
+            int i = nextToken++;
+            int code = current->codes[i];
+            if (code == 0 && chunks && !chunks[curChunk]->last)
+                continue; // end of a chunk, not of the input
+            yylval = current->values[i];
+            yylloc.first_line = current->lines[i] + lineOffset;
+            yylloc.first_column = current->firstColumns[i];
+            yylloc.last_column = current->lastColumns[i];
+            if (chunks && code == T_Identifier)
+                yylval.identifier = Reintern(nameMap, &identifierNames, yylval.identifier);
+            if (chunks && code == T_StringConstant)
+                yylval.stringConstant = Reintern(literalMap, &stringLiterals, yylval.stringConstant);
+            if (code == 0)
+                nextToken = i; // stay at the end of the input
+            return code;
+        }
+
+        GiveBackBlock(current);
+        current = NULL;
+    }
+}
+
+
+int yylex()
+{
+    return (pipelined ? NextToken() : ScanToken());
+}
+
+
+int DumpTokens(FILE *fp)
+{
+    int count = 0, token;
+    while ((token = yylex()) != 0) {
+        count++;
+        if (!fp) continue;
+        fprintf(fp, "%d:%d-%d %s", yylloc.first_line, yylloc.first_column,
+                yylloc.last_column, TokenName(token));
+        switch (token) {
+          case T_Identifier:     fprintf(fp, " %s", yylval.identifier->chars);         break;
+          case T_StringConstant: fprintf(fp, " %s", yylval.stringConstant->chars);     break;
+          case T_IntConstant:    fprintf(fp, " %d", yylval.integerConstant);           break;
+          case T_DoubleConstant: fprintf(fp, " %.17g", yylval.doubleConstant);         break;
+          case T_BoolConstant:   fprintf(fp, " %s", yylval.boolConstant ? "true" : "false"); break;
+        }
+        fputc('\n', fp);
+    }
+    return count;
+}
+
+
+/* The yylex() that yyparse() calls */
+int yylex(YYSTYPE *val, yyltype *loc, DeclRange *range)
+{
+    if (range)
+        return range->NextToken(val, loc);
+    int token = yylex();
+    *val = yylval;
+    *loc = yylloc;
+    return token;
+}
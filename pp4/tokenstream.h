@@ -0,0 +1,85 @@
+/* File: tokenstream.h
+ * -------------------
+ * The scanner/parser pipeline. Normally yyparse() calls the scanner for
+ * one token at a time, so scanning and parsing take turns on one core.
+ * With -pipeline on the command line, a DirectScanner instead runs on a
+ * thread of its own and scans ahead. It fills fixed-size blocks of
+ * tokens, kept as parallel arrays of token codes, values and locations,
+ * and passes the full blocks to the parser through a lock-free ring.
+ * yylex() then just hands out the tokens of the block at the front.
+ *
+ * Nothing the scanner thread does is visible to the rest of the
+ * compiler until the parser reaches the block it belongs to: the lines
+ * copied for error context and the lexical errors found while filling
+ * a block travel with it, and are added to the saved lines and reported
+ * when the parser gets to them. So messages come out in the same order
+ * and with the same context as without the pipeline.
+ *
+ * With -lexjobs=N, the input is instead cut at line ends into up to N
+ * chunks that are scanned at the same time, each on its own thread and
+ * each as if it began a file. That assumption only fails if a chunk
+ * starts inside a comment (a string cannot span lines), which is known
+ * once the chunk before it has been scanned; the parser then scans the
+ * chunk again before taking its tokens. Line numbers are relative to
+ * the chunk and made absolute by adding the line counts of the chunks
+ * before. Names and strings are interned in pools of the chunk, and
+ * interned again into the global pools as the parser takes them, so the
+ * parser sees the same tokens as from the serial scanner.
+ *
+ * ScanAhead() scans all of the input before the parser starts, for
+ * parsers that need to look at any of the tokens (see declparse.h).
+ */
+
+#ifndef _H_tokenstream
+#define _H_tokenstream
+
+#include "parser.h"
+
+
+/* Function: StartScannerThread()
+ * ------------------------------
+ * Reads the whole input from stdin and starts scanning it on another
+ * thread. Used instead of InitScanner(), after that yylex() returns the
+ * tokens scanned there.
+ */
+void StartScannerThread();
+
+
+/* Function: StartChunkedScan()
+ * ----------------------------
+ * Reads the whole input from stdin and starts scanning it in up to
+ * numThreads chunks at once. Used instead of InitScanner().
+ */
+void StartChunkedScan(int numThreads);
+
+
+/* Function: ScanAhead()
+ * ---------------------
+ * Reads and scans the whole input from stdin. Used instead of
+ * InitScanner(), after that yylex() returns the tokens scanned, with
+ * the lexical errors reported as they are reached. Returns the number
+ * of tokens, counting the 0 at the end.
+ */
+int ScanAhead();
+
+
+/* Function: GetScannedToken()
+ * ---------------------------
+ * Returns the code of the token at index, and fills in its value and
+ * location, after ScanAhead() but before the first call to yylex().
+ * Safe to call from any thread.
+ */
+int GetScannedToken(int index, YYSTYPE *val, yyltype *loc);
+
+
+/* Function: DumpTokens()
+ * ----------------------
+ * Takes all the tokens from yylex() and writes one line for each to fp,
+ * with its location, its name in the grammar and, for names and
+ * constants, its value. Lets dcc -tokens compare the scanners token by
+ * token. If fp is NULL they are only counted. Returns the number of
+ * tokens, not counting the 0 at the end.
+ */
+int DumpTokens(FILE *fp);
+
+#endif
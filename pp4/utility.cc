@@ -7,9 +7,15 @@
 #include "utility.h"
 #include <stdarg.h>
 #include "list.h"
+#include "hashtable.h"
+#include "errors.h" // for ReportError::Flush()
 #include <string.h>
+#include <unistd.h>
+#include <time.h>
 
 static List<const char*> debugKeys;
+static Hashtable<const char*> options;
+static List<const char*> arguments;
 static const int BufferSize = 2048;
 
 
@@ -21,6 +27,11 @@ void Failure(const char *format, ...)
   va_start(args, format);
   vsprintf(errbuf, format, args);
   va_end(args);
+  static bool failing = false;    // a failure while flushing writes only its own message
+  if (!failing) {
+    failing = true;
+    ReportError::Flush();         // the errors reported so far, which are held until then
+  }
   fflush(stdout);
   fprintf(stderr,"\n*** Failure: %s\n\n", errbuf);
   abort();
@@ -66,17 +77,92 @@ void PrintDebug(const char *key, const char *format, ...)
 }
 
 
-void ParseCommandLine(int argc, char *argv[])
+const char *GetOption(const char *name)
 {
-  if (argc == 1)
-    return;
+  return options.Lookup(name);
+}
+
 
-  if (strcmp(argv[1], "-d") != 0) { // first arg is not -d
-    printf("Usage:   -d <debug-key-1> <debug-key-2> ... \n");
-    exit(2);
+const char *GetArgument(int n)
+{
+  return n < arguments.NumElements() ? arguments.Nth(n) : NULL;
+}
+
+
+static void Usage()
+{
+  printf("Usage:   [-option[=value] ...] [-d <debug-key-1> <debug-key-2> ...]\n");
+  printf("         -batch[=jobs] [-option[=value] ...] file ... [-d <debug-key-1> ...]\n");
+  exit(2);
+}
+
+
+void ParseCommandLine(int argc, char *argv[])
+{
+  int i = 1;
+  for (; i < argc && strcmp(argv[i], "-d") != 0; i++) {
+    if (argv[i][0] != '-') {
+      arguments.Append(argv[i]);
+      continue;
+    }
+    char *name = strdup(argv[i] + (argv[i][1] == '-' ? 2 : 1));
+    char *value = strchr(name, '=');
+    if (value) *value++ = '\0';
+    options.Enter(name, value ? value : "");
   }
+  if (arguments.NumElements() > 0 && !GetOption("batch")) // only -batch takes files
+    Usage();
+  if (i == argc)
+    return;
 
-  for (int i = 2; i < argc; i++)
+  for (i++; i < argc; i++)
     SetDebugForKey(argv[i], true);
 }
 
+
+
+uint64_t Fnv1a(const void *data, size_t len, uint64_t hash)
+{
+  const unsigned char *p = (const unsigned char *)data;
+  for (size_t i = 0; i < len; i++)
+    hash = (hash ^ p[i]) * FnvPrime;
+  return hash;
+}
+
+
+bool ReplaceFile(const char *path, int numParts, const void *parts[], const size_t sizes[])
+{
+  char *temp = (char *)malloc(strlen(path) + 32);
+  sprintf(temp, "%s.%d", path, (int)getpid());
+  FILE *fp = fopen(temp, "wb");
+  bool written = (fp != NULL);
+  for (int i = 0; written && i < numParts; i++)
+    written = (fwrite(parts[i], 1, sizes[i], fp) == sizes[i]);
+  if (fp && fclose(fp) != 0) written = false;
+  if (written) written = (rename(temp, path) == 0);
+  if (!written) unlink(temp);
+  free(temp);
+  return written;
+}
+
+
+double Now()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+
+pid_t ForkCompiler()
+{
+  fflush(stdout);
+  fflush(stderr);
+  return fork();
+}
+
+
+void CompileAndExit(int (*compile)())
+{
+  exit(compile());
+}
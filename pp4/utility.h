@@ -9,6 +9,8 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdint.h>
+#include <sys/types.h>
 
 
 /* Function: Failure()
@@ -19,6 +21,7 @@
  * even after an error is encountered.  Some of the provided code calls
  * this in unrecoverable error situations (cannot allocate memory, etc.)
  * Failure accepts printf-style arguments in the message to be printed.
+ * The errors reported before it are written out first.
  */
 
 void Failure(const char *format, ...);
@@ -73,12 +76,93 @@ bool IsDebugOn(const char *key);
 
 
 
+/* Function: GetOption()
+ * Usage: if (GetOption("pipeline")) ...
+ * -------------------------------------
+ * Returns the value of an option given on the command line as -name or
+ * -name=value, which is "" for the first form.  Returns NULL if the
+ * option was not given.
+ */
+const char *GetOption(const char *name);
+
+
+
+/* Function: GetArgument()
+ * Usage: for (int i = 0; GetArgument(i); i++) ...
+ * -----------------------------------------------
+ * Returns the nth argument on the command line before -d that is not an
+ * option, or NULL if there are fewer.  Only -batch takes any (see
+ * batch.h).
+ */
+const char *GetArgument(int n);
+
+
+
 /* Function: ParseCommandLine
  * --------------------------
- * Turn on the debugging flags from the command line.  Verifies that
- * first argument is -d, and then interpret all the arguments that follow
- * as being flags to turn on.
+ * Record the options and turn on the debugging flags from the command
+ * line.  Options come first (--name is taken as -name), then an
+ * optional -d, and all the arguments that follow it are interpreted as
+ * being flags to turn on.  With -batch, the names of the files to
+ * compile can be given among the options.
  */
 void ParseCommandLine(int argc, char *argv[]);
 
+
+/* Function: Fnv1a()
+ * Usage: uint64_t hash = Fnv1a(text, len);
+ * ----------------------------------------
+ * The 64-bit FNV-1a hash of len bytes of data, continuing from hash to
+ * hash several blocks as one. Used to recognize the input and to check
+ * the files written for -cache and -incremental.
+ */
+static const uint64_t FnvBasis = 14695981039346656037ULL;
+static const uint64_t FnvPrime = 1099511628211ULL;
+
+uint64_t Fnv1a(const void *data, size_t len, uint64_t hash = FnvBasis);
+
+
+
+/* Function: ReplaceFile()
+ * Usage: if (!ReplaceFile(path, 2, parts, sizes)) ...
+ * ---------------------------------------------------
+ * Writes the numParts blocks parts[i] of sizes[i] bytes to path, one
+ * after the other. The file is written under a temporary name and
+ * renamed, so a reader never sees half of it, even with other
+ * compilers writing the same one. Returns false, leaving no file
+ * behind, if that failed.
+ */
+bool ReplaceFile(const char *path, int numParts, const void *parts[], const size_t sizes[]);
+
+
+
+/* Function: Now()
+ * Usage: double start = Now();
+ * ----------------------------
+ * Seconds on a clock that only goes forward, for timing what the
+ * compiler does (reported with PrintDebug).
+ */
+double Now();
+
+
+
+/* Function: ForkCompiler()
+ * Usage: pid_t pid = ForkCompiler(); if (pid == 0) ...
+ * ----------------------------------------------------
+ * Forks a process to compile, as -batch and -daemon do, after writing
+ * out what stdout and stderr hold, else the child would write it out
+ * again. Returns what fork() does.
+ */
+pid_t ForkCompiler();
+
+
+
+/* Function: CompileAndExit()
+ * Usage: CompileAndExit(compile);
+ * -------------------------------
+ * Ends a process forked by ForkCompiler() with the exit status compile
+ * returns. It exits rather than _exits, so stdout is flushed.
+ */
+void CompileAndExit(int (*compile)());
+
 #endif
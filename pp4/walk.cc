@@ -0,0 +1,119 @@
+/* File: walk.cc
+ * -------------
+ * Implementation of the walks over the tree.
+ */
+
+#include "walk.h"
+#include <stdlib.h>
+#include <string.h>
+#include "ast.h"
+#include "ast_expr.h"
+#include "utility.h" // for Failure()
+
+
+TreeWalk::~TreeWalk()
+{
+    if (frames != inlineFrames)
+        free(frames);
+}
+
+
+void TreeWalk::Name(Node *node, Scope *parent)
+{
+    if (num == max) {
+        Frame *more = (Frame *)malloc(2*max*sizeof(Frame));
+        if (!more) Failure("Out of memory!");
+        memcpy(more, frames, num*sizeof(Frame));
+        if (frames != inlineFrames)
+            free(frames);
+        frames = more;
+        max *= 2;
+    }
+    Frame f = { node, parent, 0 };
+    frames[num++] = f;
+}
+
+
+/* Turns the frames named over, so the first named is on top, to be
+ * visited first. */
+void TreeWalk::PushNamed()
+{
+    for (int i = named, j = num - 1; i < j; i++, j--) {
+        Frame f = frames[i];
+        frames[i] = frames[j];
+        frames[j] = f;
+    }
+}
+
+
+void TreeWalk::BuildScope(Node *child, Scope *parent)
+{
+    Name(child, parent);
+}
+
+
+void TreeWalk::Check(Node *child)
+{
+    Name(child, NULL);
+}
+
+
+void TreeWalk::NeedType(Expr *operand)
+{
+    if (operand != NULL && operand->knownType == NULL)
+        Name(operand, NULL);
+}
+
+
+void BuildScopes(Node *root, Scope *parent)
+{
+    TreeWalk w;
+    w.Name(root, parent);
+    while (w.num > 0) {
+        TreeWalk::Frame f = w.frames[--w.num];
+        w.named = w.num;
+        f.node->ScopeBuilder(f.parent, &w);
+        w.PushNamed();
+    }
+}
+
+
+/* A node stays on the stack below the children it names until it has
+ * no more steps. */
+void CheckTree(Node *root)
+{
+    TreeWalk w;
+    w.Name(root, NULL);
+    while (w.num > 0) {
+        int top = w.num - 1;
+        Node *node = w.frames[top].node;
+        w.named = w.num;
+        if (!node->CheckStep(w.frames[top].step++, &w)) {
+            memmove(&w.frames[top], &w.frames[top + 1], (w.num - w.named)*sizeof(TreeWalk::Frame));
+            w.num--;
+            w.named--;
+        }
+        w.PushNamed();
+    }
+}
+
+
+/* Step 0 names the operands, step 1 works out the type from theirs. */
+void WorkOutTypes(Expr *root)
+{
+    TreeWalk w;
+    w.NeedType(root);
+    while (w.num > 0) {
+        TreeWalk::Frame *f = &w.frames[w.num - 1];
+        Expr *e = static_cast<Expr*>(f->node);
+        if (f->step++ == 0 && e->knownType == NULL) {
+            w.named = w.num;
+            e->TypeOperands(&w);
+            w.PushNamed();
+            continue;
+        }
+        if (e->knownType == NULL)
+            e->knownType = e->WorkOutType();
+        w.num--;
+    }
+}
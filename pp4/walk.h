@@ -0,0 +1,89 @@
+/* File: walk.h
+ * ------------
+ * Walking the tree without recursing. Building scopes, checking and
+ * working out the types of expressions go down as deep as the tree
+ * does, and inputs with expressions or blocks nested tens of thousands
+ * deep would run out of stack if each level were a call. Instead the
+ * nodes to visit are kept on a stack of TreeWalk's own, on the heap,
+ * and each node only does its own part of the work:
+ *
+ *   ScopeBuilder(parent, w)  sets up the node's scope and names the
+ *                            children to build next, with w->BuildScope
+ *   CheckStep(step, w)       does one step of checking the node, with
+ *                            step 0 the first time and one more each
+ *                            time after. A step may name children to
+ *                            check, with w->Check, which are checked
+ *                            before the next step. It returns false
+ *                            once the node has no more steps.
+ *   TypeOperands(w)          names the operands whose types an
+ *                            expression's type is worked out from,
+ *                            with w->NeedType (see Expr::ObtainType)
+ *
+ * Children are visited in the order they are named, so everything
+ * happens in the same order as it would if each node called on its
+ * children itself.
+ */
+
+#ifndef _H_walk
+#define _H_walk
+
+class Node;
+class Expr;
+class Scope;
+
+
+class TreeWalk
+{
+  protected:
+    struct Frame {
+        Node *node;
+        Scope *parent;          // for building scopes
+        int step;
+    };
+    static const int NumInline = 32;
+    Frame inlineFrames[NumInline];
+    Frame *frames;              // the stack, inlineFrames until it outgrows them
+    int num, max;
+    int named;                  // frames from here up were named by the node visited
+
+    void Name(Node *node, Scope *parent);
+    void PushNamed();
+
+  public:
+    TreeWalk() : frames(inlineFrames), num(0), max(NumInline), named(0) {}
+    ~TreeWalk();
+
+          // Called by the node being visited to name a child to visit
+    void BuildScope(Node *child, Scope *parent);
+    void Check(Node *child);
+    void NeedType(Expr *operand);   // if its type is not known yet
+
+    friend void BuildScopes(Node *root, Scope *parent);
+    friend void CheckTree(Node *root);
+    friend void WorkOutTypes(Expr *root);
+};
+
+
+/* Function: BuildScopes()
+ * -----------------------
+ * Builds the scopes of root and all below it, with that of root inside
+ * parent.
+ */
+void BuildScopes(Node *root, Scope *parent);
+
+
+/* Function: CheckTree()
+ * ---------------------
+ * Checks root and all below it.
+ */
+void CheckTree(Node *root);
+
+
+/* Function: WorkOutTypes()
+ * ------------------------
+ * Works out the type of root, and first those of the operands it needs
+ * that are not known yet.
+ */
+void WorkOutTypes(Expr *root);
+
+#endif
@@ -0,0 +1,103 @@
+/* File: workpool.cc
+ * -----------------
+ * Implementation of the work-stealing task pool.
+ */
+
+#include "workpool.h"
+#include <mutex>
+#include <thread>
+#include "utility.h" // for PrintDebug()
+
+
+/* The tasks a thread has left, from next up to but not including end. */
+struct Run {
+    std::mutex lock;
+    int next, end;
+};
+
+struct Pool {
+    Run *runs;
+    int numThreads;
+    void (*task)(int, void *);
+    void *data;
+};
+
+
+static bool TakeOwn(Run *run, int *index)
+{
+    std::lock_guard<std::mutex> hold(run->lock);
+    if (run->next == run->end)
+        return false;
+    *index = run->next++;
+    return true;
+}
+
+
+/* Function: Steal
+ * ---------------
+ * Moves the back half of the largest run left to the thread's own (which
+ * is empty) and takes the first task of it. A run may shrink between
+ * picking it and locking it, so it is looked at again under the lock.
+ * Fails when no thread has a task left to take.
+ */
+static bool Steal(Pool *pool, int self, int *index)
+{
+    for (;;) {
+        Run *victim = NULL;
+        int most = 0;
+        for (int i = 0; i < pool->numThreads; i++) {
+            Run *run = &pool->runs[i];
+            std::lock_guard<std::mutex> hold(run->lock);
+            if (i != self && run->end - run->next > most) {
+                victim = run;
+                most = run->end - run->next;
+            }
+        }
+        if (!victim)
+            return false;
+
+        int start, end;
+        {
+            std::lock_guard<std::mutex> hold(victim->lock);
+            int left = victim->end - victim->next;
+            if (left == 0)
+                continue;
+            end = victim->end;
+            start = victim->end -= (left + 1) / 2;
+        }
+        Run *own = &pool->runs[self];
+        std::lock_guard<std::mutex> hold(own->lock);
+        own->next = start + 1;
+        own->end = end;
+        *index = start;
+        return true;
+    }
+}
+
+
+static void Work(Pool *pool, int self)
+{
+    int index;
+    while (TakeOwn(&pool->runs[self], &index) || Steal(pool, self, &index))
+        pool->task(index, pool->data);
+}
+
+
+void RunTasks(int numTasks, int numThreads, void (*task)(int, void *), void *data)
+{
+    if (numThreads < 1) numThreads = 1;
+    PrintDebug("pool", "Running %d tasks on %d threads", numTasks, numThreads);
+
+    Pool pool = { new Run[numThreads], numThreads, task, data };
+    for (int i = 0; i < numThreads; i++) {
+        pool.runs[i].next = (long)numTasks * i / numThreads;
+        pool.runs[i].end = (long)numTasks * (i + 1) / numThreads;
+    }
+    std::thread *threads = new std::thread[numThreads];
+    for (int i = 0; i < numThreads; i++)
+        threads[i] = std::thread(Work, &pool, i);
+    for (int i = 0; i < numThreads; i++)
+        threads[i].join();
+    delete[] threads;
+    delete[] pool.runs;
+}
@@ -0,0 +1,26 @@
+/* File: workpool.h
+ * ----------------
+ * Running a set of numbered tasks on several threads. The tasks are
+ * dealt out to the threads in equal runs of consecutive numbers. A
+ * thread takes its own tasks from the front of its run, and once it has
+ * none left it steals the back half of the largest run another thread
+ * still has, so threads that drew cheap tasks help out those that drew
+ * expensive ones without all of them contending for one shared counter.
+ *
+ * Which thread runs a task, and when, is not fixed; tasks that report
+ * anything should keep it and have it put in order afterwards (see
+ * DiagnosticBuffer in diagnostics.h).
+ */
+
+#ifndef _H_workpool
+#define _H_workpool
+
+
+/* Function: RunTasks()
+ * --------------------
+ * Calls task(i, data) for each i from 0 to numTasks-1 on numThreads
+ * threads and returns when all of them are done.
+ */
+void RunTasks(int numTasks, int numThreads, void (*task)(int index, void *data), void *data);
+
+#endif
@@ -0,0 +1,2654 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* C LALR(1) parser skeleton written by Richard Stallman, by
+   simplifying the original so-called "semantic" parser.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+/* All symbols defined below should begin with yy or YY, to avoid
+   infringing on user name space.  This should be done even for local
+   variables, as they might otherwise be expanded by user macros.
+   There are some unavoidable exceptions within include files to
+   define necessary library symbols; they are noted "INFRINGES ON
+   USER NAME SPACE" below.  */
+
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
+
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
+
+/* Skeleton name.  */
+#define YYSKELETON_NAME "yacc.c"
+
+/* Pure parsers.  */
+#define YYPURE 2
+
+/* Push parsers.  */
+#define YYPUSH 1
+
+/* Pull parsers.  */
+#define YYPULL 1
+
+
+
+
+/* First part of user prologue.  */
+#line 7 "parser.y"
+
+
+#include "scanner.h" // for yylex
+#include "parser.h"
+#include "errors.h"
+
+void yyerror(yyltype *loc, DeclRange *range, const char *msg); // standard error-handling routine
+
+// Input nested deeper than the stacks start out for makes them grow, up
+// to this many entries (see YYLTYPE_IS_TRIVIAL in location.h)
+#define YYMAXDEPTH 1000000
+
+
+#line 85 "y.tab.c"
+
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
+
+/* Use api.header.include to #include this header
+   instead of duplicating it here.  */
+#ifndef YY_YY_Y_TAB_H_INCLUDED
+# define YY_YY_Y_TAB_H_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 1
+#endif
+#if YYDEBUG
+extern int yydebug;
+#endif
+
+/* Token kinds.  */
+#ifndef YYTOKENTYPE
+# define YYTOKENTYPE
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    T_Void = 258,                  /* T_Void  */
+    T_Bool = 259,                  /* T_Bool  */
+    T_Int = 260,                   /* T_Int  */
+    T_Double = 261,                /* T_Double  */
+    T_String = 262,                /* T_String  */
+    T_Class = 263,                 /* T_Class  */
+    T_LessEqual = 264,             /* T_LessEqual  */
+    T_GreaterEqual = 265,          /* T_GreaterEqual  */
+    T_Equal = 266,                 /* T_Equal  */
+    T_NotEqual = 267,              /* T_NotEqual  */
+    T_Dims = 268,                  /* T_Dims  */
+    T_And = 269,                   /* T_And  */
+    T_Or = 270,                    /* T_Or  */
+    T_Null = 271,                  /* T_Null  */
+    T_Extends = 272,               /* T_Extends  */
+    T_This = 273,                  /* T_This  */
+    T_Interface = 274,             /* T_Interface  */
+    T_Implements = 275,            /* T_Implements  */
+    T_While = 276,                 /* T_While  */
+    T_For = 277,                   /* T_For  */
+    T_If = 278,                    /* T_If  */
+    T_Else = 279,                  /* T_Else  */
+    T_Return = 280,                /* T_Return  */
+    T_Break = 281,                 /* T_Break  */
+    T_New = 282,                   /* T_New  */
+    T_NewArray = 283,              /* T_NewArray  */
+    T_Print = 284,                 /* T_Print  */
+    T_ReadInteger = 285,           /* T_ReadInteger  */
+    T_ReadLine = 286,              /* T_ReadLine  */
+    T_Incr = 287,                  /* T_Incr  */
+    T_Decr = 288,                  /* T_Decr  */
+    T_Switch = 289,                /* T_Switch  */
+    T_Case = 290,                  /* T_Case  */
+    T_Default = 291,               /* T_Default  */
+    T_Colon = 292,                 /* T_Colon  */
+    T_ParseDecl = 293,             /* T_ParseDecl  */
+    T_Identifier = 294,            /* T_Identifier  */
+    T_StringConstant = 295,        /* T_StringConstant  */
+    T_IntConstant = 296,           /* T_IntConstant  */
+    T_DoubleConstant = 297,        /* T_DoubleConstant  */
+    T_BoolConstant = 298,          /* T_BoolConstant  */
+    T_UnaryMinus = 299,            /* T_UnaryMinus  */
+    T_Lower_Than_Else = 300        /* T_Lower_Than_Else  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
+#endif
+/* Token kinds.  */
+#define YYEMPTY -2
+#define YYEOF 0
+#define YYerror 256
+#define YYUNDEF 257
+#define T_Void 258
+#define T_Bool 259
+#define T_Int 260
+#define T_Double 261
+#define T_String 262
+#define T_Class 263
+#define T_LessEqual 264
+#define T_GreaterEqual 265
+#define T_Equal 266
+#define T_NotEqual 267
+#define T_Dims 268
+#define T_And 269
+#define T_Or 270
+#define T_Null 271
+#define T_Extends 272
+#define T_This 273
+#define T_Interface 274
+#define T_Implements 275
+#define T_While 276
+#define T_For 277
+#define T_If 278
+#define T_Else 279
+#define T_Return 280
+#define T_Break 281
+#define T_New 282
+#define T_NewArray 283
+#define T_Print 284
+#define T_ReadInteger 285
+#define T_ReadLine 286
+#define T_Incr 287
+#define T_Decr 288
+#define T_Switch 289
+#define T_Case 290
+#define T_Default 291
+#define T_Colon 292
+#define T_ParseDecl 293
+#define T_Identifier 294
+#define T_StringConstant 295
+#define T_IntConstant 296
+#define T_DoubleConstant 297
+#define T_BoolConstant 298
+#define T_UnaryMinus 299
+#define T_Lower_Than_Else 300
+
+/* Value type.  */
+#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
+union YYSTYPE
+{
+#line 46 "parser.y"
+
+    int integerConstant;
+    bool boolConstant;
+    const PooledString *stringConstant;
+    double doubleConstant;
+    const PooledString *identifier;
+    Decl *decl;
+    List<Decl*> *declList;
+    Type *type;
+    NamedType *cType;
+    List<NamedType*> *cTypeList;
+    FnDecl *fDecl;
+    VarDecl *var;
+    List<VarDecl*> *varList;
+    Expr *expr;
+    List<Expr*> *exprList;
+    Stmt *stmt;
+    List<Stmt*> *stmtList;
+    LValue *lvalue;
+    
+    SwitchStmt *switchStmt;
+    SwitchStmt::CaseStmt *caseStmt;
+    List<SwitchStmt::CaseStmt*> *caseStmtList;
+
+#line 253 "y.tab.c"
+
+};
+typedef union YYSTYPE YYSTYPE;
+# define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
+#endif
+
+/* Location type.  */
+#if ! defined YYLTYPE && ! defined YYLTYPE_IS_DECLARED
+typedef struct YYLTYPE YYLTYPE;
+struct YYLTYPE
+{
+  int first_line;
+  int first_column;
+  int last_line;
+  int last_column;
+};
+# define YYLTYPE_IS_DECLARED 1
+# define YYLTYPE_IS_TRIVIAL 1
+#endif
+
+
+
+
+#ifndef YYPUSH_MORE_DEFINED
+# define YYPUSH_MORE_DEFINED
+enum { YYPUSH_MORE = 4 };
+#endif
+
+typedef struct yypstate yypstate;
+
+
+int yyparse (DeclRange *range);
+int yypush_parse (yypstate *ps,
+                  int pushed_char, YYSTYPE const *pushed_val, YYLTYPE *pushed_loc, DeclRange *range);
+int yypull_parse (yypstate *ps, DeclRange *range);
+yypstate *yypstate_new (void);
+void yypstate_delete (yypstate *ps);
+
+
+#endif /* !YY_YY_Y_TAB_H_INCLUDED  */
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_T_Void = 3,                     /* T_Void  */
+  YYSYMBOL_T_Bool = 4,                     /* T_Bool  */
+  YYSYMBOL_T_Int = 5,                      /* T_Int  */
+  YYSYMBOL_T_Double = 6,                   /* T_Double  */
+  YYSYMBOL_T_String = 7,                   /* T_String  */
+  YYSYMBOL_T_Class = 8,                    /* T_Class  */
+  YYSYMBOL_T_LessEqual = 9,                /* T_LessEqual  */
+  YYSYMBOL_T_GreaterEqual = 10,            /* T_GreaterEqual  */
+  YYSYMBOL_T_Equal = 11,                   /* T_Equal  */
+  YYSYMBOL_T_NotEqual = 12,                /* T_NotEqual  */
+  YYSYMBOL_T_Dims = 13,                    /* T_Dims  */
+  YYSYMBOL_T_And = 14,                     /* T_And  */
+  YYSYMBOL_T_Or = 15,                      /* T_Or  */
+  YYSYMBOL_T_Null = 16,                    /* T_Null  */
+  YYSYMBOL_T_Extends = 17,                 /* T_Extends  */
+  YYSYMBOL_T_This = 18,                    /* T_This  */
+  YYSYMBOL_T_Interface = 19,               /* T_Interface  */
+  YYSYMBOL_T_Implements = 20,              /* T_Implements  */
+  YYSYMBOL_T_While = 21,                   /* T_While  */
+  YYSYMBOL_T_For = 22,                     /* T_For  */
+  YYSYMBOL_T_If = 23,                      /* T_If  */
+  YYSYMBOL_T_Else = 24,                    /* T_Else  */
+  YYSYMBOL_T_Return = 25,                  /* T_Return  */
+  YYSYMBOL_T_Break = 26,                   /* T_Break  */
+  YYSYMBOL_T_New = 27,                     /* T_New  */
+  YYSYMBOL_T_NewArray = 28,                /* T_NewArray  */
+  YYSYMBOL_T_Print = 29,                   /* T_Print  */
+  YYSYMBOL_T_ReadInteger = 30,             /* T_ReadInteger  */
+  YYSYMBOL_T_ReadLine = 31,                /* T_ReadLine  */
+  YYSYMBOL_T_Incr = 32,                    /* T_Incr  */
+  YYSYMBOL_T_Decr = 33,                    /* T_Decr  */
+  YYSYMBOL_T_Switch = 34,                  /* T_Switch  */
+  YYSYMBOL_T_Case = 35,                    /* T_Case  */
+  YYSYMBOL_T_Default = 36,                 /* T_Default  */
+  YYSYMBOL_T_Colon = 37,                   /* T_Colon  */
+  YYSYMBOL_T_ParseDecl = 38,               /* T_ParseDecl  */
+  YYSYMBOL_T_Identifier = 39,              /* T_Identifier  */
+  YYSYMBOL_T_StringConstant = 40,          /* T_StringConstant  */
+  YYSYMBOL_T_IntConstant = 41,             /* T_IntConstant  */
+  YYSYMBOL_T_DoubleConstant = 42,          /* T_DoubleConstant  */
+  YYSYMBOL_T_BoolConstant = 43,            /* T_BoolConstant  */
+  YYSYMBOL_44_ = 44,                       /* '='  */
+  YYSYMBOL_45_ = 45,                       /* '<'  */
+  YYSYMBOL_46_ = 46,                       /* '>'  */
+  YYSYMBOL_47_ = 47,                       /* '+'  */
+  YYSYMBOL_48_ = 48,                       /* '-'  */
+  YYSYMBOL_49_ = 49,                       /* '*'  */
+  YYSYMBOL_50_ = 50,                       /* '/'  */
+  YYSYMBOL_51_ = 51,                       /* '%'  */
+  YYSYMBOL_T_UnaryMinus = 52,              /* T_UnaryMinus  */
+  YYSYMBOL_53_ = 53,                       /* '!'  */
+  YYSYMBOL_54_ = 54,                       /* '.'  */
+  YYSYMBOL_55_ = 55,                       /* '['  */
+  YYSYMBOL_T_Lower_Than_Else = 56,         /* T_Lower_Than_Else  */
+  YYSYMBOL_57_ = 57,                       /* ';'  */
+  YYSYMBOL_58_ = 58,                       /* '{'  */
+  YYSYMBOL_59_ = 59,                       /* '}'  */
+  YYSYMBOL_60_ = 60,                       /* ','  */
+  YYSYMBOL_61_ = 61,                       /* '('  */
+  YYSYMBOL_62_ = 62,                       /* ')'  */
+  YYSYMBOL_63_ = 63,                       /* ']'  */
+  YYSYMBOL_YYACCEPT = 64,                  /* $accept  */
+  YYSYMBOL_Input = 65,                     /* Input  */
+  YYSYMBOL_Program = 66,                   /* Program  */
+  YYSYMBOL_DeclList = 67,                  /* DeclList  */
+  YYSYMBOL_Decl = 68,                      /* Decl  */
+  YYSYMBOL_VarDecl = 69,                   /* VarDecl  */
+  YYSYMBOL_Variable = 70,                  /* Variable  */
+  YYSYMBOL_Type = 71,                      /* Type  */
+  YYSYMBOL_IntfDecl = 72,                  /* IntfDecl  */
+  YYSYMBOL_IntfList = 73,                  /* IntfList  */
+  YYSYMBOL_ClassDecl = 74,                 /* ClassDecl  */
+  YYSYMBOL_OptExt = 75,                    /* OptExt  */
+  YYSYMBOL_OptImpl = 76,                   /* OptImpl  */
+  YYSYMBOL_ImpList = 77,                   /* ImpList  */
+  YYSYMBOL_FieldList = 78,                 /* FieldList  */
+  YYSYMBOL_Field = 79,                     /* Field  */
+  YYSYMBOL_FnHeader = 80,                  /* FnHeader  */
+  YYSYMBOL_Formals = 81,                   /* Formals  */
+  YYSYMBOL_FormalList = 82,                /* FormalList  */
+  YYSYMBOL_FnDecl = 83,                    /* FnDecl  */
+  YYSYMBOL_StmtBlock = 84,                 /* StmtBlock  */
+  YYSYMBOL_VarDecls = 85,                  /* VarDecls  */
+  YYSYMBOL_StmtList = 86,                  /* StmtList  */
+  YYSYMBOL_Stmt = 87,                      /* Stmt  */
+  YYSYMBOL_SwitchStmt = 88,                /* SwitchStmt  */
+  YYSYMBOL_CaseStmts = 89,                 /* CaseStmts  */
+  YYSYMBOL_CaseStmt = 90,                  /* CaseStmt  */
+  YYSYMBOL_DefaultStmt = 91,               /* DefaultStmt  */
+  YYSYMBOL_LValue = 92,                    /* LValue  */
+  YYSYMBOL_Call = 93,                      /* Call  */
+  YYSYMBOL_OptExpr = 94,                   /* OptExpr  */
+  YYSYMBOL_Expr = 95,                      /* Expr  */
+  YYSYMBOL_Constant = 96,                  /* Constant  */
+  YYSYMBOL_Actuals = 97,                   /* Actuals  */
+  YYSYMBOL_ExprList = 98,                  /* ExprList  */
+  YYSYMBOL_OptElse = 99                    /* OptElse  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
+
+
+/* Unqualified %code blocks.  */
+#line 36 "parser.y"
+
+#include "declparse.h"
+
+int yylex(YYSTYPE *val, yyltype *loc, DeclRange *range); // in tokenstream.cc
+
+#line 411 "y.tab.c"
+
+#ifdef short
+# undef short
+#endif
+
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
+
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
+#else
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
+#else
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
+#endif
+
+#ifndef YYSIZE_T
+# ifdef __SIZE_TYPE__
+#  define YYSIZE_T __SIZE_TYPE__
+# elif defined size_t
+#  define YYSIZE_T size_t
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYSIZE_T size_t
+# else
+#  define YYSIZE_T unsigned
+# endif
+#endif
+
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_uint8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
+
+#ifndef YY_
+# if defined YYENABLE_NLS && YYENABLE_NLS
+#  if ENABLE_NLS
+#   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
+#  endif
+# endif
+# ifndef YY_
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
+#endif
+
+/* Suppress unused-variable warnings by "using" E.  */
+#if ! defined lint || defined __GNUC__
+# define YY_USE(E) ((void) (E))
+#else
+# define YY_USE(E) /* empty */
+#endif
+
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
+#else
+# define YY_INITIAL_VALUE(Value) Value
+#endif
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if !defined yyoverflow
+
+/* The parser invokes alloca or malloc; define the necessary symbols.  */
+
+# ifdef YYSTACK_ALLOC
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+    /* The OS might guarantee only one guard page at the bottom of the stack,
+       and a page size can be as small as 4096 bytes.  So we cannot safely
+       invoke alloca (N) if N exceeds 4096.  Use a slightly smaller number
+       to allow for a few compiler-allocated temporary stack slots.  */
+#   define YYSTACK_ALLOC_MAXIMUM 4032 /* reasonable circa 2006 */
+#  endif
+# else
+#  define YYSTACK_ALLOC YYMALLOC
+#  define YYSTACK_FREE YYFREE
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+#   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
+#  endif
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
+       && ! ((defined YYMALLOC || defined malloc) \
+             && (defined YYFREE || defined free)))
+#   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
+#   endif
+#  endif
+#  ifndef YYMALLOC
+#   define YYMALLOC malloc
+#   if ! defined malloc && ! defined EXIT_SUCCESS
+void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+#  ifndef YYFREE
+#   define YYFREE free
+#   if ! defined free && ! defined EXIT_SUCCESS
+void free (void *); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+# endif
+#endif /* !defined yyoverflow */
+
+#if (! defined yyoverflow \
+     && (! defined __cplusplus \
+         || (defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL \
+             && defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+
+/* A type that is properly aligned for any stack member.  */
+union yyalloc
+{
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+  YYLTYPE yyls_alloc;
+};
+
+/* The size of the maximum gap between one aligned stack and the next.  */
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
+
+/* The size of an array large to enough to hold all stacks, each with
+   N elements.  */
+# define YYSTACK_BYTES(N) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE) \
+             + YYSIZEOF (YYLTYPE)) \
+      + 2 * YYSTACK_GAP_MAXIMUM)
+
+# define YYCOPY_NEEDED 1
+
+/* Relocate STACK from its old location to the new one.  The
+   local variables YYSIZE and YYSTACKSIZE give the old and new number of
+   elements in the stack, and YYPTR gives the new location of the
+   stack.  Advance YYPTR to a properly aligned location for the next
+   stack.  */
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
+
+#endif
+
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
+/* YYFINAL -- State number of the termination state.  */
+#define YYFINAL  25
+/* YYLAST -- Last index in YYTABLE.  */
+#define YYLAST   577
+
+/* YYNTOKENS -- Number of terminals.  */
+#define YYNTOKENS  64
+/* YYNNTS -- Number of nonterminals.  */
+#define YYNNTS  36
+/* YYNRULES -- Number of rules.  */
+#define YYNRULES  105
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  206
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   300
+
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
+{
+       0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,    53,     2,     2,     2,    51,     2,     2,
+      61,    62,    49,    47,    60,    48,    54,    50,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,    57,
+      45,    44,    46,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,    55,     2,    63,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,    58,     2,    59,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
+      25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
+      35,    36,    37,    38,    39,    40,    41,    42,    43,    52,
+      56
+};
+
+#if YYDEBUG
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
+{
+       0,   134,   134,   135,   138,   151,   152,   155,   156,   157,
+     158,   161,   164,   167,   168,   169,   170,   171,   172,   175,
+     179,   181,   184,   188,   190,   193,   195,   198,   200,   203,
+     204,   207,   208,   212,   214,   218,   219,   222,   224,   227,
+     230,   234,   235,   238,   239,   242,   243,   244,   246,   248,
+     250,   252,   254,   256,   257,   260,   264,   265,   268,   271,
+     272,   275,   276,   277,   280,   282,   286,   287,   290,   291,
+     293,   295,   296,   297,   298,   299,   300,   301,   302,   303,
+     304,   305,   306,   307,   309,   311,   312,   313,   314,   316,
+     317,   319,   320,   322,   324,   327,   328,   329,   330,   331,
+     334,   335,   338,   339,   342,   343
+};
+#endif
+
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
+/* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
+   First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
+static const char *const yytname[] =
+{
+  "\"end of file\"", "error", "\"invalid token\"", "T_Void", "T_Bool",
+  "T_Int", "T_Double", "T_String", "T_Class", "T_LessEqual",
+  "T_GreaterEqual", "T_Equal", "T_NotEqual", "T_Dims", "T_And", "T_Or",
+  "T_Null", "T_Extends", "T_This", "T_Interface", "T_Implements",
+  "T_While", "T_For", "T_If", "T_Else", "T_Return", "T_Break", "T_New",
+  "T_NewArray", "T_Print", "T_ReadInteger", "T_ReadLine", "T_Incr",
+  "T_Decr", "T_Switch", "T_Case", "T_Default", "T_Colon", "T_ParseDecl",
+  "T_Identifier", "T_StringConstant", "T_IntConstant", "T_DoubleConstant",
+  "T_BoolConstant", "'='", "'<'", "'>'", "'+'", "'-'", "'*'", "'/'", "'%'",
+  "T_UnaryMinus", "'!'", "'.'", "'['", "T_Lower_Than_Else", "';'", "'{'",
+  "'}'", "','", "'('", "')'", "']'", "$accept", "Input", "Program",
+  "DeclList", "Decl", "VarDecl", "Variable", "Type", "IntfDecl",
+  "IntfList", "ClassDecl", "OptExt", "OptImpl", "ImpList", "FieldList",
+  "Field", "FnHeader", "Formals", "FormalList", "FnDecl", "StmtBlock",
+  "VarDecls", "StmtList", "Stmt", "SwitchStmt", "CaseStmts", "CaseStmt",
+  "DefaultStmt", "LValue", "Call", "OptExpr", "Expr", "Constant",
+  "Actuals", "ExprList", "OptElse", YY_NULLPTR
+};
+
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
+{
+  return yytname[yysymbol];
+}
+#endif
+
+#define YYPACT_NINF (-87)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
+
+#define YYTABLE_NINF (-68)
+
+#define yytable_value_is_error(Yyn) \
+  ((Yyn) == YYTABLE_NINF)
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int16 yypact[] =
+{
+     196,   -27,   -87,   -87,   -87,   -87,     0,     6,   244,   -87,
+      55,   -87,   244,   -87,   -87,    28,    -5,   -87,   -87,    20,
+     -87,    32,    64,    36,   -87,   -87,   -87,   -87,   -87,    35,
+     -87,   -87,    37,    59,    85,   -87,    37,   128,   -87,    -2,
+      45,    50,   -87,    74,    57,    15,    54,   -87,   -87,    63,
+      66,    67,   488,    72,    75,    76,    80,    81,    82,    84,
+      -4,   -87,   -87,   -87,   -87,   516,   516,   516,   -87,   -87,
+      88,    61,   -87,    79,   -87,    83,   376,   -87,   -87,   -87,
+      37,   -87,    60,   -87,   -87,    10,    91,   -87,   516,   516,
+     516,    99,   -87,   308,   -87,   113,   516,   516,   101,   102,
+     516,   516,   -25,   -25,   182,   -87,   -87,   -87,   -87,   516,
+     -87,   516,   516,   516,   516,   516,   516,   516,   516,   516,
+     516,   516,   516,   516,   122,   516,   -87,   126,    21,    35,
+     -87,   210,   109,   231,   -87,   117,   280,   376,   -29,   -87,
+     -87,   259,   118,   130,   -87,   376,   419,   419,   387,   387,
+     404,   357,   419,   419,   133,   133,   -25,   -25,   -25,   134,
+     163,   -87,   -87,   -87,   -87,   -87,   459,   516,   459,   -87,
+      37,   516,   141,   147,   -87,   516,   -87,   -87,   327,   183,
+      -6,   376,   -87,   171,   154,   516,   459,   -87,   -87,   197,
+      17,   -87,   -87,   161,   -87,   202,   216,   -87,   195,   459,
+      61,    61,   -87,   -87,   -87,   -87
+};
+
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
+{
+       0,     0,    14,    13,    16,    15,     0,     0,     0,    17,
+       0,     2,     4,     6,     9,     0,     0,    10,     7,     0,
+       8,     0,    24,     0,     3,     1,     5,    11,    18,    12,
+      42,    39,    36,     0,    26,    21,    36,    44,    38,     0,
+       0,    35,    23,     0,     0,     0,     0,    99,    94,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+      61,    98,    95,    97,    96,     0,     0,     0,    41,    46,
+       0,    44,    54,    68,    71,     0,    66,    72,    12,    34,
+       0,    28,    25,    30,    19,     0,     0,    33,     0,    67,
+       0,    61,    51,     0,    53,     0,     0,     0,     0,     0,
+       0,   101,    88,    89,     0,    40,    43,    69,    70,     0,
+      45,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,    37,     0,     0,     0,
+      20,     0,     0,     0,    50,     0,     0,   103,     0,    90,
+      91,     0,     0,   100,    87,    73,    83,    84,    79,    80,
+      85,    86,    81,    82,    74,    75,    77,    76,    78,    62,
+       0,    27,    22,    31,    29,    32,    67,     0,    67,    92,
+       0,     0,     0,     0,    64,   101,    63,    48,     0,   105,
+       0,   102,    52,     0,     0,    67,    67,    47,    93,     0,
+      60,    57,    65,     0,   104,     0,     0,    56,     0,    67,
+      44,    44,    55,    49,    58,    59
+};
+
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int16 yypgoto[] =
+{
+     -87,   -87,   -87,   -87,    24,   -31,   -22,   -32,   -87,   -87,
+     -87,   -87,   -87,   -87,   -87,   -87,   217,   230,   -87,   139,
+     256,   -87,   -70,   -60,   -87,   -87,    94,   -87,   -87,   -87,
+     -86,   -50,   -87,   112,   191,   -87
+};
+
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_uint8 yydefgoto[] =
+{
+       0,    10,    11,    12,    13,    14,    15,    16,    17,    45,
+      18,    34,    44,    82,   128,   164,    19,    40,    41,    20,
+      69,    37,    70,    71,    72,   190,   191,   198,    73,    74,
+      75,    76,    77,   142,   143,   187
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int16 yytable[] =
+{
+      39,   106,    93,   132,    39,    39,    68,    28,    28,   -17,
+      38,    28,    21,    85,    38,   102,   103,   104,     1,     2,
+       3,     4,     5,    28,     1,     2,     3,     4,     5,   124,
+     125,   171,    24,   172,    29,   -17,    26,    78,   131,    22,
+     133,     2,     3,     4,     5,    23,   136,   137,    39,   129,
+     141,   137,   189,   196,     9,    25,   188,   101,   126,   145,
+       9,   146,   147,   148,   149,   150,   151,   152,   153,   154,
+     155,   156,   157,   158,    84,   160,     9,    47,    30,    48,
+     162,    33,    49,    50,    51,    27,    52,    53,    54,    55,
+      56,    57,    58,    32,    35,    59,    36,   163,    42,   193,
+      91,    61,    62,    63,    64,    43,   177,    79,   179,    65,
+      80,   107,   108,    81,    66,    83,    87,   178,   -67,    30,
+     127,   181,    67,   109,    88,   137,   194,    89,    90,    94,
+     204,   205,     2,     3,     4,     5,    95,    96,   180,   203,
+     110,    97,    98,    99,    47,   100,    48,   105,   130,    49,
+      50,    51,   135,    52,    53,    54,    55,    56,    57,    58,
+     101,   159,    59,   139,   140,   161,   167,    60,    61,    62,
+      63,    64,   111,   112,   113,   114,    65,   115,   116,   169,
+     174,    66,   121,   122,   123,   -67,    30,   124,   125,    67,
+     171,   111,   112,   113,   114,   175,   115,   116,   182,     1,
+       2,     3,     4,     5,     6,   183,   189,   186,   117,   118,
+     119,   120,   121,   122,   123,     7,   192,   124,   125,   111,
+     112,   113,   114,   199,   115,   116,   176,   117,   118,   119,
+     120,   121,   122,   123,     8,     9,   124,   125,   195,   200,
+     111,   112,   113,   114,   144,   115,   116,     1,     2,     3,
+       4,     5,     6,   201,   202,   117,   118,   119,   120,   121,
+     122,   123,    86,     7,   124,   125,    46,   165,   111,   112,
+     113,   114,   166,   115,   116,    31,   117,   118,   119,   120,
+     121,   122,   123,     9,   197,   124,   125,   184,   138,   111,
+     112,   113,   114,   168,   115,   116,     0,     0,     0,     0,
+       0,     0,     0,     0,   117,   118,   119,   120,   121,   122,
+     123,     0,     0,   124,   125,     0,     0,   111,   112,   113,
+     114,   173,   115,   116,     0,   117,   118,   119,   120,   121,
+     122,   123,     0,     0,   124,   125,   111,   112,   113,   114,
+     170,   115,   116,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,   117,   118,   119,   120,   121,   122,   123,
+       0,     0,   124,   125,     0,   134,   111,   112,   113,   114,
+       0,   115,   117,   118,   119,   120,   121,   122,   123,     0,
+       0,   124,   125,     0,   185,   111,   112,   113,   114,     0,
+     115,   116,     0,     0,     0,     0,   111,   112,   -68,   -68,
+       0,     0,   117,   118,   119,   120,   121,   122,   123,     0,
+       0,   124,   125,   111,   112,   113,   114,     0,     0,     0,
+       0,   117,   118,   119,   120,   121,   122,   123,   -68,   -68,
+     124,   125,   117,   118,   119,   120,   121,   122,   123,     0,
+       0,   124,   125,     0,     0,     0,     0,     0,     0,   117,
+     118,   119,   120,   121,   122,   123,     0,     0,   124,   125,
+       0,     0,     0,     0,   -68,   -68,   119,   120,   121,   122,
+     123,     0,     0,   124,   125,    47,     0,    48,     0,     0,
+      49,    50,    51,     0,    52,    53,    54,    55,    56,    57,
+      58,     0,     0,    59,     0,     0,     0,     0,    91,    61,
+      62,    63,    64,     0,    47,     0,    48,    65,     0,     0,
+       0,     0,    66,     0,     0,    54,    55,    30,    57,    58,
+      67,     0,     0,     0,     0,     0,     0,    91,    61,    62,
+      63,    64,    47,     0,    48,     0,    65,     0,     0,     0,
+       0,    66,     0,    54,    55,    92,    57,    58,     0,    67,
+       0,     0,     0,     0,     0,    91,    61,    62,    63,    64,
+       0,     0,     0,     0,    65,     0,     0,     0,     0,    66,
+       0,     0,     0,     0,     0,     0,     0,    67
+};
+
+static const yytype_int16 yycheck[] =
+{
+      32,    71,    52,    89,    36,    37,    37,    13,    13,    13,
+      32,    13,    39,    45,    36,    65,    66,    67,     3,     4,
+       5,     6,     7,    13,     3,     4,     5,     6,     7,    54,
+      55,    60,     8,    62,    39,    39,    12,    39,    88,    39,
+      90,     4,     5,     6,     7,    39,    96,    97,    80,    39,
+     100,   101,    35,    36,    39,     0,    62,    61,    80,   109,
+      39,   111,   112,   113,   114,   115,   116,   117,   118,   119,
+     120,   121,   122,   123,    59,   125,    39,    16,    58,    18,
+      59,    17,    21,    22,    23,    57,    25,    26,    27,    28,
+      29,    30,    31,    61,    58,    34,    61,   128,    39,   185,
+      39,    40,    41,    42,    43,    20,   166,    62,   168,    48,
+      60,    32,    33,    39,    53,    58,    62,   167,    57,    58,
+      60,   171,    61,    44,    61,   175,   186,    61,    61,    57,
+     200,   201,     4,     5,     6,     7,    61,    61,   170,   199,
+      57,    61,    61,    61,    16,    61,    18,    59,    57,    21,
+      22,    23,    39,    25,    26,    27,    28,    29,    30,    31,
+      61,    39,    34,    62,    62,    39,    57,    39,    40,    41,
+      42,    43,     9,    10,    11,    12,    48,    14,    15,    62,
+      62,    53,    49,    50,    51,    57,    58,    54,    55,    61,
+      60,     9,    10,    11,    12,    61,    14,    15,    57,     3,
+       4,     5,     6,     7,     8,    58,    35,    24,    45,    46,
+      47,    48,    49,    50,    51,    19,    62,    54,    55,     9,
+      10,    11,    12,    62,    14,    15,    63,    45,    46,    47,
+      48,    49,    50,    51,    38,    39,    54,    55,    41,    37,
+       9,    10,    11,    12,    62,    14,    15,     3,     4,     5,
+       6,     7,     8,    37,    59,    45,    46,    47,    48,    49,
+      50,    51,    45,    19,    54,    55,    36,   128,     9,    10,
+      11,    12,    62,    14,    15,    19,    45,    46,    47,    48,
+      49,    50,    51,    39,   190,    54,    55,   175,    97,     9,
+      10,    11,    12,    62,    14,    15,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    45,    46,    47,    48,    49,    50,
+      51,    -1,    -1,    54,    55,    -1,    -1,     9,    10,    11,
+      12,    62,    14,    15,    -1,    45,    46,    47,    48,    49,
+      50,    51,    -1,    -1,    54,    55,     9,    10,    11,    12,
+      60,    14,    15,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    45,    46,    47,    48,    49,    50,    51,
+      -1,    -1,    54,    55,    -1,    57,     9,    10,    11,    12,
+      -1,    14,    45,    46,    47,    48,    49,    50,    51,    -1,
+      -1,    54,    55,    -1,    57,     9,    10,    11,    12,    -1,
+      14,    15,    -1,    -1,    -1,    -1,     9,    10,    11,    12,
+      -1,    -1,    45,    46,    47,    48,    49,    50,    51,    -1,
+      -1,    54,    55,     9,    10,    11,    12,    -1,    -1,    -1,
+      -1,    45,    46,    47,    48,    49,    50,    51,     9,    10,
+      54,    55,    45,    46,    47,    48,    49,    50,    51,    -1,
+      -1,    54,    55,    -1,    -1,    -1,    -1,    -1,    -1,    45,
+      46,    47,    48,    49,    50,    51,    -1,    -1,    54,    55,
+      -1,    -1,    -1,    -1,    45,    46,    47,    48,    49,    50,
+      51,    -1,    -1,    54,    55,    16,    -1,    18,    -1,    -1,
+      21,    22,    23,    -1,    25,    26,    27,    28,    29,    30,
+      31,    -1,    -1,    34,    -1,    -1,    -1,    -1,    39,    40,
+      41,    42,    43,    -1,    16,    -1,    18,    48,    -1,    -1,
+      -1,    -1,    53,    -1,    -1,    27,    28,    58,    30,    31,
+      61,    -1,    -1,    -1,    -1,    -1,    -1,    39,    40,    41,
+      42,    43,    16,    -1,    18,    -1,    48,    -1,    -1,    -1,
+      -1,    53,    -1,    27,    28,    57,    30,    31,    -1,    61,
+      -1,    -1,    -1,    -1,    -1,    39,    40,    41,    42,    43,
+      -1,    -1,    -1,    -1,    48,    -1,    -1,    -1,    -1,    53,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    61
+};
+
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
+{
+       0,     3,     4,     5,     6,     7,     8,    19,    38,    39,
+      65,    66,    67,    68,    69,    70,    71,    72,    74,    80,
+      83,    39,    39,    39,    68,     0,    68,    57,    13,    39,
+      58,    84,    61,    17,    75,    58,    61,    85,    70,    71,
+      81,    82,    39,    20,    76,    73,    81,    16,    18,    21,
+      22,    23,    25,    26,    27,    28,    29,    30,    31,    34,
+      39,    40,    41,    42,    43,    48,    53,    61,    69,    84,
+      86,    87,    88,    92,    93,    94,    95,    96,    39,    62,
+      60,    39,    77,    58,    59,    71,    80,    62,    61,    61,
+      61,    39,    57,    95,    57,    61,    61,    61,    61,    61,
+      61,    61,    95,    95,    95,    59,    86,    32,    33,    44,
+      57,     9,    10,    11,    12,    14,    15,    45,    46,    47,
+      48,    49,    50,    51,    54,    55,    70,    60,    78,    39,
+      57,    95,    94,    95,    57,    39,    95,    95,    98,    62,
+      62,    95,    97,    98,    62,    95,    95,    95,    95,    95,
+      95,    95,    95,    95,    95,    95,    95,    95,    95,    39,
+      95,    39,    59,    69,    79,    83,    62,    57,    62,    62,
+      60,    60,    62,    62,    62,    61,    63,    87,    95,    87,
+      71,    95,    57,    58,    97,    57,    24,    99,    62,    35,
+      89,    90,    62,    94,    87,    41,    36,    90,    91,    62,
+      37,    37,    59,    87,    86,    86
+};
+
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
+{
+       0,    64,    65,    65,    66,    67,    67,    68,    68,    68,
+      68,    69,    70,    71,    71,    71,    71,    71,    71,    72,
+      73,    73,    74,    75,    75,    76,    76,    77,    77,    78,
+      78,    79,    79,    80,    80,    81,    81,    82,    82,    83,
+      84,    85,    85,    86,    86,    87,    87,    87,    87,    87,
+      87,    87,    87,    87,    87,    88,    89,    89,    90,    91,
+      91,    92,    92,    92,    93,    93,    94,    94,    95,    95,
+      95,    95,    95,    95,    95,    95,    95,    95,    95,    95,
+      95,    95,    95,    95,    95,    95,    95,    95,    95,    95,
+      95,    95,    95,    95,    95,    96,    96,    96,    96,    96,
+      97,    97,    98,    98,    99,    99
+};
+
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     1,     2,     1,     2,     1,     1,     1,     1,
+       1,     2,     2,     1,     1,     1,     1,     1,     2,     5,
+       3,     0,     7,     2,     0,     2,     0,     3,     1,     2,
+       0,     1,     1,     5,     5,     1,     0,     3,     1,     2,
+       4,     2,     0,     2,     0,     2,     1,     6,     5,     9,
+       3,     2,     5,     2,     1,     8,     2,     1,     4,     3,
+       0,     1,     3,     4,     4,     6,     1,     0,     1,     2,
+       2,     1,     1,     3,     3,     3,     3,     3,     3,     3,
+       3,     3,     3,     3,     3,     3,     3,     3,     2,     2,
+       3,     3,     4,     6,     1,     1,     1,     1,     1,     1,
+       1,     0,     3,     1,     2,     0
+};
+
+
+enum { YYENOMEM = -2 };
+
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
+
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
+
+
+#define YYRECOVERING()  (!!yyerrstatus)
+
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (&yylloc, range, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
+
+/* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
+   If N is 0, then set CURRENT to the empty location which ends
+   the previous symbol: RHS[0] (always defined).  */
+
+#ifndef YYLLOC_DEFAULT
+# define YYLLOC_DEFAULT(Current, Rhs, N)                                \
+    do                                                                  \
+      if (N)                                                            \
+        {                                                               \
+          (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;        \
+          (Current).first_column = YYRHSLOC (Rhs, 1).first_column;      \
+          (Current).last_line    = YYRHSLOC (Rhs, N).last_line;         \
+          (Current).last_column  = YYRHSLOC (Rhs, N).last_column;       \
+        }                                                               \
+      else                                                              \
+        {                                                               \
+          (Current).first_line   = (Current).last_line   =              \
+            YYRHSLOC (Rhs, 0).last_line;                                \
+          (Current).first_column = (Current).last_column =              \
+            YYRHSLOC (Rhs, 0).last_column;                              \
+        }                                                               \
+    while (0)
+#endif
+
+#define YYRHSLOC(Rhs, K) ((Rhs)[K])
+
+
+/* Enable debugging if requested.  */
+#if YYDEBUG
+
+# ifndef YYFPRINTF
+#  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYFPRINTF fprintf
+# endif
+
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+/* YYLOCATION_PRINT -- Print the location on the stream.
+   This macro was not mandated originally: define only if we know
+   we won't break user code: when these are the locations we know.  */
+
+# ifndef YYLOCATION_PRINT
+
+#  if defined YY_LOCATION_PRINT
+
+   /* Temporary convenience wrapper in case some people defined the
+      undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YYLOCATION_PRINT(File, Loc)  YY_LOCATION_PRINT(File, *(Loc))
+
+#  elif defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+
+/* Print *YYLOCP on YYO.  Private, do not rely on its existence. */
+
+YY_ATTRIBUTE_UNUSED
+static int
+yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
+{
+  int res = 0;
+  int end_col = 0 != yylocp->last_column ? yylocp->last_column - 1 : 0;
+  if (0 <= yylocp->first_line)
+    {
+      res += YYFPRINTF (yyo, "%d", yylocp->first_line);
+      if (0 <= yylocp->first_column)
+        res += YYFPRINTF (yyo, ".%d", yylocp->first_column);
+    }
+  if (0 <= yylocp->last_line)
+    {
+      if (yylocp->first_line < yylocp->last_line)
+        {
+          res += YYFPRINTF (yyo, "-%d", yylocp->last_line);
+          if (0 <= end_col)
+            res += YYFPRINTF (yyo, ".%d", end_col);
+        }
+      else if (0 <= end_col && yylocp->first_column < end_col)
+        res += YYFPRINTF (yyo, "-%d", end_col);
+    }
+  return res;
+}
+
+#   define YYLOCATION_PRINT  yy_location_print_
+
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT(File, Loc)  YYLOCATION_PRINT(File, &(Loc))
+
+#  else
+
+#   define YYLOCATION_PRINT(File, Loc) ((void) 0)
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT  YYLOCATION_PRINT
+
+#  endif
+# endif /* !defined YYLOCATION_PRINT */
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value, Location, range); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
+static void
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, DeclRange *range)
+{
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (yylocationp);
+  YY_USE (range);
+  if (!yyvaluep)
+    return;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
+
+static void
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, DeclRange *range)
+{
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
+
+  YYLOCATION_PRINT (yyo, yylocationp);
+  YYFPRINTF (yyo, ": ");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, yylocationp, range);
+  YYFPRINTF (yyo, ")");
+}
+
+/*------------------------------------------------------------------.
+| yy_stack_print -- Print the state stack from its BOTTOM up to its |
+| TOP (included).                                                   |
+`------------------------------------------------------------------*/
+
+static void
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
+{
+  YYFPRINTF (stderr, "Stack now");
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
+  YYFPRINTF (stderr, "\n");
+}
+
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
+
+
+/*------------------------------------------------.
+| Report that the YYRULE is going to be reduced.  |
+`------------------------------------------------*/
+
+static void
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp,
+                 int yyrule, DeclRange *range)
+{
+  int yylno = yyrline[yyrule];
+  int yynrhs = yyr2[yyrule];
+  int yyi;
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
+  /* The symbols being reduced.  */
+  for (yyi = 0; yyi < yynrhs; yyi++)
+    {
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)],
+                       &(yylsp[(yyi + 1) - (yynrhs)]), range);
+      YYFPRINTF (stderr, "\n");
+    }
+}
+
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, yylsp, Rule, range); \
+} while (0)
+
+/* Nonzero means print parse trace.  It is left uninitialized so that
+   multiple parsers can coexist.  */
+int yydebug;
+#else /* !YYDEBUG */
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
+# define YY_STACK_PRINT(Bottom, Top)
+# define YY_REDUCE_PRINT(Rule)
+#endif /* !YYDEBUG */
+
+
+/* YYINITDEPTH -- initial size of the parser's stacks.  */
+#ifndef YYINITDEPTH
+# define YYINITDEPTH 200
+#endif
+
+/* YYMAXDEPTH -- maximum size the stacks can grow to (effective only
+   if the built-in stack extension method is used).
+
+   Do not make this value too large; the results are undefined if
+   YYSTACK_ALLOC_MAXIMUM < YYSTACK_BYTES (YYMAXDEPTH)
+   evaluated with infinite-precision integer arithmetic.  */
+
+#ifndef YYMAXDEPTH
+# define YYMAXDEPTH 10000
+#endif
+/* Parser data structure.  */
+struct yypstate
+  {
+    /* Number of syntax errors so far.  */
+    int yynerrs;
+
+    yy_state_fast_t yystate;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
+
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss;
+    yy_state_t *yyssp;
+
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs;
+    YYSTYPE *yyvsp;
+
+    /* The location stack: array, bottom, top.  */
+    YYLTYPE yylsa[YYINITDEPTH];
+    YYLTYPE *yyls;
+    YYLTYPE *yylsp;
+    /* Whether this instance has not started parsing yet.
+     * If 2, it corresponds to a finished parsing.  */
+    int yynew;
+  };
+
+
+
+
+
+
+/*-----------------------------------------------.
+| Release the memory associated to this symbol.  |
+`-----------------------------------------------*/
+
+static void
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, YYLTYPE *yylocationp, DeclRange *range)
+{
+  YY_USE (yyvaluep);
+  YY_USE (yylocationp);
+  YY_USE (range);
+  if (!yymsg)
+    yymsg = "Deleting";
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+
+
+
+int
+yyparse (DeclRange *range)
+{
+  yypstate *yyps = yypstate_new ();
+  if (!yyps)
+    {
+      static YYLTYPE yyloc_default
+# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+  = { 1, 1, 1, 1 }
+# endif
+;
+      YYLTYPE yylloc = yyloc_default;
+      yyerror (&yylloc, range, YY_("memory exhausted"));
+      return 2;
+    }
+  int yystatus = yypull_parse (yyps, range);
+  yypstate_delete (yyps);
+  return yystatus;
+}
+
+int
+yypull_parse (yypstate *yyps, DeclRange *range)
+{
+  YY_ASSERT (yyps);
+  static YYLTYPE yyloc_default
+# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+  = { 1, 1, 1, 1 }
+# endif
+;
+  YYLTYPE yylloc = yyloc_default;
+  int yystatus;
+  do {
+    YYSTYPE yylval;
+    int yychar = yylex (&yylval, &yylloc, range);
+    yystatus = yypush_parse (yyps, yychar, &yylval, &yylloc, range);
+  } while (yystatus == YYPUSH_MORE);
+  return yystatus;
+}
+
+#define yynerrs yyps->yynerrs
+#define yystate yyps->yystate
+#define yyerrstatus yyps->yyerrstatus
+#define yyssa yyps->yyssa
+#define yyss yyps->yyss
+#define yyssp yyps->yyssp
+#define yyvsa yyps->yyvsa
+#define yyvs yyps->yyvs
+#define yyvsp yyps->yyvsp
+#define yylsa yyps->yylsa
+#define yyls yyps->yyls
+#define yylsp yyps->yylsp
+#define yystacksize yyps->yystacksize
+
+/* Initialize the parser data structure.  */
+static void
+yypstate_clear (yypstate *yyps)
+{
+  yynerrs = 0;
+  yystate = 0;
+  yyerrstatus = 0;
+
+  yyssp = yyss;
+  yyvsp = yyvs;
+  yylsp = yyls;
+
+  /* Initialize the state stack, in case yypcontext_expected_tokens is
+     called before the first call to yyparse. */
+  *yyssp = 0;
+  yyps->yynew = 1;
+}
+
+/* Initialize the parser data structure.  */
+yypstate *
+yypstate_new (void)
+{
+  yypstate *yyps;
+  yyps = YY_CAST (yypstate *, YYMALLOC (sizeof *yyps));
+  if (!yyps)
+    return YY_NULLPTR;
+  yystacksize = YYINITDEPTH;
+  yyss = yyssa;
+  yyvs = yyvsa;
+  yyls = yylsa;
+  yypstate_clear (yyps);
+  return yyps;
+}
+
+void
+yypstate_delete (yypstate *yyps)
+{
+  if (yyps)
+    {
+#ifndef yyoverflow
+      /* If the stack was reallocated but the parse did not complete, then the
+         stack still needs to be freed.  */
+      if (yyss != yyssa)
+        YYSTACK_FREE (yyss);
+#endif
+      YYFREE (yyps);
+    }
+}
+
+
+
+/*---------------.
+| yypush_parse.  |
+`---------------*/
+
+int
+yypush_parse (yypstate *yyps,
+              int yypushed_char, YYSTYPE const *yypushed_val, YYLTYPE *yypushed_loc, DeclRange *range)
+{
+/* Lookahead token kind.  */
+int yychar;
+
+
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+/* Location data for the lookahead symbol.  */
+static YYLTYPE yyloc_default
+# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+  = { 1, 1, 1, 1 }
+# endif
+;
+YYLTYPE yylloc = yyloc_default;
+
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
+  /* The variables used to return semantic value and location from the
+     action routines.  */
+  YYSTYPE yyval;
+  YYLTYPE yyloc;
+
+  /* The locations where the error started and ended.  */
+  YYLTYPE yyerror_range[3];
+
+
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N), yylsp -= (N))
+
+  /* The number of symbols on the RHS of the reduced rule.
+     Keep to zero when no symbol should be popped.  */
+  int yylen = 0;
+
+  switch (yyps->yynew)
+    {
+    case 0:
+      yyn = yypact[yystate];
+      goto yyread_pushed_token;
+
+    case 2:
+      yypstate_clear (yyps);
+      break;
+
+    default:
+      break;
+    }
+
+  YYDPRINTF ((stderr, "Starting parse\n"));
+
+  yychar = YYEMPTY; /* Cause a token to be read.  */
+
+  yylsp[0] = *yypushed_loc;
+  goto yysetstate;
+
+
+/*------------------------------------------------------------.
+| yynewstate -- push a new state, which is found in yystate.  |
+`------------------------------------------------------------*/
+yynewstate:
+  /* In all cases, when you get here, the value and location stacks
+     have just been pushed.  So pushing a state here evens the stacks.  */
+  yyssp++;
+
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
+
+  if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
+    {
+      /* Get the current used size of the three stacks, in elements.  */
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
+
+# if defined yyoverflow
+      {
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+        YYLTYPE *yyls1 = yyls;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yyls1, yysize * YYSIZEOF (*yylsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
+        yyls = yyls1;
+      }
+# else /* defined YYSTACK_RELOCATE */
+      /* Extend the stack our own way.  */
+      if (YYMAXDEPTH <= yystacksize)
+        YYNOMEM;
+      yystacksize *= 2;
+      if (YYMAXDEPTH < yystacksize)
+        yystacksize = YYMAXDEPTH;
+
+      {
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+        YYSTACK_RELOCATE (yyls_alloc, yyls);
+#  undef YYSTACK_RELOCATE
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
+      }
+# endif
+
+      yyssp = yyss + yysize - 1;
+      yyvsp = yyvs + yysize - 1;
+      yylsp = yyls + yysize - 1;
+
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
+
+      if (yyss + yystacksize - 1 <= yyssp)
+        YYABORT;
+    }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
+
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
+
+  goto yybackup;
+
+
+/*-----------.
+| yybackup.  |
+`-----------*/
+yybackup:
+  /* Do appropriate processing given the current state.  Read a
+     lookahead token if we need one and don't already have one.  */
+
+  /* First try to decide what to do without reference to lookahead token.  */
+  yyn = yypact[yystate];
+  if (yypact_value_is_default (yyn))
+    goto yydefault;
+
+  /* Not known => get a lookahead token if don't already have one.  */
+
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
+  if (yychar == YYEMPTY)
+    {
+      if (!yyps->yynew)
+        {
+          YYDPRINTF ((stderr, "Return for a new token:\n"));
+          yyresult = YYPUSH_MORE;
+          goto yypushreturn;
+        }
+      yyps->yynew = 0;
+yyread_pushed_token:
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yypushed_char;
+      if (yypushed_val)
+        yylval = *yypushed_val;
+      if (yypushed_loc)
+        yylloc = *yypushed_loc;
+    }
+
+  if (yychar <= YYEOF)
+    {
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
+      YYDPRINTF ((stderr, "Now at end of input.\n"));
+    }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      yyerror_range[1] = yylloc;
+      goto yyerrlab1;
+    }
+  else
+    {
+      yytoken = YYTRANSLATE (yychar);
+      YY_SYMBOL_PRINT ("Next token is", yytoken, &yylval, &yylloc);
+    }
+
+  /* If the proper action on seeing token YYTOKEN is to reduce or to
+     detect an error, take that action.  */
+  yyn += yytoken;
+  if (yyn < 0 || YYLAST < yyn || yycheck[yyn] != yytoken)
+    goto yydefault;
+  yyn = yytable[yyn];
+  if (yyn <= 0)
+    {
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
+      yyn = -yyn;
+      goto yyreduce;
+    }
+
+  /* Count tokens shifted since error; after three, turn off error
+     status.  */
+  if (yyerrstatus)
+    yyerrstatus--;
+
+  /* Shift the lookahead token.  */
+  YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
+  yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+  *++yylsp = yylloc;
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
+  goto yynewstate;
+
+
+/*-----------------------------------------------------------.
+| yydefault -- do the default action for the current state.  |
+`-----------------------------------------------------------*/
+yydefault:
+  yyn = yydefact[yystate];
+  if (yyn == 0)
+    goto yyerrlab;
+  goto yyreduce;
+
+
+/*-----------------------------.
+| yyreduce -- do a reduction.  |
+`-----------------------------*/
+yyreduce:
+  /* yyn is the number of a rule to reduce with.  */
+  yylen = yyr2[yyn];
+
+  /* If YYLEN is nonzero, implement the default value of the action:
+     '$$ = $1'.
+
+     Otherwise, the following line sets YYVAL to garbage.
+     This behavior is undocumented and Bison
+     users should not rely upon it.  Assigning to YYVAL
+     unconditionally makes the parser a bit smaller, and it avoids a
+     GCC warning that YYVAL may be used uninitialized.  */
+  yyval = yyvsp[1-yylen];
+
+  /* Default location. */
+  YYLLOC_DEFAULT (yyloc, (yylsp - yylen), yylen);
+  yyerror_range[1] = yyloc;
+  YY_REDUCE_PRINT (yyn);
+  switch (yyn)
+    {
+  case 3: /* Input: T_ParseDecl Decl  */
+#line 135 "parser.y"
+                                    { range->decl = (yyvsp[0].decl); }
+#line 1819 "y.tab.c"
+    break;
+
+  case 4: /* Program: DeclList  */
+#line 138 "parser.y"
+                                   { 
+                                      (yylsp[0]); 
+                                      Program *program = new Program((yyvsp[0].declList));
+                                      // if no errors, advance to next phase
+                                      // or hand the program to the caller
+                                      if (ReportError::NumErrors() == 0) {
+                                          if (range) range->program = program;
+                                          else program->Check();
+                                      }
+                                    }
+#line 1834 "y.tab.c"
+    break;
+
+  case 5: /* DeclList: DeclList Decl  */
+#line 151 "parser.y"
+                                    { ((yyval.declList)=(yyvsp[-1].declList))->Append((yyvsp[0].decl)); }
+#line 1840 "y.tab.c"
+    break;
+
+  case 6: /* DeclList: Decl  */
+#line 152 "parser.y"
+                                    { ((yyval.declList) = new List<Decl*>)->Append((yyvsp[0].decl)); }
+#line 1846 "y.tab.c"
+    break;
+
+  case 8: /* Decl: FnDecl  */
+#line 156 "parser.y"
+                                    { (yyval.decl)=(yyvsp[0].fDecl); }
+#line 1852 "y.tab.c"
+    break;
+
+  case 9: /* Decl: VarDecl  */
+#line 157 "parser.y"
+                                    { (yyval.decl)=(yyvsp[0].var); }
+#line 1858 "y.tab.c"
+    break;
+
+  case 12: /* Variable: Type T_Identifier  */
+#line 164 "parser.y"
+                                    { (yyval.var) = new VarDecl(new Identifier((yylsp[0]), (yyvsp[0].identifier)), (yyvsp[-1].type)); }
+#line 1864 "y.tab.c"
+    break;
+
+  case 13: /* Type: T_Int  */
+#line 167 "parser.y"
+                                    { (yyval.type) = Type::intType; }
+#line 1870 "y.tab.c"
+    break;
+
+  case 14: /* Type: T_Bool  */
+#line 168 "parser.y"
+                                    { (yyval.type) = Type::boolType; }
+#line 1876 "y.tab.c"
+    break;
+
+  case 15: /* Type: T_String  */
+#line 169 "parser.y"
+                                    { (yyval.type) = Type::stringType; }
+#line 1882 "y.tab.c"
+    break;
+
+  case 16: /* Type: T_Double  */
+#line 170 "parser.y"
+                                    { (yyval.type) = Type::doubleType; }
+#line 1888 "y.tab.c"
+    break;
+
+  case 17: /* Type: T_Identifier  */
+#line 171 "parser.y"
+                                    { (yyval.type) = new NamedType(new Identifier((yylsp[0]),(yyvsp[0].identifier))); }
+#line 1894 "y.tab.c"
+    break;
+
+  case 18: /* Type: Type T_Dims  */
+#line 172 "parser.y"
+                                    { (yyval.type) = new ArrayType(Join((yylsp[-1]), (yylsp[0])), (yyvsp[-1].type)); }
+#line 1900 "y.tab.c"
+    break;
+
+  case 19: /* IntfDecl: T_Interface T_Identifier '{' IntfList '}'  */
+#line 176 "parser.y"
+                                    { (yyval.decl) = new InterfaceDecl(new Identifier((yylsp[-3]), (yyvsp[-3].identifier)), (yyvsp[-1].declList)); }
+#line 1906 "y.tab.c"
+    break;
+
+  case 20: /* IntfList: IntfList FnHeader ';'  */
+#line 180 "parser.y"
+                                    { ((yyval.declList)=(yyvsp[-2].declList))->Append((yyvsp[-1].fDecl)); }
+#line 1912 "y.tab.c"
+    break;
+
+  case 21: /* IntfList: %empty  */
+#line 181 "parser.y"
+                                    { (yyval.declList) = new List<Decl*>(); }
+#line 1918 "y.tab.c"
+    break;
+
+  case 22: /* ClassDecl: T_Class T_Identifier OptExt OptImpl '{' FieldList '}'  */
+#line 185 "parser.y"
+                                    { (yyval.decl) = new ClassDecl(new Identifier((yylsp[-5]), (yyvsp[-5].identifier)), (yyvsp[-4].cType), (yyvsp[-3].cTypeList), (yyvsp[-1].declList)); }
+#line 1924 "y.tab.c"
+    break;
+
+  case 23: /* OptExt: T_Extends T_Identifier  */
+#line 189 "parser.y"
+                                    { (yyval.cType) = new NamedType(new Identifier((yylsp[0]), (yyvsp[0].identifier))); }
+#line 1930 "y.tab.c"
+    break;
+
+  case 24: /* OptExt: %empty  */
+#line 190 "parser.y"
+                                    { (yyval.cType) = NULL; }
+#line 1936 "y.tab.c"
+    break;
+
+  case 25: /* OptImpl: T_Implements ImpList  */
+#line 194 "parser.y"
+                                    { (yyval.cTypeList) = (yyvsp[0].cTypeList); }
+#line 1942 "y.tab.c"
+    break;
+
+  case 26: /* OptImpl: %empty  */
+#line 195 "parser.y"
+                                    { (yyval.cTypeList) = new List<NamedType*>; }
+#line 1948 "y.tab.c"
+    break;
+
+  case 27: /* ImpList: ImpList ',' T_Identifier  */
+#line 199 "parser.y"
+                                    { ((yyval.cTypeList)=(yyvsp[-2].cTypeList))->Append(new NamedType(new Identifier((yylsp[0]), (yyvsp[0].identifier)))); }
+#line 1954 "y.tab.c"
+    break;
+
+  case 28: /* ImpList: T_Identifier  */
+#line 200 "parser.y"
+                                    { ((yyval.cTypeList)=new List<NamedType*>)->Append(new NamedType(new Identifier((yylsp[0]), (yyvsp[0].identifier)))); }
+#line 1960 "y.tab.c"
+    break;
+
+  case 29: /* FieldList: FieldList Field  */
+#line 203 "parser.y"
+                                    { ((yyval.declList)=(yyvsp[-1].declList))->Append((yyvsp[0].decl)); }
+#line 1966 "y.tab.c"
+    break;
+
+  case 30: /* FieldList: %empty  */
+#line 204 "parser.y"
+                                    { (yyval.declList) = new List<Decl*>(); }
+#line 1972 "y.tab.c"
+    break;
+
+  case 31: /* Field: VarDecl  */
+#line 207 "parser.y"
+                                    { (yyval.decl) = (yyvsp[0].var); }
+#line 1978 "y.tab.c"
+    break;
+
+  case 32: /* Field: FnDecl  */
+#line 208 "parser.y"
+                                    { (yyval.decl) = (yyvsp[0].fDecl); }
+#line 1984 "y.tab.c"
+    break;
+
+  case 33: /* FnHeader: Type T_Identifier '(' Formals ')'  */
+#line 213 "parser.y"
+                                    { (yyval.fDecl) = new FnDecl(new Identifier((yylsp[-3]), (yyvsp[-3].identifier)), (yyvsp[-4].type), (yyvsp[-1].varList)); }
+#line 1990 "y.tab.c"
+    break;
+
+  case 34: /* FnHeader: T_Void T_Identifier '(' Formals ')'  */
+#line 215 "parser.y"
+                                    { (yyval.fDecl) = new FnDecl(new Identifier((yylsp[-3]), (yyvsp[-3].identifier)), Type::voidType, (yyvsp[-1].varList)); }
+#line 1996 "y.tab.c"
+    break;
+
+  case 35: /* Formals: FormalList  */
+#line 218 "parser.y"
+                                    { (yyval.varList) = (yyvsp[0].varList); }
+#line 2002 "y.tab.c"
+    break;
+
+  case 36: /* Formals: %empty  */
+#line 219 "parser.y"
+                                    { (yyval.varList) = new List<VarDecl*>; }
+#line 2008 "y.tab.c"
+    break;
+
+  case 37: /* FormalList: FormalList ',' Variable  */
+#line 223 "parser.y"
+                                    { ((yyval.varList)=(yyvsp[-2].varList))->Append((yyvsp[0].var)); }
+#line 2014 "y.tab.c"
+    break;
+
+  case 38: /* FormalList: Variable  */
+#line 224 "parser.y"
+                                    { ((yyval.varList) = new List<VarDecl*>)->Append((yyvsp[0].var)); }
+#line 2020 "y.tab.c"
+    break;
+
+  case 39: /* FnDecl: FnHeader StmtBlock  */
+#line 227 "parser.y"
+                                    { ((yyval.fDecl)=(yyvsp[-1].fDecl))->SetFunctionBody((yyvsp[0].stmt)); }
+#line 2026 "y.tab.c"
+    break;
+
+  case 40: /* StmtBlock: '{' VarDecls StmtList '}'  */
+#line 231 "parser.y"
+                                    { (yyval.stmt) = new StmtBlock((yyvsp[-2].varList), (yyvsp[-1].stmtList)); }
+#line 2032 "y.tab.c"
+    break;
+
+  case 41: /* VarDecls: VarDecls VarDecl  */
+#line 234 "parser.y"
+                                    { ((yyval.varList)=(yyvsp[-1].varList))->Append((yyvsp[0].var)); }
+#line 2038 "y.tab.c"
+    break;
+
+  case 42: /* VarDecls: %empty  */
+#line 235 "parser.y"
+                                    { (yyval.varList) = new List<VarDecl*>; }
+#line 2044 "y.tab.c"
+    break;
+
+  case 43: /* StmtList: Stmt StmtList  */
+#line 238 "parser.y"
+                                    { (yyval.stmtList) = (yyvsp[0].stmtList); (yyval.stmtList)->InsertAt((yyvsp[-1].stmt), 0); }
+#line 2050 "y.tab.c"
+    break;
+
+  case 44: /* StmtList: %empty  */
+#line 239 "parser.y"
+                                    { (yyval.stmtList) = new List<Stmt*>; }
+#line 2056 "y.tab.c"
+    break;
+
+  case 45: /* Stmt: OptExpr ';'  */
+#line 242 "parser.y"
+                                    { (yyval.stmt) = (yyvsp[-1].expr); }
+#line 2062 "y.tab.c"
+    break;
+
+  case 47: /* Stmt: T_If '(' Expr ')' Stmt OptElse  */
+#line 245 "parser.y"
+                                    { (yyval.stmt) = new IfStmt((yyvsp[-3].expr), (yyvsp[-1].stmt), (yyvsp[0].stmt)); }
+#line 2068 "y.tab.c"
+    break;
+
+  case 48: /* Stmt: T_While '(' Expr ')' Stmt  */
+#line 247 "parser.y"
+                                    { (yyval.stmt) = new WhileStmt((yyvsp[-2].expr), (yyvsp[0].stmt)); }
+#line 2074 "y.tab.c"
+    break;
+
+  case 49: /* Stmt: T_For '(' OptExpr ';' Expr ';' OptExpr ')' Stmt  */
+#line 249 "parser.y"
+                                    { (yyval.stmt) = new ForStmt((yyvsp[-6].expr), (yyvsp[-4].expr), (yyvsp[-2].expr), (yyvsp[0].stmt)); }
+#line 2080 "y.tab.c"
+    break;
+
+  case 50: /* Stmt: T_Return Expr ';'  */
+#line 251 "parser.y"
+                                    { (yyval.stmt) = new ReturnStmt((yylsp[-1]), (yyvsp[-1].expr)); }
+#line 2086 "y.tab.c"
+    break;
+
+  case 51: /* Stmt: T_Return ';'  */
+#line 253 "parser.y"
+                                    { (yyval.stmt) = new ReturnStmt((yylsp[-1]), new EmptyExpr()); }
+#line 2092 "y.tab.c"
+    break;
+
+  case 52: /* Stmt: T_Print '(' ExprList ')' ';'  */
+#line 255 "parser.y"
+                                    { (yyval.stmt) = new PrintStmt((yyvsp[-2].exprList)); }
+#line 2098 "y.tab.c"
+    break;
+
+  case 53: /* Stmt: T_Break ';'  */
+#line 256 "parser.y"
+                                    { (yyval.stmt) = new BreakStmt((yylsp[-1])); }
+#line 2104 "y.tab.c"
+    break;
+
+  case 54: /* Stmt: SwitchStmt  */
+#line 257 "parser.y"
+                                    { (yyval.stmt) = (yyvsp[0].switchStmt); }
+#line 2110 "y.tab.c"
+    break;
+
+  case 55: /* SwitchStmt: T_Switch '(' Expr ')' '{' CaseStmts DefaultStmt '}'  */
+#line 260 "parser.y"
+                                                                   { if ((yyvsp[-1].caseStmt)) (yyvsp[-2].caseStmtList)->Append((yyvsp[-1].caseStmt));
+                                                                     (yyval.switchStmt) = new SwitchStmt((yyvsp[-5].expr), (yyvsp[-2].caseStmtList));}
+#line 2117 "y.tab.c"
+    break;
+
+  case 56: /* CaseStmts: CaseStmts CaseStmt  */
+#line 264 "parser.y"
+                                    { ((yyval.caseStmtList) = (yyvsp[-1].caseStmtList))->Append((yyvsp[0].caseStmt)); }
+#line 2123 "y.tab.c"
+    break;
+
+  case 57: /* CaseStmts: CaseStmt  */
+#line 265 "parser.y"
+                                    { ((yyval.caseStmtList) = new List<SwitchStmt::CaseStmt*>)->Append((yyvsp[0].caseStmt));}
+#line 2129 "y.tab.c"
+    break;
+
+  case 58: /* CaseStmt: T_Case T_IntConstant T_Colon StmtList  */
+#line 268 "parser.y"
+                                                       { (yyval.caseStmt) = new SwitchStmt::CaseStmt((new IntConstant((yylsp[-2]), (yyvsp[-2].integerConstant))), (yyvsp[0].stmtList)); }
+#line 2135 "y.tab.c"
+    break;
+
+  case 59: /* DefaultStmt: T_Default T_Colon StmtList  */
+#line 271 "parser.y"
+                                                { (yyval.caseStmt) = new SwitchStmt::CaseStmt(NULL, (yyvsp[0].stmtList)); }
+#line 2141 "y.tab.c"
+    break;
+
+  case 60: /* DefaultStmt: %empty  */
+#line 272 "parser.y"
+                                            { (yyval.caseStmt) = NULL;}
+#line 2147 "y.tab.c"
+    break;
+
+  case 61: /* LValue: T_Identifier  */
+#line 275 "parser.y"
+                                     { (yyval.lvalue) = new FieldAccess(NULL, new Identifier((yylsp[0]), (yyvsp[0].identifier))); }
+#line 2153 "y.tab.c"
+    break;
+
+  case 62: /* LValue: Expr '.' T_Identifier  */
+#line 276 "parser.y"
+                                     { (yyval.lvalue) = new FieldAccess((yyvsp[-2].expr), new Identifier((yylsp[0]), (yyvsp[0].identifier))); }
+#line 2159 "y.tab.c"
+    break;
+
+  case 63: /* LValue: Expr '[' Expr ']'  */
+#line 277 "parser.y"
+                                     { (yyval.lvalue) = new ArrayAccess(Join((yylsp[-3]), (yylsp[0])), (yyvsp[-3].expr), (yyvsp[-1].expr)); }
+#line 2165 "y.tab.c"
+    break;
+
+  case 64: /* Call: T_Identifier '(' Actuals ')'  */
+#line 281 "parser.y"
+                                    { (yyval.expr) = new Call(Join((yylsp[-3]),(yylsp[0])), NULL, new Identifier((yylsp[-3]),(yyvsp[-3].identifier)), (yyvsp[-1].exprList)); }
+#line 2171 "y.tab.c"
+    break;
+
+  case 65: /* Call: Expr '.' T_Identifier '(' Actuals ')'  */
+#line 283 "parser.y"
+                                    { (yyval.expr) = new Call(Join((yylsp[-5]),(yylsp[0])), (yyvsp[-5].expr), new Identifier((yylsp[-3]),(yyvsp[-3].identifier)), (yyvsp[-1].exprList)); }
+#line 2177 "y.tab.c"
+    break;
+
+  case 66: /* OptExpr: Expr  */
+#line 286 "parser.y"
+                                    { (yyval.expr) = (yyvsp[0].expr); }
+#line 2183 "y.tab.c"
+    break;
+
+  case 67: /* OptExpr: %empty  */
+#line 287 "parser.y"
+                                    { (yyval.expr) = new EmptyExpr(); }
+#line 2189 "y.tab.c"
+    break;
+
+  case 68: /* Expr: LValue  */
+#line 290 "parser.y"
+                                    { (yyval.expr) = (yyvsp[0].lvalue); }
+#line 2195 "y.tab.c"
+    break;
+
+  case 69: /* Expr: LValue T_Incr  */
+#line 291 "parser.y"
+                                    { (yyval.expr) = new PostfixExpr((yyvsp[-1].lvalue),(new Operator((yylsp[0]), OpIncrement))); }
+#line 2201 "y.tab.c"
+    break;
+
+  case 70: /* Expr: LValue T_Decr  */
+#line 293 "parser.y"
+                                    { (yyval.expr) = new PostfixExpr((yyvsp[-1].lvalue),(new Operator((yylsp[0]), OpDecrement))); }
+#line 2207 "y.tab.c"
+    break;
+
+  case 73: /* Expr: LValue '=' Expr  */
+#line 297 "parser.y"
+                                    { (yyval.expr) = new AssignExpr((yyvsp[-2].lvalue), new Operator((yylsp[-1]), OpAssign), (yyvsp[0].expr)); }
+#line 2213 "y.tab.c"
+    break;
+
+  case 74: /* Expr: Expr '+' Expr  */
+#line 298 "parser.y"
+                                    { (yyval.expr) = new ArithmeticExpr((yyvsp[-2].expr), new Operator((yylsp[-1]), OpPlus), (yyvsp[0].expr)); }
+#line 2219 "y.tab.c"
+    break;
+
+  case 75: /* Expr: Expr '-' Expr  */
+#line 299 "parser.y"
+                                    { (yyval.expr) = new ArithmeticExpr((yyvsp[-2].expr), new Operator((yylsp[-1]), OpMinus), (yyvsp[0].expr)); }
+#line 2225 "y.tab.c"
+    break;
+
+  case 76: /* Expr: Expr '/' Expr  */
+#line 300 "parser.y"
+                                    { (yyval.expr) = new ArithmeticExpr((yyvsp[-2].expr), new Operator((yylsp[-1]), OpDivide), (yyvsp[0].expr)); }
+#line 2231 "y.tab.c"
+    break;
+
+  case 77: /* Expr: Expr '*' Expr  */
+#line 301 "parser.y"
+                                    { (yyval.expr) = new ArithmeticExpr((yyvsp[-2].expr), new Operator((yylsp[-1]), OpTimes), (yyvsp[0].expr)); }
+#line 2237 "y.tab.c"
+    break;
+
+  case 78: /* Expr: Expr '%' Expr  */
+#line 302 "parser.y"
+                                    { (yyval.expr) = new ArithmeticExpr((yyvsp[-2].expr), new Operator((yylsp[-1]), OpModulo), (yyvsp[0].expr)); }
+#line 2243 "y.tab.c"
+    break;
+
+  case 79: /* Expr: Expr T_Equal Expr  */
+#line 303 "parser.y"
+                                    { (yyval.expr) = new EqualityExpr((yyvsp[-2].expr), new Operator((yylsp[-1]), OpEqual), (yyvsp[0].expr)); }
+#line 2249 "y.tab.c"
+    break;
+
+  case 80: /* Expr: Expr T_NotEqual Expr  */
+#line 304 "parser.y"
+                                    { (yyval.expr) = new EqualityExpr((yyvsp[-2].expr), new Operator((yylsp[-1]), OpNotEqual), (yyvsp[0].expr)); }
+#line 2255 "y.tab.c"
+    break;
+
+  case 81: /* Expr: Expr '<' Expr  */
+#line 305 "parser.y"
+                                    { (yyval.expr) = new RelationalExpr((yyvsp[-2].expr), new Operator((yylsp[-1]), OpLess), (yyvsp[0].expr)); }
+#line 2261 "y.tab.c"
+    break;
+
+  case 82: /* Expr: Expr '>' Expr  */
+#line 306 "parser.y"
+                                    { (yyval.expr) = new RelationalExpr((yyvsp[-2].expr), new Operator((yylsp[-1]), OpGreater), (yyvsp[0].expr)); }
+#line 2267 "y.tab.c"
+    break;
+
+  case 83: /* Expr: Expr T_LessEqual Expr  */
+#line 308 "parser.y"
+                                    { (yyval.expr) = new RelationalExpr((yyvsp[-2].expr), new Operator((yylsp[-1]), OpLessEqual), (yyvsp[0].expr)); }
+#line 2273 "y.tab.c"
+    break;
+
+  case 84: /* Expr: Expr T_GreaterEqual Expr  */
+#line 310 "parser.y"
+                                    { (yyval.expr) = new RelationalExpr((yyvsp[-2].expr), new Operator((yylsp[-1]), OpGreaterEqual), (yyvsp[0].expr)); }
+#line 2279 "y.tab.c"
+    break;
+
+  case 85: /* Expr: Expr T_And Expr  */
+#line 311 "parser.y"
+                                    { (yyval.expr) = new LogicalExpr((yyvsp[-2].expr), new Operator((yylsp[-1]), OpAnd), (yyvsp[0].expr)); }
+#line 2285 "y.tab.c"
+    break;
+
+  case 86: /* Expr: Expr T_Or Expr  */
+#line 312 "parser.y"
+                                    { (yyval.expr) = new LogicalExpr((yyvsp[-2].expr), new Operator((yylsp[-1]), OpOr), (yyvsp[0].expr)); }
+#line 2291 "y.tab.c"
+    break;
+
+  case 87: /* Expr: '(' Expr ')'  */
+#line 313 "parser.y"
+                                    { (yyval.expr) = (yyvsp[-1].expr); }
+#line 2297 "y.tab.c"
+    break;
+
+  case 88: /* Expr: '-' Expr  */
+#line 315 "parser.y"
+                                    { (yyval.expr) = new ArithmeticExpr(new Operator((yylsp[-1]), OpMinus), (yyvsp[0].expr)); }
+#line 2303 "y.tab.c"
+    break;
+
+  case 89: /* Expr: '!' Expr  */
+#line 316 "parser.y"
+                                    { (yyval.expr) = new LogicalExpr(new Operator((yylsp[-1]), OpNot), (yyvsp[0].expr)); }
+#line 2309 "y.tab.c"
+    break;
+
+  case 90: /* Expr: T_ReadInteger '(' ')'  */
+#line 318 "parser.y"
+                                    { (yyval.expr) = new ReadIntegerExpr(Join((yylsp[-2]),(yylsp[0]))); }
+#line 2315 "y.tab.c"
+    break;
+
+  case 91: /* Expr: T_ReadLine '(' ')'  */
+#line 319 "parser.y"
+                                    { (yyval.expr) = new ReadLineExpr(Join((yylsp[-2]),(yylsp[0]))); }
+#line 2321 "y.tab.c"
+    break;
+
+  case 92: /* Expr: T_New '(' T_Identifier ')'  */
+#line 321 "parser.y"
+                                    { (yyval.expr) = new NewExpr(Join((yylsp[-3]),(yylsp[0])),new NamedType(new Identifier((yylsp[-1]),(yyvsp[-1].identifier)))); }
+#line 2327 "y.tab.c"
+    break;
+
+  case 93: /* Expr: T_NewArray '(' Expr ',' Type ')'  */
+#line 323 "parser.y"
+                                    { (yyval.expr) = new NewArrayExpr(Join((yylsp[-5]),(yylsp[0])),(yyvsp[-3].expr), (yyvsp[-1].type)); }
+#line 2333 "y.tab.c"
+    break;
+
+  case 94: /* Expr: T_This  */
+#line 324 "parser.y"
+                                    { (yyval.expr) = new This((yylsp[0])); }
+#line 2339 "y.tab.c"
+    break;
+
+  case 95: /* Constant: T_IntConstant  */
+#line 327 "parser.y"
+                                    { (yyval.expr) = new IntConstant((yylsp[0]),(yyvsp[0].integerConstant)); }
+#line 2345 "y.tab.c"
+    break;
+
+  case 96: /* Constant: T_BoolConstant  */
+#line 328 "parser.y"
+                                    { (yyval.expr) = new BoolConstant((yylsp[0]),(yyvsp[0].boolConstant)); }
+#line 2351 "y.tab.c"
+    break;
+
+  case 97: /* Constant: T_DoubleConstant  */
+#line 329 "parser.y"
+                                    { (yyval.expr) = new DoubleConstant((yylsp[0]),(yyvsp[0].doubleConstant)); }
+#line 2357 "y.tab.c"
+    break;
+
+  case 98: /* Constant: T_StringConstant  */
+#line 330 "parser.y"
+                                    { (yyval.expr) = new StringConstant((yylsp[0]),(yyvsp[0].stringConstant)); }
+#line 2363 "y.tab.c"
+    break;
+
+  case 99: /* Constant: T_Null  */
+#line 331 "parser.y"
+                                    { (yyval.expr) = new NullConstant((yylsp[0])); }
+#line 2369 "y.tab.c"
+    break;
+
+  case 100: /* Actuals: ExprList  */
+#line 334 "parser.y"
+                                    { (yyval.exprList) = (yyvsp[0].exprList); }
+#line 2375 "y.tab.c"
+    break;
+
+  case 101: /* Actuals: %empty  */
+#line 335 "parser.y"
+                                    { (yyval.exprList) = new List<Expr*>; }
+#line 2381 "y.tab.c"
+    break;
+
+  case 102: /* ExprList: ExprList ',' Expr  */
+#line 338 "parser.y"
+                                    { ((yyval.exprList)=(yyvsp[-2].exprList))->Append((yyvsp[0].expr)); }
+#line 2387 "y.tab.c"
+    break;
+
+  case 103: /* ExprList: Expr  */
+#line 339 "parser.y"
+                                    { ((yyval.exprList) = new List<Expr*>)->Append((yyvsp[0].expr)); }
+#line 2393 "y.tab.c"
+    break;
+
+  case 104: /* OptElse: T_Else Stmt  */
+#line 342 "parser.y"
+                                    { (yyval.stmt) = (yyvsp[0].stmt); }
+#line 2399 "y.tab.c"
+    break;
+
+  case 105: /* OptElse: %empty  */
+#line 344 "parser.y"
+                                    { (yyval.stmt) = NULL; }
+#line 2405 "y.tab.c"
+    break;
+
+
+#line 2409 "y.tab.c"
+
+      default: break;
+    }
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
+
+  YYPOPSTACK (yylen);
+  yylen = 0;
+
+  *++yyvsp = yyval;
+  *++yylsp = yyloc;
+
+  /* Now 'shift' the result of the reduction.  Determine what state
+     that goes to, based on the state we popped back to and the rule
+     number reduced by.  */
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
+
+  goto yynewstate;
+
+
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
+yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
+  /* If not already recovering from an error, report this error.  */
+  if (!yyerrstatus)
+    {
+      ++yynerrs;
+      yyerror (&yylloc, range, YY_("syntax error"));
+    }
+
+  yyerror_range[1] = yylloc;
+  if (yyerrstatus == 3)
+    {
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
+
+      if (yychar <= YYEOF)
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
+      else
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval, &yylloc, range);
+          yychar = YYEMPTY;
+        }
+    }
+
+  /* Else will try to reuse lookahead token after shifting the error
+     token.  */
+  goto yyerrlab1;
+
+
+/*---------------------------------------------------.
+| yyerrorlab -- error raised explicitly by YYERROR.  |
+`---------------------------------------------------*/
+yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
+
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYERROR.  */
+  YYPOPSTACK (yylen);
+  yylen = 0;
+  YY_STACK_PRINT (yyss, yyssp);
+  yystate = *yyssp;
+  goto yyerrlab1;
+
+
+/*-------------------------------------------------------------.
+| yyerrlab1 -- common code for both syntax error and YYERROR.  |
+`-------------------------------------------------------------*/
+yyerrlab1:
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
+
+  /* Pop stack until we find a state that shifts the error token.  */
+  for (;;)
+    {
+      yyn = yypact[yystate];
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
+
+      /* Pop the current state because it cannot handle the error token.  */
+      if (yyssp == yyss)
+        YYABORT;
+
+      yyerror_range[1] = *yylsp;
+      yydestruct ("Error: popping",
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, yylsp, range);
+      YYPOPSTACK (1);
+      yystate = *yyssp;
+      YY_STACK_PRINT (yyss, yyssp);
+    }
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+  yyerror_range[2] = yylloc;
+  ++yylsp;
+  YYLLOC_DEFAULT (*yylsp, yyerror_range, 2);
+
+  /* Shift the error token.  */
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
+
+  yystate = yyn;
+  goto yynewstate;
+
+
+/*-------------------------------------.
+| yyacceptlab -- YYACCEPT comes here.  |
+`-------------------------------------*/
+yyacceptlab:
+  yyresult = 0;
+  goto yyreturnlab;
+
+
+/*-----------------------------------.
+| yyabortlab -- YYABORT comes here.  |
+`-----------------------------------*/
+yyabortlab:
+  yyresult = 1;
+  goto yyreturnlab;
+
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
+yyexhaustedlab:
+  yyerror (&yylloc, range, YY_("memory exhausted"));
+  yyresult = 2;
+  goto yyreturnlab;
+
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval, &yylloc, range);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYABORT or YYACCEPT.  */
+  YYPOPSTACK (yylen);
+  YY_STACK_PRINT (yyss, yyssp);
+  while (yyssp != yyss)
+    {
+      yydestruct ("Cleanup: popping",
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, yylsp, range);
+      YYPOPSTACK (1);
+    }
+  yyps->yynew = 2;
+  goto yypushreturn;
+
+
+/*-------------------------.
+| yypushreturn -- return.  |
+`-------------------------*/
+yypushreturn:
+
+  return yyresult;
+}
+#undef yynerrs
+#undef yystate
+#undef yyerrstatus
+#undef yyssa
+#undef yyss
+#undef yyssp
+#undef yyvsa
+#undef yyvs
+#undef yyvsp
+#undef yylsa
+#undef yyls
+#undef yylsp
+#undef yystacksize
+#line 347 "parser.y"
+
+
+
+/* Function: InitParser
+ * --------------------
+ * This function will be called before any calls to yyparse().  It is designed
+ * to give you an opportunity to do anything that must be done to initialize
+ * the parser (set global variables, configure starting state, etc.). One
+ * thing it already does for you is assign the value of the global variable
+ * yydebug that controls whether yacc prints debugging information about
+ * parser actions (shift/reduce) and contents of state stack during parser.
+ * If set to false, no information is printed. Setting it to true will give
+ * you a running trail that might be helpful when debugging your parser.
+ * Please be sure the variable is set to false when submitting your final
+ * version.
+ */
+void InitParser()
+{
+   PrintDebug("parser", "Initializing parser");
+   yydebug = false;
+}
+
+
+/* Function: TokenName
+ * -------------------
+ * Returns the name the grammar gives a token code, such as "T_Identifier"
+ * or "'+'", for dcc -tokens.
+ */
+const char *TokenName(int token)
+{
+   return yytname[YYTRANSLATE(token)];
+}